@@ -19,8 +19,10 @@
 #define WORKRAVE_CONFIG_ICONFIGURATOR_HH
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace workrave
 {
@@ -62,6 +64,7 @@ namespace workrave
       virtual void set_delay(const std::string &key, int delay) = 0;
 
       virtual void heartbeat() = 0;
+      virtual int64_t get_next_heartbeat_time() const = 0;
       virtual bool load(std::string filename) = 0;
       virtual void save() = 0;
 
@@ -102,6 +105,40 @@ namespace workrave
       virtual bool add_listener(const std::string &key_prefix, workrave::config::IConfiguratorListener *listener) = 0;
       virtual bool remove_listener(workrave::config::IConfiguratorListener *listener) = 0;
       virtual bool remove_listener(const std::string &key_prefix, workrave::config::IConfiguratorListener *listener) = 0;
+
+      //! Buffers all changes until the matching commit(). Transactions nest.
+      virtual void begin_transaction() = 0;
+
+      //! Applies the buffered changes and notifies each affected listener prefix once.
+      virtual void commit() = 0;
+
+      //! Sets several values in one transaction.
+      virtual void set_values(const std::map<std::string, int32_t> &ints,
+                              const std::map<std::string, bool> &bools,
+                              const std::map<std::string, double> &doubles,
+                              const std::map<std::string, std::string> &strings) = 0;
+    };
+
+    //! Scoped IConfigurator transaction.
+    class ConfigTransaction
+    {
+    public:
+      explicit ConfigTransaction(IConfigurator::Ptr config)
+        : config(std::move(config))
+      {
+        this->config->begin_transaction();
+      }
+
+      ~ConfigTransaction()
+      {
+        config->commit();
+      }
+
+      ConfigTransaction(const ConfigTransaction &) = delete;
+      ConfigTransaction &operator=(const ConfigTransaction &) = delete;
+
+    private:
+      IConfigurator::Ptr config;
     };
   } // namespace config
 } // namespace workrave
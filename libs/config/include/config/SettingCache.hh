@@ -18,9 +18,14 @@
 #ifndef WORKRAVE_CONFIG_SETTINGCACHE_HH
 #define WORKRAVE_CONFIG_SETTINGCACHE_HH
 
-#include <map>
-#include <utility>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <boost/noncopyable.hpp>
 
 #include "config/IConfigurator.hh"
@@ -30,48 +35,139 @@ namespace workrave
 {
   namespace config
   {
+    //! Interned setting key.
+    using SettingId = uint32_t;
+
+    //! Cache of settings, shared by all users of a setting.
+    /*!
+     *  Keys are interned into dense integer ids once. Settings can be looked
+     *  up by id, which is a single indexed load, or by key, which costs an
+     *  additional hash lookup.
+     */
     class SettingCache : public boost::noncopyable
     {
     private:
-      static auto &get_cache()
+      static auto &get_ids()
       {
-        static std::map<std::string, std::shared_ptr<SettingBase>> cache;
-        return cache;
+        static std::unordered_map<std::string, SettingId> ids;
+        return ids;
+      }
+
+      static auto &get_keys()
+      {
+        static std::vector<std::string> keys;
+        return keys;
+      }
+
+      //! Settings by id. Constant-initialized, so lookups need no guard.
+      static constinit inline std::vector<std::unique_ptr<SettingBase>> settings;
+
+      template<typename S>
+      static S &lookup(SettingId id)
+      {
+        assert(id < settings.size() && settings[id] != nullptr);
+        assert(dynamic_cast<S *>(settings[id].get()) != nullptr);
+        return static_cast<S &>(*settings[id]);
       }
 
     public:
+      //! Returns the id of the key. Ids remain valid after reset().
+      static SettingId intern(const std::string &key)
+      {
+        auto [it, inserted] = get_ids().try_emplace(key, static_cast<SettingId>(get_keys().size()));
+        if (inserted)
+          {
+            get_keys().push_back(key);
+          }
+        return it->second;
+      }
+
       template<typename T, typename S = T>
-      static workrave::config::Setting<T, S> &get(IConfigurator::Ptr config, const std::string &key, const S &def = S())
+      static workrave::config::Setting<T, S> &get(const IConfigurator::Ptr &config, SettingId id, const S &def = S())
       {
-        auto &cache = get_cache();
-        if (cache.find(key) == cache.end())
+        if (id >= settings.size() || settings[id] == nullptr)
           {
-            cache[key] = std::make_shared<workrave::config::Setting<T, S>>(config, key, def);
+            settings.resize(std::max(settings.size(), get_keys().size()));
+            settings[id] = std::make_unique<workrave::config::Setting<T, S>>(config, get_keys()[id], def);
           }
+        return lookup<workrave::config::Setting<T, S>>(id);
+      }
 
-        auto ret = std::dynamic_pointer_cast<workrave::config::Setting<T, S>>(cache[key]);
-        assert(ret.get() != nullptr);
-        return *ret;
+      template<typename T, typename S = T>
+      static workrave::config::Setting<T, S> &get(IConfigurator::Ptr config, const std::string &key, const S &def = S())
+      {
+        return get<T, S>(config, intern(key), def);
       }
 
-      static workrave::config::SettingGroup &group(IConfigurator::Ptr config, const std::string &key)
+      static workrave::config::SettingGroup &group(const IConfigurator::Ptr &config, SettingId id)
       {
-        auto &cache = get_cache();
-        if (cache.find(key) == cache.end())
+        if (id >= settings.size() || settings[id] == nullptr)
           {
-            cache[key] = std::make_shared<workrave::config::SettingGroup>(config, key);
+            settings.resize(std::max(settings.size(), get_keys().size()));
+            settings[id] = std::make_unique<workrave::config::SettingGroup>(config, get_keys()[id]);
           }
+        return lookup<workrave::config::SettingGroup>(id);
+      }
 
-        auto ret = std::dynamic_pointer_cast<workrave::config::SettingGroup>(cache[key]);
-        assert(ret.get() != nullptr);
-        return *ret;
+      static workrave::config::SettingGroup &group(IConfigurator::Ptr config, const std::string &key)
+      {
+        return group(config, intern(key));
       }
 
       static void reset()
       {
-        get_cache().clear();
+        settings.clear();
       }
     };
+
+    //! Statically typed handle of a setting.
+    /*!
+     *  The key is interned when the handle is created, so that each access
+     *  is a single indexed load. Handles are meant to be created once, for
+     *  example as function-local statics of configuration accessors.
+     */
+    template<typename T, typename S = T>
+    class SettingHandle
+    {
+    public:
+      explicit SettingHandle(const std::string &key, S def = S())
+        : id(SettingCache::intern(key))
+        , def(std::move(def))
+      {
+      }
+
+      workrave::config::Setting<T, S> &operator()(const IConfigurator::Ptr &config) const
+      {
+        return SettingCache::get<T, S>(config, id, def);
+      }
+
+      SettingId get_id() const
+      {
+        return id;
+      }
+
+    private:
+      SettingId id;
+      S def;
+    };
+
+    //! Handle of a setting group, see SettingHandle.
+    class SettingGroupHandle
+    {
+    public:
+      explicit SettingGroupHandle(const std::string &key)
+        : id(SettingCache::intern(key))
+      {
+      }
+
+      workrave::config::SettingGroup &operator()(const IConfigurator::Ptr &config) const
+      {
+        return SettingCache::group(config, id);
+      }
+
+    private:
+      SettingId id;
+    };
   } // namespace config
 } // namespace workrave
 
@@ -0,0 +1,190 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ConfigWriter.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+#if defined(PLATFORM_OS_WINDOWS)
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+#include "utils/Diagnostics.hh"
+
+ConfigWriter::ConfigWriter()
+  : thread([this]() { run(); })
+{
+  Diagnostics::instance().register_topic("config.writer", [this]() {
+    std::scoped_lock lock(mutex);
+    Diagnostics::instance().report("config.writer.writes", writes);
+    Diagnostics::instance().report("config.writer.failures", failures);
+    Diagnostics::instance().report("config.writer.coalesced", coalesced);
+    Diagnostics::instance().report("config.writer.latency_us", last_latency_us);
+    Diagnostics::instance().report("config.writer.max_latency_us", max_latency_us);
+  });
+}
+
+ConfigWriter::~ConfigWriter()
+{
+  Diagnostics::instance().unregister_topic("config.writer");
+
+  {
+    std::scoped_lock lock(mutex);
+    quit = true;
+  }
+  queued.notify_all();
+  thread.join();
+}
+
+void
+ConfigWriter::write(const std::string &filename, std::string contents)
+{
+  {
+    std::scoped_lock lock(mutex);
+    auto [it, inserted] = pending.insert_or_assign(filename, std::move(contents));
+    if (!inserted)
+      {
+        coalesced++;
+      }
+  }
+  queued.notify_all();
+}
+
+void
+ConfigWriter::flush()
+{
+  std::unique_lock lock(mutex);
+  idle.wait(lock, [this]() { return pending.empty() && !busy; });
+}
+
+bool
+ConfigWriter::take_failure(const std::string &filename)
+{
+  std::scoped_lock lock(mutex);
+  return failed.erase(filename) > 0;
+}
+
+void
+ConfigWriter::run()
+{
+  std::unique_lock lock(mutex);
+  while (true)
+    {
+      queued.wait(lock, [this]() { return quit || !pending.empty(); });
+      if (pending.empty())
+        {
+          // Only when quitting, after all pending files are written.
+          break;
+        }
+
+      auto node = pending.extract(pending.begin());
+      busy = true;
+      lock.unlock();
+
+      auto start = std::chrono::steady_clock::now();
+      bool ok = write_file(node.key(), node.mapped());
+      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+      if (!ok)
+        {
+          logger->error("failed to save {}", node.key());
+        }
+
+      lock.lock();
+      if (ok)
+        {
+          failed.erase(node.key());
+        }
+      else
+        {
+          failed.insert(node.key());
+        }
+      busy = false;
+      writes++;
+      failures += ok ? 0 : 1;
+      last_latency_us = latency;
+      max_latency_us = std::max(max_latency_us, static_cast<int64_t>(latency));
+      if (pending.empty())
+        {
+          idle.notify_all();
+        }
+    }
+
+  idle.notify_all();
+}
+
+bool
+ConfigWriter::write_file(const std::string &filename, const std::string &contents)
+{
+  std::string tmp_filename = filename + ".tmp";
+
+  std::FILE *file = std::fopen(tmp_filename.c_str(), "wb");
+  if (file == nullptr)
+    {
+      return false;
+    }
+
+  // Before writing, so that the contents of a private file are never readable by others.
+  std::error_code ec;
+  std::filesystem::file_status status = std::filesystem::status(filename, ec);
+  if (!ec && std::filesystem::exists(status))
+    {
+      std::filesystem::permissions(tmp_filename, status.permissions(), ec);
+    }
+
+  bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+  ok = ok && std::fflush(file) == 0;
+#if defined(PLATFORM_OS_WINDOWS)
+  ok = ok && _commit(_fileno(file)) == 0;
+#else
+  ok = ok && fsync(fileno(file)) == 0;
+#endif
+  ok = (std::fclose(file) == 0) && ok;
+
+  if (ok)
+    {
+      std::filesystem::rename(tmp_filename, filename, ec);
+    }
+  if (!ok || ec)
+    {
+      std::filesystem::remove(tmp_filename, ec);
+      return false;
+    }
+
+#if !defined(PLATFORM_OS_WINDOWS)
+  // Make the rename itself durable.
+  std::string dir = std::filesystem::path(filename).parent_path().string();
+  int fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+  if (fd >= 0)
+    {
+      fsync(fd);
+      close(fd);
+    }
+#endif
+
+  return true;
+}
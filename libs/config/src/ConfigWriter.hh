@@ -0,0 +1,83 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef CONFIGWRITER_HH
+#define CONFIGWRITER_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "utils/Logging.hh"
+
+//! Writes configuration files on a background thread.
+/*!
+ *  Snapshots of a file that are queued while an earlier snapshot of it is
+ *  still waiting are coalesced: only the latest one is written.
+ */
+class ConfigWriter
+{
+public:
+  ConfigWriter();
+  ~ConfigWriter();
+
+  ConfigWriter(const ConfigWriter &) = delete;
+  ConfigWriter &operator=(const ConfigWriter &) = delete;
+
+  //! Queues the contents of a file.
+  void write(const std::string &filename, std::string contents);
+
+  //! Waits until all queued files are written.
+  void flush();
+
+  //! Returns whether the last write of the file failed, and forgets the failure.
+  bool take_failure(const std::string &filename);
+
+  //! Writes a file via a temporary file that is synced and renamed over it.
+  /*!
+   *  The temporary file gets the permissions of the file it replaces.
+   */
+  static bool write_file(const std::string &filename, const std::string &contents);
+
+private:
+  void run();
+
+private:
+  std::mutex mutex;
+  std::condition_variable queued;
+  std::condition_variable idle;
+  std::map<std::string, std::string> pending;
+  std::set<std::string> failed;
+  bool busy{false};
+  bool quit{false};
+
+  uint64_t writes{0};
+  uint64_t failures{0};
+  uint64_t coalesced{0};
+  int64_t last_latency_us{0};
+  int64_t max_latency_us{0};
+
+  std::shared_ptr<spdlog::logger> logger{workrave::utils::Logging::create("config:writer")};
+  std::thread thread;
+};
+
+#endif // CONFIGWRITER_HH
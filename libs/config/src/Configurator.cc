@@ -32,6 +32,7 @@
 #include "IConfigBackend.hh"
 
 #include "utils/TimeSource.hh"
+#include "utils/Diagnostics.hh"
 #include "debug.hh"
 
 using namespace workrave::utils;
@@ -43,30 +44,90 @@ Configurator::Configurator(IConfigBackend *backend)
     {
       dynamic_cast<IConfigBackendMonitoring *>(backend)->set_listener(this);
     }
+
+  Diagnostics::instance().register_topic("config.cache", [this]() {
+    Diagnostics::instance().report("config.cache.hits", cache_hits);
+    Diagnostics::instance().report("config.cache.misses", cache_misses);
+  });
 }
 
 Configurator::~Configurator()
 {
+  Diagnostics::instance().unregister_topic("config.cache");
+  writer.reset();
   delete backend;
 }
 
 bool
 Configurator::load(std::string filename)
 {
+  if (writer)
+    {
+      writer->flush();
+    }
+
+  cache.clear();
   return backend->load(filename);
 }
 
 void
 Configurator::save()
 {
+  if (writer)
+    {
+      writer->flush();
+      retry_failed_save();
+    }
   backend->save();
 }
 
+//! Saves without blocking on file I/O, if the backend stores its configuration in a file.
+void
+Configurator::save_in_background()
+{
+  auto *file_backend = dynamic_cast<IConfigBackendFile *>(backend);
+  if (file_backend == nullptr)
+    {
+      save();
+      return;
+    }
+
+  retry_failed_save();
+  std::optional<std::string> contents = file_backend->snapshot();
+  if (contents.has_value())
+    {
+      if (!writer)
+        {
+          writer = std::make_unique<ConfigWriter>();
+        }
+      writer->write(file_backend->get_filename(), std::move(contents.value()));
+    }
+}
+
+//! Marks the file as out of date if its last background write failed, returns whether it did.
+bool
+Configurator::retry_failed_save()
+{
+  auto *file_backend = dynamic_cast<IConfigBackendFile *>(backend);
+  if (!writer || file_backend == nullptr || !writer->take_failure(file_backend->get_filename()))
+    {
+      return false;
+    }
+
+  file_backend->mark_dirty();
+  return true;
+}
+
 void
 Configurator::heartbeat()
 {
   int64_t now = TimeSource::get_monotonic_time_sec();
 
+  if (retry_failed_save())
+    {
+      schedule_save();
+    }
+
   auto it = delayed_config.begin();
   while (it != delayed_config.end())
     {
@@ -78,16 +139,14 @@ Configurator::heartbeat()
         {
           std::optional<ConfigValue> old_value = backend->get_value(delayed.key, ConfigValueToType(delayed.value));
           backend->set_value(delayed.key, delayed.value);
+          invalidate_value(delayed.key);
 
           if (dynamic_cast<IConfigBackendMonitoring *>(backend) == nullptr)
             {
               if (!old_value.has_value() || old_value != delayed.value)
                 {
                   fire_configurator_event(delayed.key);
-                  if (auto_save_time == 0)
-                    {
-                      auto_save_time = TimeSource::get_monotonic_time_sec() + 30;
-                    }
+                  schedule_save();
                 }
             }
 
@@ -99,11 +158,27 @@ Configurator::heartbeat()
 
   if (auto_save_time != 0 && now >= auto_save_time)
     {
-      save();
+      save_in_background();
       auto_save_time = 0;
     }
 }
 
+int64_t
+Configurator::get_next_heartbeat_time() const
+{
+  int64_t next = auto_save_time;
+
+  for (const auto &[key, delayed]: delayed_config)
+    {
+      if (next == 0 || delayed.until < next)
+        {
+          next = delayed.until;
+        }
+    }
+
+  return next;
+}
+
 void
 Configurator::set_delay(const std::string &key, int delay)
 {
@@ -119,7 +194,10 @@ Configurator::has_user_value(const std::string &key)
 void
 Configurator::remove_key(const std::string &key) const
 {
-  backend->remove_key(trim_key(key));
+  std::string ckey = trim_key(key);
+  transaction.erase(ckey);
+  backend->remove_key(ckey);
+  invalidate_value(ckey);
 }
 
 void
@@ -144,10 +222,33 @@ Configurator::rename_key(const std::string &key, const std::string &new_key)
 bool
 Configurator::set_value(const std::string &key, ConfigValue &value, workrave::config::ConfigFlags flags)
 {
-  bool skip = false;
-
   std::string ckey = trim_key(key);
 
+  if (transaction_depth > 0)
+    {
+      transaction.insert_or_assign(ckey, PendingValue{value, flags});
+      return false;
+    }
+
+  bool changed = false;
+  bool skip = apply_value(ckey, value, flags, changed);
+
+  // Monitoring backends report their own changes.
+  if (changed && dynamic_cast<IConfigBackendMonitoring *>(backend) == nullptr)
+    {
+      fire_configurator_event(ckey);
+      schedule_save();
+    }
+
+  return skip;
+}
+
+//! Writes a value to the backend, unless it is delayed or an initial value is not needed.
+bool
+Configurator::apply_value(const std::string &ckey, ConfigValue &value, workrave::config::ConfigFlags flags, bool &changed)
+{
+  bool skip = false;
+
   if ((flags & workrave::config::CONFIG_FLAG_INITIAL) != 0)
     {
       auto current_value = get_value(ckey, ConfigValueToType(value));
@@ -172,136 +273,204 @@ Configurator::set_value(const std::string &key, ConfigValue &value, workrave::co
       auto current_value = get_value(ckey, ConfigValueToType(value));
       bool valid = current_value.has_value();
       backend->set_value(ckey, value);
-
-      if (dynamic_cast<IConfigBackendMonitoring *>(backend) == nullptr)
-        {
-          if (!valid || current_value != value)
-            {
-              fire_configurator_event(ckey);
-
-              if (auto_save_time == 0)
-                {
-                  auto_save_time = TimeSource::get_monotonic_time_sec() + 30;
-                }
-            }
-        }
+      invalidate_value(ckey);
+      changed = !valid || current_value != value;
     }
 
   return skip;
 }
 
-std::optional<ConfigValue>
-Configurator::get_value(const std::string &key, ConfigType type) const
+void
+Configurator::schedule_save()
 {
-  std::optional<ConfigValue> ret;
-
-  std::string ckey = trim_key(key);
-
-  auto it = delayed_config.find(ckey);
-  if (it != delayed_config.end())
+  if (auto_save_time == 0)
     {
-      const DelayedConfig &delayed = it->second;
-      ret = delayed.value;
+      auto_save_time = TimeSource::get_monotonic_time_sec() + 30;
     }
+}
 
-  if (!ret.has_value())
+void
+Configurator::begin_transaction()
+{
+  transaction_depth++;
+}
+
+void
+Configurator::commit()
+{
+  if (transaction_depth == 0 || --transaction_depth > 0)
     {
-      ret = backend->get_value(ckey, type);
+      return;
     }
 
-  return ret;
-}
+  auto values = std::move(transaction);
+  transaction.clear();
 
-bool
-Configurator::get_value(const std::string &key, std::string &out) const
-{
-  auto v = get_value(key, ConfigType::String);
+  // The changes are notified below, so monitoring backends store them together and their reports are ignored.
+  auto *monitoring = dynamic_cast<IConfigBackendMonitoring *>(backend);
+  if (monitoring != nullptr)
+    {
+      monitoring->delay_changes();
+    }
 
-  try
+  std::vector<std::string> changed_keys;
+  for (auto &[key, pending]: values)
     {
-      if (v.has_value())
+      bool changed = false;
+      apply_value(key, pending.value, pending.flags, changed);
+      if (changed)
         {
-          std::visit([&out](auto &&arg) { out = boost::lexical_cast<std::string>(arg); }, v.value());
-          return true;
+          if (monitoring != nullptr)
+            {
+              committed_values.insert_or_assign(key, pending.value);
+            }
+          changed_keys.push_back(key);
         }
     }
-  catch (boost::bad_lexical_cast &)
+
+  if (monitoring != nullptr)
     {
+      monitoring->apply_changes();
     }
 
-  return false;
-}
+  if (changed_keys.empty())
+    {
+      return;
+    }
 
-bool
-Configurator::get_value(const std::string &key, bool &out) const
-{
-  auto v = get_value(key, ConfigType::Bool);
+  schedule_save();
 
-  try
+  // Notify each listener once per prefix, with the first changed key under that prefix.
+  std::map<uint64_t, std::pair<IConfiguratorListener *, const std::string *>> notifications;
+  for (const auto &key: changed_keys)
     {
-      if (v.has_value())
+      for (const auto &[sequence, listener]: listeners.find_registrations(key))
         {
-          std::visit([&out](auto &&arg) { out = boost::lexical_cast<bool>(arg); }, v.value());
-          return true;
+          notifications.try_emplace(sequence, listener, &key);
         }
     }
-  catch (boost::bad_lexical_cast &)
+
+  for (const auto &[sequence, notification]: notifications)
     {
+      if (notification.first != nullptr)
+        {
+          notification.first->config_changed_notify(*notification.second);
+        }
     }
-
-  return false;
 }
 
-bool
-Configurator::get_value(const std::string &key, int32_t &out) const
+void
+Configurator::set_values(const std::map<std::string, int32_t> &ints,
+                         const std::map<std::string, bool> &bools,
+                         const std::map<std::string, double> &doubles,
+                         const std::map<std::string, std::string> &strings)
 {
-  auto v = get_value(key, ConfigType::Int32);
-
-  try
+  begin_transaction();
+  for (const auto &[key, value]: ints)
     {
-      if (v.has_value())
-        {
-          std::visit([&out](auto &&arg) { out = boost::lexical_cast<int32_t>(arg); }, v.value());
-          return true;
-        }
+      set_value(key, value);
     }
-  catch (boost::bad_lexical_cast &)
+  for (const auto &[key, value]: bools)
+    {
+      set_value(key, value);
+    }
+  for (const auto &[key, value]: doubles)
+    {
+      set_value(key, value);
+    }
+  for (const auto &[key, value]: strings)
     {
+      set_value(key, value);
     }
+  commit();
+}
 
-  return false;
+std::optional<ConfigValue>
+Configurator::get_value(const std::string &key, ConfigType type) const
+{
+  std::optional<ConfigValue> ret;
+
+  const ConfigValue *value = lookup_value(trim_key_view(key), type);
+  if (value != nullptr)
+    {
+      ret = *value;
+    }
+
+  return ret;
 }
 
-bool
-Configurator::get_value(const std::string &key, int64_t &out) const
+//! Returns the delayed or backend value of a trimmed key, or nullptr if there is none.
+const ConfigValue *
+Configurator::lookup_value(std::string_view key, ConfigType type) const
 {
-  auto v = get_value(key, ConfigType::Int64);
+  auto pending = transaction.find(key);
+  if (pending != transaction.end() && (pending->second.flags & workrave::config::CONFIG_FLAG_INITIAL) == 0)
+    {
+      return &pending->second.value;
+    }
 
-  try
+  auto it = delayed_config.find(key);
+  if (it != delayed_config.end())
     {
-      if (v.has_value())
-        {
-          std::visit([&out](auto &&arg) { out = boost::lexical_cast<int64_t>(arg); }, v.value());
-          return true;
-        }
+      return &it->second.value;
     }
-  catch (boost::bad_lexical_cast &)
+
+  auto c = cache.find(key);
+  if (c == cache.end())
     {
+      c = cache.emplace(std::string(key), CachedValue{}).first;
     }
 
-  return false;
+  CachedValue &cached = c->second;
+  auto index = static_cast<std::size_t>(type);
+  auto mask = static_cast<uint8_t>(1U << index);
+  if ((cached.valid & mask) != 0)
+    {
+      cache_hits++;
+    }
+  else
+    {
+      cache_misses++;
+      cached.values[index] = backend->get_value(c->first, type);
+      cached.valid |= mask;
+    }
+
+  const auto &value = cached.values[index];
+  return value.has_value() ? &value.value() : nullptr;
+}
+
+void
+Configurator::invalidate_value(std::string_view key) const
+{
+  auto it = cache.find(key);
+  if (it != cache.end())
+    {
+      cache.erase(it);
+    }
 }
 
+template<typename T>
 bool
-Configurator::get_value(const std::string &key, double &out) const
+Configurator::get_typed_value(const std::string &key, ConfigType type, T &out) const
 {
-  auto v = get_value(key, ConfigType::Double);
+  const ConfigValue *value = lookup_value(trim_key_view(key), type);
 
   try
     {
-      if (v.has_value())
+      if (value != nullptr)
         {
-          std::visit([&out](auto &&arg) { out = boost::lexical_cast<double>(arg); }, v.value());
+          std::visit(
+            [&out](auto &&arg) {
+              if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, T>)
+                {
+                  out = arg;
+                }
+              else
+                {
+                  out = boost::lexical_cast<T>(arg);
+                }
+            },
+            *value);
           return true;
         }
     }
@@ -312,6 +481,36 @@ Configurator::get_value(const std::string &key, double &out) const
   return false;
 }
 
+bool
+Configurator::get_value(const std::string &key, std::string &out) const
+{
+  return get_typed_value(key, ConfigType::String, out);
+}
+
+bool
+Configurator::get_value(const std::string &key, bool &out) const
+{
+  return get_typed_value(key, ConfigType::Bool, out);
+}
+
+bool
+Configurator::get_value(const std::string &key, int32_t &out) const
+{
+  return get_typed_value(key, ConfigType::Int32, out);
+}
+
+bool
+Configurator::get_value(const std::string &key, int64_t &out) const
+{
+  return get_typed_value(key, ConfigType::Int64, out);
+}
+
+bool
+Configurator::get_value(const std::string &key, double &out) const
+{
+  return get_typed_value(key, ConfigType::Double, out);
+}
+
 void
 Configurator::set_value(const std::string &key, const std::string &v, workrave::config::ConfigFlags flags)
 {
@@ -408,7 +607,6 @@ bool
 Configurator::add_listener(const std::string &key_prefix, IConfiguratorListener *listener)
 {
   bool ret = true;
-  std::string key = trim_key(key_prefix);
 
   if (dynamic_cast<IConfigBackendMonitoring *>(backend) != nullptr)
     {
@@ -417,23 +615,7 @@ Configurator::add_listener(const std::string &key_prefix, IConfiguratorListener
 
   if (ret)
     {
-      auto i = listeners.begin();
-      while (ret && i != listeners.end())
-        {
-          if (key == i->first && listener == i->second)
-            {
-              // Already added. Skip
-              ret = false;
-            }
-
-          i++;
-        }
-    }
-
-  if (ret)
-    {
-      // not found -> add
-      listeners.emplace_back(key, listener);
+      ret = listeners.add(trim_key(key_prefix), listener);
     }
 
   return ret;
@@ -443,51 +625,20 @@ bool
 Configurator::remove_listener(IConfiguratorListener *listener)
 {
   TRACE_ENTRY();
-  bool ret = false;
-
-  auto i = listeners.begin();
-  while (i != listeners.end())
-    {
-      if (listener == i->second)
-        {
-          // Found. Remove
-          i = listeners.erase(i);
-          ret = true;
-        }
-      else
-        {
-          i++;
-        }
-    }
-  return ret;
+  return listeners.remove(listener);
 }
 
 bool
 Configurator::remove_listener(const std::string &key_prefix, IConfiguratorListener *listener)
 {
   TRACE_ENTRY();
-  bool ret = false;
 
   if (dynamic_cast<IConfigBackendMonitoring *>(backend) != nullptr)
     {
       dynamic_cast<IConfigBackendMonitoring *>(backend)->remove_listener(key_prefix);
     }
 
-  auto i = listeners.begin();
-  while (i != listeners.end())
-    {
-      if (i->first == key_prefix && i->second == listener)
-        {
-          // Found. Remove
-          i = listeners.erase(i);
-          ret = true;
-        }
-      else
-        {
-          i++;
-        }
-    }
-  return ret;
+  return listeners.remove(trim_key(key_prefix), listener);
 }
 
 //! Fire a configuration changed event.
@@ -498,22 +649,13 @@ Configurator::fire_configurator_event(const std::string &key)
 
   std::string ckey = trim_key(key);
 
-  auto listeners_copy = listeners;
-
-  auto i = listeners_copy.begin();
-  while (i != listeners_copy.end())
+  // Listeners may add or remove listeners while being notified.
+  for (IConfiguratorListener *l: listeners.find(ckey))
     {
-      std::string prefix = i->first;
-
-      if (ckey.substr(0, prefix.length()) == prefix)
+      if (l != nullptr)
         {
-          IConfiguratorListener *l = i->second;
-          if (l != nullptr)
-            {
-              l->config_changed_notify(ckey);
-            }
+          l->config_changed_notify(ckey);
         }
-      i++;
     }
 }
 
@@ -523,8 +665,36 @@ Configurator::trim_key(const std::string &key)
   return boost::trim_copy_if(key, boost::is_any_of("/"));
 }
 
+std::string_view
+Configurator::trim_key_view(std::string_view key)
+{
+  std::size_t start = key.find_first_not_of('/');
+  if (start == std::string_view::npos)
+    {
+      return {};
+    }
+  std::size_t end = key.find_last_not_of('/');
+  return key.substr(start, end - start + 1);
+}
+
 void
 Configurator::config_changed_notify(const std::string &key)
 {
+  std::string_view ckey = trim_key_view(key);
+  invalidate_value(ckey);
+
+  auto committed = committed_values.find(ckey);
+  if (committed != committed_values.end())
+    {
+      std::optional<ConfigValue> value = backend->get_value(committed->first, ConfigValueToType(committed->second));
+      bool echo = value == committed->second;
+      committed_values.erase(committed);
+      if (echo)
+        {
+          // Echo of a change that commit() notified already.
+          return;
+        }
+    }
+
   fire_configurator_event(key);
 }
@@ -20,13 +20,20 @@
 #ifndef CONFIGURATOR_HH
 #define CONFIGURATOR_HH
 
-#include <string>
-#include <list>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "config/IConfigurator.hh"
 #include "config/IConfiguratorListener.hh"
+#include "ConfigWriter.hh"
 #include "IConfigBackend.hh"
+#include "ListenerTrie.hh"
 
 #include "utils/Logging.hh"
 
@@ -39,6 +46,7 @@ public:
   ~Configurator() override;
 
   void heartbeat() override;
+  int64_t get_next_heartbeat_time() const override;
 
   void set_delay(const std::string &key, int delay) override;
 
@@ -75,6 +83,13 @@ public:
   bool remove_listener(workrave::config::IConfiguratorListener *listener) override;
   bool remove_listener(const std::string &key_prefix, workrave::config::IConfiguratorListener *listener) override;
 
+  void begin_transaction() override;
+  void commit() override;
+  void set_values(const std::map<std::string, int32_t> &ints,
+                  const std::map<std::string, bool> &bools,
+                  const std::map<std::string, double> &doubles,
+                  const std::map<std::string, std::string> &strings) override;
+
 private:
   struct DelayedConfig
   {
@@ -83,21 +98,68 @@ private:
     int64_t until;
   };
 
+  struct PendingValue
+  {
+    ConfigValue value;
+    workrave::config::ConfigFlags flags;
+  };
+
+  //! Backend values of a key, per requested type.
+  struct CachedValue
+  {
+    std::array<std::optional<ConfigValue>, 6> values;
+    uint8_t valid{0};
+  };
+
+  struct KeyHash
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view key) const
+    {
+      return std::hash<std::string_view>{}(key);
+    }
+  };
+
 private:
   bool set_value(const std::string &key, ConfigValue &value, workrave::config::ConfigFlags flags = workrave::config::CONFIG_FLAG_NONE);
+  bool apply_value(const std::string &ckey, ConfigValue &value, workrave::config::ConfigFlags flags, bool &changed);
+  void schedule_save();
   std::optional<ConfigValue> get_value(const std::string &key, ConfigType type) const;
+  const ConfigValue *lookup_value(std::string_view key, ConfigType type) const;
+  void invalidate_value(std::string_view key) const;
+
+  template<typename T>
+  bool get_typed_value(const std::string &key, ConfigType type, T &out) const;
+
+  void save_in_background();
+  bool retry_failed_save();
 
   static std::string trim_key(const std::string &key);
+  static std::string_view trim_key_view(std::string_view key);
 
   void fire_configurator_event(const std::string &key);
   void config_changed_notify(const std::string &key) override;
 
 private:
   std::map<std::string, int> delays;
-  std::map<std::string, DelayedConfig> delayed_config;
-  std::list<std::pair<std::string, workrave::config::IConfiguratorListener *>> listeners;
+  std::map<std::string, DelayedConfig, std::less<>> delayed_config;
+  ListenerTrie listeners;
+
+  //! Changes buffered by an open transaction, by trimmed key.
+  mutable std::map<std::string, PendingValue, std::less<>> transaction;
+  int transaction_depth{0};
+
+  //! Values notified by commit(), by trimmed key. The first report of a monitoring backend for each is not notified again.
+  std::map<std::string, ConfigValue, std::less<>> committed_values;
+
+  //! Read-through cache of backend values, by trimmed key.
+  mutable std::unordered_map<std::string, CachedValue, KeyHash, std::equal_to<>> cache;
+  mutable uint64_t cache_hits{0};
+  mutable uint64_t cache_misses{0};
+
   IConfigBackend *backend{nullptr};
   int64_t auto_save_time{0};
+  std::unique_ptr<ConfigWriter> writer;
   std::string last_filename;
   std::shared_ptr<spdlog::logger> logger{workrave::utils::Logging::create("config")};
 };
@@ -25,7 +25,7 @@
 #include "ConfiguratorFactory.hh"
 #include "Configurator.hh"
 
-#include "IniConfigurator.hh"
+#include "FlatIniConfigurator.hh"
 #include "XmlConfigurator.hh"
 #if defined(HAVE_GSETTINGS)
 #  include "GSettingsConfigurator.hh"
@@ -69,7 +69,7 @@ ConfiguratorFactory::create(ConfigFileFormat fmt)
 
   if (fmt == ConfigFileFormat::Ini)
     {
-      b = new IniConfigurator();
+      b = new FlatIniConfigurator();
     }
 
   if (b != nullptr)
@@ -0,0 +1,387 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "FlatIniConfigurator.hh"
+
+#include "ConfigWriter.hh"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+namespace
+{
+  std::string_view trim(std::string_view s)
+  {
+    std::size_t start = s.find_first_not_of(" \t");
+    if (start == std::string_view::npos)
+      {
+        return {};
+      }
+    std::size_t end = s.find_last_not_of(" \t");
+    return s.substr(start, end - start + 1);
+  }
+
+  template<typename T>
+  std::optional<ConfigValue> parse_integer(std::string_view s)
+  {
+    if (!s.empty() && s.front() == '+')
+      {
+        s.remove_prefix(1);
+      }
+
+    T value{};
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc() || ptr != s.data() + s.size() || s.empty())
+      {
+        return {};
+      }
+    return value;
+  }
+
+  std::optional<ConfigValue> parse_double(const std::string &s)
+  {
+    std::istringstream iss(s);
+    iss.imbue(std::locale::classic());
+
+    double value{};
+    iss >> value;
+    if (iss.fail() || iss.get() != std::char_traits<char>::eof())
+      {
+        return {};
+      }
+    return value;
+  }
+
+  std::optional<ConfigValue> parse_bool(std::string_view s)
+  {
+    if (s == "1" || s == "true")
+      {
+        return true;
+      }
+    if (s == "0" || s == "false")
+      {
+        return false;
+      }
+    return {};
+  }
+} // namespace
+
+bool
+FlatIniConfigurator::load(std::string filename)
+{
+  last_filename = filename;
+
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    {
+      logger->error("failed to load {}", filename);
+      return false;
+    }
+
+  std::ostringstream contents;
+  contents << file.rdbuf();
+
+  if (!parse(contents.str()))
+    {
+      return false;
+    }
+
+  dirty = false;
+  return !entries.empty();
+}
+
+bool
+FlatIniConfigurator::parse(const std::string &contents)
+{
+  std::vector<Section> new_sections(1);
+  std::unordered_map<std::string, uint32_t> new_section_index;
+  std::unordered_map<std::string, Entry> new_entries;
+
+  std::size_t line_no = 0;
+  std::size_t pos = 0;
+  while (pos < contents.size())
+    {
+      std::size_t eol = contents.find('\n', pos);
+      if (eol == std::string::npos)
+        {
+          eol = contents.size();
+        }
+      std::string_view raw(contents.data() + pos, eol - pos);
+      if (!raw.empty() && raw.back() == '\r')
+        {
+          raw.remove_suffix(1);
+        }
+      pos = eol + 1;
+      line_no++;
+
+      std::string_view line = trim(raw);
+      Section &section = new_sections.back();
+
+      if (line.empty() || line.front() == ';' || line.front() == '#')
+        {
+          section.lines.push_back(Line{std::string(raw)});
+        }
+      else if (line.front() == '[')
+        {
+          std::size_t end = line.find(']');
+          std::string name(trim(line.substr(1, end - 1)));
+          if (end == std::string_view::npos || new_section_index.contains(name))
+            {
+              logger->error("failed to load {}: bad section at line {}", last_filename, line_no);
+              return false;
+            }
+          new_section_index.emplace(name, static_cast<uint32_t>(new_sections.size()));
+          new_sections.push_back(Section{name, {Line{std::string(raw)}}, 1});
+        }
+      else
+        {
+          std::size_t eq = raw.find('=');
+          std::string_view name = eq == std::string_view::npos ? std::string_view{} : trim(raw.substr(0, eq));
+          if (name.empty())
+            {
+              logger->error("failed to load {}: bad key at line {}", last_filename, line_no);
+              return false;
+            }
+
+          std::size_t offset = std::min(raw.find_first_not_of(" \t", eq + 1), raw.size());
+          std::string key = section.name.empty() ? normalize(std::string(name)) : section.name + "/" + normalize(std::string(name));
+
+          Entry entry{static_cast<uint32_t>(new_sections.size() - 1),
+                      static_cast<uint32_t>(section.lines.size()),
+                      static_cast<uint32_t>(offset),
+                      std::string(trim(raw.substr(offset)))};
+          if (!new_entries.emplace(std::move(key), std::move(entry)).second)
+            {
+              logger->error("failed to load {}: duplicate key at line {}", last_filename, line_no);
+              return false;
+            }
+
+          section.lines.push_back(Line{std::string(raw)});
+          section.insert_at = section.lines.size();
+        }
+    }
+
+  sections = std::move(new_sections);
+  section_index = std::move(new_section_index);
+  entries = std::move(new_entries);
+  return true;
+}
+
+void
+FlatIniConfigurator::save()
+{
+  std::optional<std::string> contents = snapshot();
+  if (contents.has_value() && !ConfigWriter::write_file(last_filename, contents.value()))
+    {
+      logger->error("failed to save {}", last_filename);
+      dirty = true;
+    }
+}
+
+std::string
+FlatIniConfigurator::get_filename() const
+{
+  return last_filename;
+}
+
+std::optional<std::string>
+FlatIniConfigurator::snapshot()
+{
+  if (!dirty || last_filename.empty())
+    {
+      return {};
+    }
+
+  std::string contents;
+  for (const auto &section: sections)
+    {
+      for (const auto &line: section.lines)
+        {
+          if (!line.removed)
+            {
+              contents += line.text;
+              contents += '\n';
+            }
+        }
+    }
+
+  dirty = false;
+  return contents;
+}
+
+void
+FlatIniConfigurator::mark_dirty()
+{
+  dirty = true;
+}
+
+bool
+FlatIniConfigurator::has_user_value(const std::string &key)
+{
+  return find(key) != nullptr || section_index.contains(key);
+}
+
+void
+FlatIniConfigurator::remove_key(const std::string &key)
+{
+  auto it = entries.find(key.find('.') == std::string::npos ? key : normalize(key));
+  if (it != entries.end())
+    {
+      logger->debug("remove {}", key);
+      sections[it->second.section].lines[it->second.line].removed = true;
+      entries.erase(it);
+      dirty = true;
+    }
+}
+
+std::optional<ConfigValue>
+FlatIniConfigurator::get_value(const std::string &key, ConfigType type) const
+{
+  const Entry *entry = find(key);
+  if (entry == nullptr)
+    {
+      return {};
+    }
+
+  switch (type)
+    {
+    case ConfigType::None:
+    case ConfigType::String:
+      return entry->value;
+
+    case ConfigType::Int32:
+      return parse_integer<int32_t>(entry->value);
+
+    case ConfigType::Int64:
+      return parse_integer<int64_t>(entry->value);
+
+    case ConfigType::Bool:
+      return parse_bool(entry->value);
+
+    case ConfigType::Double:
+      return parse_double(entry->value);
+    }
+  return {};
+}
+
+void
+FlatIniConfigurator::set_value(const std::string &key, const ConfigValue &value)
+{
+  std::string text = format(value);
+  logger->debug("write {} = {}", key, text);
+
+  std::string normalized_key = normalize(key);
+  auto it = entries.find(normalized_key);
+  if (it != entries.end())
+    {
+      Entry &entry = it->second;
+      if (entry.value != text)
+        {
+          std::string &line = sections[entry.section].lines[entry.line].text;
+          line.replace(entry.offset, std::string::npos, text);
+          entry.value = std::move(text);
+          dirty = true;
+        }
+      return;
+    }
+
+  std::string section_name;
+  std::string name = key;
+  std::string::size_type pos = key.find('/');
+  if (pos != std::string::npos)
+    {
+      section_name = key.substr(0, pos);
+      name = key.substr(pos + 1);
+      std::replace(name.begin(), name.end(), '/', '.');
+    }
+
+  Section &section = get_section(section_name);
+  auto index = static_cast<uint32_t>(&section - sections.data());
+  auto line = static_cast<uint32_t>(section.insert_at);
+
+  section.lines.insert(section.lines.begin() + static_cast<std::ptrdiff_t>(section.insert_at), Line{name + "=" + text});
+  section.insert_at++;
+
+  entries.emplace(std::move(normalized_key), Entry{index, line, static_cast<uint32_t>(name.size() + 1), std::move(text)});
+  dirty = true;
+}
+
+const FlatIniConfigurator::Entry *
+FlatIniConfigurator::find(const std::string &key) const
+{
+  auto it = key.find('.') == std::string::npos ? entries.find(key) : entries.find(normalize(key));
+  return it != entries.end() ? &it->second : nullptr;
+}
+
+FlatIniConfigurator::Section &
+FlatIniConfigurator::get_section(const std::string &name)
+{
+  if (name.empty())
+    {
+      return sections.front();
+    }
+
+  auto it = section_index.find(name);
+  if (it != section_index.end())
+    {
+      return sections[it->second];
+    }
+
+  section_index.emplace(name, static_cast<uint32_t>(sections.size()));
+  return sections.emplace_back(Section{name, {Line{"[" + name + "]"}}, 1});
+}
+
+//! Returns the key with '/' between all of its parts.
+std::string
+FlatIniConfigurator::normalize(std::string key)
+{
+  std::replace(key.begin(), key.end(), '.', '/');
+  return key;
+}
+
+std::string
+FlatIniConfigurator::format(const ConfigValue &value)
+{
+  return std::visit(
+    [](auto &&arg) -> std::string {
+      using T = std::decay_t<decltype(arg)>;
+
+      if constexpr (std::is_same_v<bool, T>)
+        {
+          return arg ? "true" : "false";
+        }
+      else if constexpr (std::is_same_v<std::string, T>)
+        {
+          return arg;
+        }
+      else
+        {
+          char buf[32];
+          auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), arg);
+          return std::string(buf, ptr);
+        }
+    },
+    value);
+}
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef FLATINICONFIGURATOR_HH
+#define FLATINICONFIGURATOR_HH
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "IConfigBackend.hh"
+#include "utils/Logging.hh"
+
+//! INI file backend with a flat index over all keys.
+/*!
+ *  The key "section/a/b" is stored as "a.b=" in "[section]", as by
+ *  IniConfigurator. The file is kept as a list of lines, so comments,
+ *  blank lines and the order of keys survive a save. Lookups are a single
+ *  hash lookup and never throw.
+ */
+class FlatIniConfigurator
+  : public virtual IConfigBackend
+  , public IConfigBackendFile
+{
+public:
+  FlatIniConfigurator() = default;
+  ~FlatIniConfigurator() override = default;
+
+  bool load(std::string filename) override;
+  void save() override;
+
+  void remove_key(const std::string &key) override;
+  bool has_user_value(const std::string &key) override;
+  std::optional<ConfigValue> get_value(const std::string &key, ConfigType type) const override;
+  void set_value(const std::string &key, const ConfigValue &value) override;
+
+  std::string get_filename() const override;
+  std::optional<std::string> snapshot() override;
+  void mark_dirty() override;
+
+private:
+  struct Line
+  {
+    std::string text;
+    bool removed{false};
+  };
+
+  struct Section
+  {
+    std::string name;
+    std::vector<Line> lines;
+
+    //! Index in lines at which a new key is added: after the last key, before trailing comments.
+    std::size_t insert_at{0};
+  };
+
+  struct Entry
+  {
+    uint32_t section;
+    uint32_t line;
+
+    //! Offset of the value in the line.
+    uint32_t offset;
+    std::string value;
+  };
+
+  bool parse(const std::string &contents);
+  const Entry *find(const std::string &key) const;
+  Section &get_section(const std::string &name);
+
+  static std::string normalize(std::string key);
+  static std::string format(const ConfigValue &value);
+
+private:
+  std::vector<Section> sections = std::vector<Section>(1);
+  std::unordered_map<std::string, uint32_t> section_index;
+
+  //! Entries by key, with '/' between section and key and within the key.
+  std::unordered_map<std::string, Entry> entries;
+
+  std::string last_filename;
+  bool dirty{false};
+  std::shared_ptr<spdlog::logger> logger{workrave::utils::Logging::create("config:ini")};
+};
+
+#endif // FLATINICONFIGURATOR_HH
@@ -41,6 +41,14 @@ GSettingsConfigurator::GSettingsConfigurator()
 GSettingsConfigurator::~GSettingsConfigurator()
 {
   for (const auto &[key, setting]: settings)
+    {
+      g_object_unref(setting.settings);
+      if (setting.schema != nullptr)
+        {
+          g_settings_schema_unref(setting.schema);
+        }
+    }
+  for (const auto &[key, setting]: transaction_settings)
     {
       g_object_unref(setting);
     }
@@ -63,7 +71,10 @@ GSettingsConfigurator::remove_key(const std::string &key)
 {
   std::string subkey;
   GSettings *child = get_settings(key, subkey);
-  g_settings_reset(child, subkey.c_str());
+  if (child != nullptr)
+    {
+      g_settings_reset(child, subkey.c_str());
+    }
 }
 
 bool
@@ -71,6 +82,11 @@ GSettingsConfigurator::has_user_value(const std::string &key)
 {
   std::string subkey;
   GSettings *child = get_settings(key, subkey);
+  if (child == nullptr)
+    {
+      return false;
+    }
+
   GVariant *value = g_settings_get_user_value(child, subkey.c_str());
   if (value != nullptr)
     {
@@ -222,14 +238,38 @@ GSettingsConfigurator::remove_listener(const std::string &remove_key)
   return true;
 }
 
+void
+GSettingsConfigurator::delay_changes()
+{
+  // Delay mode cannot be left, so the transaction is written through separate objects that are dropped once applied.
+  for (const auto &[schema, setting]: settings)
+    {
+      GSettings *delayed = g_settings_new(schema.c_str());
+      g_settings_delay(delayed);
+      transaction_settings[schema] = delayed;
+    }
+}
+
+void
+GSettingsConfigurator::apply_changes()
+{
+  for (const auto &[schema, delayed]: transaction_settings)
+    {
+      g_settings_apply(delayed);
+      g_object_unref(delayed);
+    }
+  transaction_settings.clear();
+}
+
 void
 GSettingsConfigurator::add_children()
 {
   TRACE_ENTRY();
   std::size_t len = schema_base.length();
 
+  GSettingsSchemaSource *source = g_settings_schema_source_get_default();
   gchar **schemas = nullptr;
-  g_settings_schema_source_list_schemas(g_settings_schema_source_get_default(), TRUE, &schemas, nullptr);
+  g_settings_schema_source_list_schemas(source, TRUE, &schemas, nullptr);
 
   for (int i = 0; schemas[i] != nullptr; i++)
     {
@@ -237,7 +277,7 @@ GSettingsConfigurator::add_children()
         {
           GSettings *gsettings = g_settings_new(schemas[i]);
 
-          settings[schemas[i]] = gsettings;
+          settings[schemas[i]] = SchemaSettings{gsettings, g_settings_schema_source_lookup(source, schemas[i], TRUE)};
           g_signal_connect(gsettings, "changed", G_CALLBACK(on_settings_changed), this);
         }
     }
@@ -311,5 +351,16 @@ GSettingsConfigurator::get_settings(const std::string &key, std::string &subkey)
       return nullptr;
     }
 
-  return i->second;
+  // GSettings aborts on keys that are not in the schema, e.g. keys only known to a newer schema.
+  if (i->second.schema == nullptr || !g_settings_schema_has_key(i->second.schema, subkey.c_str()))
+    {
+      TRACE_MSG("Unknown key");
+      return nullptr;
+    }
+
+  if (!transaction_settings.empty())
+    {
+      return transaction_settings.at(i->first);
+    }
+  return i->second.settings;
 }
@@ -47,6 +47,8 @@ public:
   void set_listener(workrave::config::IConfiguratorListener *listener) override;
   bool add_listener(const std::string &key_prefix) override;
   bool remove_listener(const std::string &key_prefix) override;
+  void delay_changes() override;
+  void apply_changes() override;
 
 private:
   void add_children();
@@ -60,7 +62,17 @@ private:
   std::string path_base{"/org/workrave/"};
 
   workrave::config::IConfiguratorListener *listener{nullptr};
-  std::map<std::string, GSettings *> settings;
+  struct SchemaSettings
+  {
+    GSettings *settings{nullptr};
+    GSettingsSchema *schema{nullptr};
+  };
+
+  //! Settings object and schema of each Workrave schema, by schema id.
+  std::map<std::string, SchemaSettings> settings;
+
+  //! Delayed copies of settings that hold the writes of a transaction until they are applied.
+  std::map<std::string, GSettings *> transaction_settings;
   std::shared_ptr<spdlog::logger> logger{workrave::utils::Logging::create("config:gsettings")};
 };
 
@@ -100,6 +100,26 @@ public:
   virtual void set_listener(workrave::config::IConfiguratorListener *listener) = 0;
   virtual bool add_listener(const std::string &key_prefix) = 0;
   virtual bool remove_listener(const std::string &key_prefix) = 0;
+
+  //! Holds back writes until apply_changes(), so that they are stored and reported together.
+  virtual void delay_changes() = 0;
+  virtual void apply_changes() = 0;
+};
+
+//! A backend that stores its configuration in a file.
+class IConfigBackendFile
+{
+public:
+  virtual ~IConfigBackendFile() = default;
+
+  //! Returns the file to which save() writes.
+  virtual std::string get_filename() const = 0;
+
+  //! Returns the contents that save() would write, or nothing if the file is up to date.
+  virtual std::optional<std::string> snapshot() = 0;
+
+  //! Marks the file as out of date, after the contents of a snapshot() failed to be written.
+  virtual void mark_dirty() = 0;
 };
 
 #endif // ICONFIGBACKEND_HH
@@ -26,11 +26,13 @@
 #include "IniConfigurator.hh"
 
 #include <iostream>
-#include <fstream>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 
+#include "ConfigWriter.hh"
+
 bool
 IniConfigurator::load(std::string filename)
 {
@@ -53,15 +55,44 @@ IniConfigurator::load(std::string filename)
 void
 IniConfigurator::save()
 {
+  std::optional<std::string> contents = snapshot();
+  if (contents.has_value() && !ConfigWriter::write_file(last_filename, contents.value()))
+    {
+      logger->error("failed to save {}", last_filename);
+    }
+}
+
+std::string
+IniConfigurator::get_filename() const
+{
+  return last_filename;
+}
+
+std::optional<std::string>
+IniConfigurator::snapshot()
+{
+  if (last_filename.empty())
+    {
+      return {};
+    }
+
   try
     {
-      std::ofstream config_file(last_filename.c_str());
-      boost::property_tree::ini_parser::write_ini(config_file, pt);
+      std::ostringstream contents;
+      boost::property_tree::ini_parser::write_ini(contents, pt);
+      return contents.str();
     }
   catch (boost::property_tree::ini_parser_error &e)
     {
       logger->error("failed to save ({})", e.what());
     }
+  return {};
+}
+
+//! Snapshots are always complete, so there is nothing to mark.
+void
+IniConfigurator::mark_dirty()
+{
 }
 
 bool
@@ -24,7 +24,9 @@
 #include "IConfigBackend.hh"
 #include "utils/Logging.hh"
 
-class IniConfigurator : public virtual IConfigBackend
+class IniConfigurator
+  : public virtual IConfigBackend
+  , public IConfigBackendFile
 {
 public:
   IniConfigurator() = default;
@@ -38,6 +40,10 @@ public:
   std::optional<ConfigValue> get_value(const std::string &key, ConfigType type) const override;
   void set_value(const std::string &key, const ConfigValue &value) override;
 
+  std::string get_filename() const override;
+  std::optional<std::string> snapshot() override;
+  void mark_dirty() override;
+
 private:
   static boost::property_tree::ptree::path_type path(const std::string &key);
 
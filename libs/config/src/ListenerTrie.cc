@@ -0,0 +1,180 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ListenerTrie.hh"
+
+#include <algorithm>
+
+bool
+ListenerTrie::next_segment(std::string_view &path, std::string_view &segment)
+{
+  std::size_t start = path.find_first_not_of('/');
+  if (start == std::string_view::npos)
+    {
+      path = {};
+      return false;
+    }
+
+  path.remove_prefix(start);
+  std::size_t end = std::min(path.find('/'), path.size());
+  segment = path.substr(0, end);
+  path.remove_prefix(end);
+  return true;
+}
+
+ListenerTrie::Node *
+ListenerTrie::lookup(std::string_view prefix, bool create)
+{
+  Node *node = &root;
+  std::string_view segment;
+  while (next_segment(prefix, segment))
+    {
+      auto i = node->children.find(segment);
+      if (i == node->children.end())
+        {
+          if (!create)
+            {
+              return nullptr;
+            }
+          i = node->children.emplace(std::string(segment), std::make_unique<Node>()).first;
+
+          auto &lengths = node->child_lengths;
+          auto l = std::lower_bound(lengths.begin(), lengths.end(), segment.size());
+          if (l == lengths.end() || *l != segment.size())
+            {
+              lengths.insert(l, segment.size());
+            }
+        }
+      node = i->second.get();
+    }
+  return node;
+}
+
+void
+ListenerTrie::collect(const Node &node, std::vector<Registration> &found)
+{
+  for (const auto &[listener, sequence]: node.listeners)
+    {
+      found.emplace_back(sequence, listener);
+    }
+}
+
+bool
+ListenerTrie::add(std::string_view prefix, Listener *listener)
+{
+  Node *node = lookup(prefix, true);
+  if (!node->listeners.emplace(listener, next_sequence).second)
+    {
+      return false;
+    }
+
+  next_sequence++;
+  registrations[listener].push_back(node);
+  return true;
+}
+
+bool
+ListenerTrie::remove(Listener *listener)
+{
+  auto i = registrations.find(listener);
+  if (i == registrations.end())
+    {
+      return false;
+    }
+
+  for (Node *node: i->second)
+    {
+      node->listeners.erase(listener);
+    }
+  registrations.erase(i);
+  return true;
+}
+
+bool
+ListenerTrie::remove(std::string_view prefix, Listener *listener)
+{
+  Node *node = lookup(prefix, false);
+  if (node == nullptr || node->listeners.erase(listener) == 0)
+    {
+      return false;
+    }
+
+  auto i = registrations.find(listener);
+  std::erase(i->second, node);
+  if (i->second.empty())
+    {
+      registrations.erase(i);
+    }
+  return true;
+}
+
+std::vector<ListenerTrie::Listener *>
+ListenerTrie::find(std::string_view key) const
+{
+  std::vector<Registration> found = find_registrations(key);
+
+  std::vector<Listener *> ret;
+  ret.reserve(found.size());
+  for (const auto &[sequence, listener]: found)
+    {
+      ret.push_back(listener);
+    }
+  return ret;
+}
+
+std::vector<ListenerTrie::Registration>
+ListenerTrie::find_registrations(std::string_view key) const
+{
+  std::vector<Registration> found;
+
+  const Node *node = &root;
+  collect(*node, found);
+
+  std::string_view segment;
+  while (next_segment(key, segment))
+    {
+      // Prefixes that end within this segment.
+      for (std::size_t length: node->child_lengths)
+        {
+          if (length >= segment.size())
+            {
+              break;
+            }
+          auto i = node->children.find(segment.substr(0, length));
+          if (i != node->children.end())
+            {
+              collect(*i->second, found);
+            }
+        }
+
+      auto i = node->children.find(segment);
+      if (i == node->children.end())
+        {
+          break;
+        }
+      node = i->second.get();
+      collect(*node, found);
+    }
+
+  std::sort(found.begin(), found.end());
+  return found;
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef LISTENERTRIE_HH
+#define LISTENERTRIE_HH
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "config/IConfiguratorListener.hh"
+
+//! Configuration listeners, by key prefix.
+/*!
+ *  Prefixes are stored in a trie of '/'-separated key segments, so finding
+ *  the listeners of a key takes time proportional to its number of segments,
+ *  independent of the number of listeners. As before, a prefix is a plain
+ *  string prefix, so "timers/micro" also matches "timers/micro_pause/limit".
+ *  Such matches are found by probing, at each segment of the key, only the
+ *  distinct lengths of the child segments of that node. Leading, trailing and
+ *  repeated '/' are ignored.
+ */
+class ListenerTrie
+{
+public:
+  using Listener = workrave::config::IConfiguratorListener;
+
+  //! A listener added for a prefix, with a sequence number that identifies the registration.
+  using Registration = std::pair<uint64_t, Listener *>;
+
+  //! Adds a listener. Returns false if it was already added for this prefix.
+  bool add(std::string_view prefix, Listener *listener);
+
+  //! Removes the listener from all prefixes.
+  bool remove(Listener *listener);
+
+  //! Removes the listener from the prefix.
+  bool remove(std::string_view prefix, Listener *listener);
+
+  //! Returns the listeners of all prefixes of the key, in the order in which they were added.
+  std::vector<Listener *> find(std::string_view key) const;
+
+  //! Returns the registrations of all prefixes of the key, in the order in which they were added.
+  std::vector<Registration> find_registrations(std::string_view key) const;
+
+private:
+  struct SegmentHash
+  {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view segment) const
+    {
+      return std::hash<std::string_view>{}(segment);
+    }
+  };
+
+  struct Node
+  {
+    //! Nodes of the next segment.
+    std::unordered_map<std::string, std::unique_ptr<Node>, SegmentHash, std::equal_to<>> children;
+
+    //! Distinct lengths of the segments in children, sorted.
+    std::vector<std::size_t> child_lengths;
+
+    //! Listeners of the prefix that ends here, with the sequence number of their registration.
+    std::unordered_map<Listener *, uint64_t> listeners;
+  };
+
+  Node *lookup(std::string_view prefix, bool create);
+  static void collect(const Node &node, std::vector<Registration> &found);
+  static bool next_segment(std::string_view &path, std::string_view &segment);
+
+private:
+  Node root;
+
+  //! Nodes at which each listener is registered.
+  std::unordered_map<Listener *, std::vector<Node *>> registrations;
+
+  uint64_t next_sequence{0};
+};
+
+#endif // LISTENERTRIE_HH
@@ -23,10 +23,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 
+#include "ConfigWriter.hh"
 #include "IConfigBackend.hh"
 
 bool
@@ -50,15 +52,44 @@ XmlConfigurator::load(std::string filename)
 void
 XmlConfigurator::save()
 {
+  std::optional<std::string> contents = snapshot();
+  if (contents.has_value() && !ConfigWriter::write_file(last_filename, contents.value()))
+    {
+      logger->error("failed to save {}", last_filename);
+    }
+}
+
+std::string
+XmlConfigurator::get_filename() const
+{
+  return last_filename;
+}
+
+std::optional<std::string>
+XmlConfigurator::snapshot()
+{
+  if (last_filename.empty())
+    {
+      return {};
+    }
+
   try
     {
-      std::ofstream config_file(last_filename.c_str());
-      boost::property_tree::xml_parser::write_xml(config_file, pt);
+      std::ostringstream contents;
+      boost::property_tree::xml_parser::write_xml(contents, pt);
+      return contents.str();
     }
   catch (boost::property_tree::xml_parser_error &e)
     {
       logger->error("failed to save ({})", e.what());
     }
+  return {};
+}
+
+//! Snapshots are always complete, so there is nothing to mark.
+void
+XmlConfigurator::mark_dirty()
+{
 }
 
 bool
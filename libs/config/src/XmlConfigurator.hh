@@ -25,7 +25,9 @@
 
 #include "utils/Logging.hh"
 
-class XmlConfigurator : public virtual IConfigBackend
+class XmlConfigurator
+  : public virtual IConfigBackend
+  , public IConfigBackendFile
 {
 public:
   XmlConfigurator() = default;
@@ -39,6 +41,10 @@ public:
   std::optional<ConfigValue> get_value(const std::string &key, ConfigType type) const override;
   void set_value(const std::string &key, const ConfigValue &value) override;
 
+  std::string get_filename() const override;
+  std::optional<std::string> snapshot() override;
+  void mark_dirty() override;
+
 private:
   static std::string path(const std::string &key);
 
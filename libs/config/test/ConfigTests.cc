@@ -24,6 +24,12 @@
 using namespace boost::unit_test;
 #include <boost/mpl/list.hpp>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #if SPDLOG_VERSION >= 10801
@@ -32,10 +38,13 @@ using namespace boost::unit_test;
 
 #include "SimulatedTime.hh"
 
+#include "ConfigWriter.hh"
 #include "Configurator.hh"
 #include "config/SettingCache.hh"
+#include "utils/Diagnostics.hh"
 #include "utils/Logging.hh"
 
+#include "FlatIniConfigurator.hh"
 #include "IniConfigurator.hh"
 #include "XmlConfigurator.hh"
 #if defined(HAVE_GSETTINGS)
@@ -92,6 +101,118 @@ public:
   }
 };
 
+//! In-memory backend that reports changes like GSettings: when written, or when the writes of a transaction are applied.
+class MonitoringTestConfigurator
+  : public IConfigBackend
+  , public IConfigBackendMonitoring
+{
+public:
+  bool load(std::string filename) override
+  {
+    return true;
+  }
+
+  void save() override
+  {
+  }
+
+  void remove_key(const std::string &key) override
+  {
+    values.erase(key);
+    report(key);
+  }
+
+  bool has_user_value(const std::string &key) override
+  {
+    return values.contains(key);
+  }
+
+  std::optional<ConfigValue> get_value(const std::string &key, ::ConfigType type) const override
+  {
+    auto i = delayed_values.find(key);
+    if (i == delayed_values.end())
+      {
+        i = values.find(key);
+        if (i == values.end())
+          {
+            return {};
+          }
+      }
+    ConfigValue value = i->second;
+    if (type != ::ConfigType::None && ConfigValueToType(value) != type)
+      {
+        return {};
+      }
+    return value;
+  }
+
+  void set_value(const std::string &key, const ConfigValue &value) override
+  {
+    if (delayed)
+      {
+        delayed_values[key] = value;
+        return;
+      }
+    values[key] = value;
+    report(key);
+  }
+
+  void set_listener(IConfiguratorListener *l) override
+  {
+    listener = l;
+  }
+
+  bool add_listener(const std::string &key_prefix) override
+  {
+    return true;
+  }
+
+  bool remove_listener(const std::string &key_prefix) override
+  {
+    return true;
+  }
+
+  void delay_changes() override
+  {
+    delayed = true;
+  }
+
+  void apply_changes() override
+  {
+    delayed = false;
+    for (const auto &[key, value]: std::exchange(delayed_values, {}))
+      {
+        values[key] = value;
+        report(key);
+      }
+  }
+
+  //! Returns the value as other readers of the store see it, without the writes of an unapplied transaction.
+  std::optional<ConfigValue> get_stored_value(const std::string &key) const
+  {
+    auto i = values.find(key);
+    if (i == values.end())
+      {
+        return {};
+      }
+    return i->second;
+  }
+
+private:
+  void report(const std::string &key)
+  {
+    if (listener != nullptr)
+      {
+        listener->config_changed_notify(key);
+      }
+  }
+
+  std::map<std::string, ConfigValue> values;
+  std::map<std::string, ConfigValue> delayed_values;
+  IConfiguratorListener *listener{nullptr};
+  bool delayed{false};
+};
+
 class Fixture;
 namespace helper
 {
@@ -114,7 +235,10 @@ public:
 
   ~Fixture()
   {
-    configurator->remove_listener(this);
+    if (configurator)
+      {
+        configurator->remove_listener(this);
+      }
 
 #if defined(HAVE_GSETTINGS)
     g_unsetenv("GSETTINGS_BACKEND");
@@ -276,6 +400,7 @@ public:
   Configurator::Ptr configurator;
   bool has_defaults{false};
   bool can_remove{true};
+  bool monitoring{false};
   std::string expected_key;
   int config_changed_count{0};
 };
@@ -290,6 +415,7 @@ namespace helper
     g_setenv("GSETTINGS_BACKEND", "memory", 1);
     fixture->has_defaults = true;
     fixture->can_remove = false;
+    fixture->monitoring = true;
   }
 #endif
 #if defined(HAVE_QT)
@@ -346,11 +472,35 @@ operator<<(std::ostream &stream, Fixture::Mode mode)
   return stream;
 }
 
+//! Records the notifications of a listener.
+struct Recorder : public IConfiguratorListener
+{
+  Recorder(std::vector<std::string> &log, std::string name)
+    : log(log)
+    , name(std::move(name))
+  {
+  }
+
+  void config_changed_notify(const std::string &key) override
+  {
+    log.push_back(name + ":" + key);
+    if (on_notify)
+      {
+        on_notify();
+      }
+  }
+
+  std::vector<std::string> &log;
+  std::string name;
+  std::function<void()> on_notify;
+};
+
 BOOST_TEST_GLOBAL_FIXTURE(GlobalFixture);
 
 BOOST_FIXTURE_TEST_SUITE(config, Fixture)
 
 using backend_types = boost::mpl::list<IniConfigurator,
+                                       FlatIniConfigurator,
                                        XmlConfigurator
 #if defined(HAVE_GSETTINGS)
                                        ,
@@ -376,7 +526,7 @@ using non_file_backend_types = boost::mpl::list<
 #endif
   >;
 
-using file_backend_types = boost::mpl::list<XmlConfigurator, IniConfigurator>;
+using file_backend_types = boost::mpl::list<XmlConfigurator, IniConfigurator, FlatIniConfigurator>;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_string, T, backend_types)
 {
@@ -860,6 +1010,165 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_listener_add_remove, T, backend_
   BOOST_CHECK_EQUAL(ok, false);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_listener_dispatch, T, backend_types)
+{
+  init<T>();
+
+  std::vector<std::string> log;
+  Recorder a(log, "a");
+  Recorder b(log, "b");
+  Recorder c(log, "c");
+
+  configurator->add_listener("test/other/int32", &a);
+  configurator->add_listener("", &b);
+  configurator->add_listener("test/other/int", &c);
+  configurator->add_listener("test/", &a);
+
+  configurator->set_value("test/other/int32", 2001);
+  BOOST_CHECK_EQUAL(log.size(), 4);
+  BOOST_CHECK_EQUAL(log[0], "a:test/other/int32");
+  BOOST_CHECK_EQUAL(log[1], "b:test/other/int32");
+  BOOST_CHECK_EQUAL(log[2], "c:test/other/int32");
+  BOOST_CHECK_EQUAL(log[3], "a:test/other/int32");
+
+  log.clear();
+  configurator->set_value("test/other/double", 2001.2001);
+  BOOST_CHECK_EQUAL(log.size(), 2);
+  BOOST_CHECK_EQUAL(log[0], "b:test/other/double");
+  BOOST_CHECK_EQUAL(log[1], "a:test/other/double");
+
+  // Listeners removed during dispatch are still notified of the current change.
+  log.clear();
+  a.on_notify = [&]() { configurator->remove_listener(&c); };
+  configurator->set_value("test/other/int32", 2002);
+  BOOST_CHECK_EQUAL(log.size(), 4);
+
+  log.clear();
+  configurator->set_value("test/other/int32", 2003);
+  BOOST_CHECK_EQUAL(log.size(), 3);
+  BOOST_CHECK_EQUAL(log[2], "a:test/other/int32");
+
+  a.on_notify = nullptr;
+  BOOST_CHECK_EQUAL(configurator->remove_listener("test", &a), true);
+  BOOST_CHECK_EQUAL(configurator->remove_listener("test", &a), false);
+  BOOST_CHECK_EQUAL(configurator->remove_listener(&a), true);
+  BOOST_CHECK_EQUAL(configurator->remove_listener(&b), true);
+
+  log.clear();
+  configurator->set_value("test/other/int32", 2004);
+  BOOST_CHECK_EQUAL(log.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_transaction, T, backend_types)
+{
+  init<T>();
+
+  std::vector<std::string> log;
+  Recorder section(log, "section");
+  Recorder single(log, "single");
+
+  configurator->add_listener("test/other", &section);
+  configurator->add_listener("test/other/int32", &single);
+
+  {
+    ConfigTransaction transaction(configurator);
+    configurator->set_value("test/other/int32", 1060);
+    configurator->set_value("test/other/double", 1060.5);
+    configurator->set_value("test/other/int32", 1061);
+
+    {
+      ConfigTransaction nested(configurator);
+      configurator->set_value("test/other/string", "1061");
+    }
+
+    // Changes are visible, but not yet notified.
+    int32_t value{0};
+    BOOST_CHECK_EQUAL(configurator->get_value("test/other/int32", value), true);
+    BOOST_CHECK_EQUAL(value, 1061);
+    BOOST_CHECK_EQUAL(log.size(), 0);
+  }
+
+  BOOST_REQUIRE_EQUAL(log.size(), 2);
+  BOOST_CHECK_EQUAL(log[0], "section:test/other/double");
+  BOOST_CHECK_EQUAL(log[1], "single:test/other/int32");
+
+  std::string str;
+  BOOST_CHECK_EQUAL(configurator->get_value("test/other/string", str), true);
+  BOOST_CHECK_EQUAL(str, "1061");
+
+  // Unchanged values are not notified.
+  log.clear();
+  configurator->set_values({{"test/other/int32", 1061}}, {{"test/other/bool", true}}, {}, {{"test/other/string", "1061"}});
+  BOOST_REQUIRE_EQUAL(log.size(), 1);
+  BOOST_CHECK_EQUAL(log[0], "section:test/other/bool");
+
+  configurator->remove_listener(&section);
+  configurator->remove_listener(&single);
+}
+
+BOOST_AUTO_TEST_CASE(test_configurator_transaction_monitoring)
+{
+  auto *backend = new MonitoringTestConfigurator();
+  configurator = std::make_shared<Configurator>(backend);
+
+  std::vector<std::string> log;
+  Recorder section(log, "section");
+  Recorder single(log, "single");
+
+  configurator->add_listener("test/other", &section);
+  configurator->add_listener("test/other/int32", &single);
+
+  // Without a transaction, the backend reports the change.
+  configurator->set_value("test/other/int32", 1059);
+  BOOST_CHECK_EQUAL(log.size(), 2);
+
+  // The reports of the backend for the committed changes are ignored.
+  log.clear();
+  {
+    ConfigTransaction transaction(configurator);
+    configurator->set_value("test/other/int32", 1060);
+    configurator->set_value("test/other/double", 1060.5);
+  }
+  BOOST_REQUIRE_EQUAL(log.size(), 2);
+  BOOST_CHECK_EQUAL(log[0], "section:test/other/double");
+  BOOST_CHECK_EQUAL(log[1], "single:test/other/int32");
+
+  // Writes after the transaction are stored and reported at once.
+  log.clear();
+  configurator->set_value("test/other/double", 1061.5);
+  BOOST_CHECK_EQUAL(log.size(), 1);
+  BOOST_CHECK(backend->get_stored_value("test/other/double") == ConfigValue(1061.5));
+
+  // Other changes of the same keys are reported, including a change back to the committed value.
+  log.clear();
+  backend->set_value("test/other/int32", 1061);
+  BOOST_CHECK_EQUAL(log.size(), 2);
+  backend->set_value("test/other/int32", 1060);
+  BOOST_CHECK_EQUAL(log.size(), 4);
+
+  configurator->remove_listener(&section);
+  configurator->remove_listener(&single);
+}
+
+#if defined(HAVE_GSETTINGS)
+BOOST_AUTO_TEST_CASE(test_gsettings_set_after_transaction)
+{
+  init<GSettingsConfigurator>();
+
+  {
+    ConfigTransaction transaction(configurator);
+    configurator->set_value("test/other/int32", 1070);
+  }
+
+  configurator->set_value("test/other/int32", 1071);
+
+  // The write is not held back by the transaction before it.
+  GSettings *reader = g_settings_new("org.workrave.test.other");
+  BOOST_CHECK_EQUAL(g_settings_get_int(reader, "int32"), 1071);
+  g_object_unref(reader);
+}
+#endif
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_leading_slash, T, backend_types)
 {
   init<T>();
@@ -1145,6 +1454,43 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_remove, T, backend_types)
     }
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_cache, T, backend_types)
+{
+  init<T>();
+
+  struct Sink : public DiagnosticsSink
+  {
+    void diagnostics_log(const std::string &log) override
+    {
+      logs.push_back(log.substr(log.find(": ") + 2));
+    }
+    std::vector<std::string> logs;
+  };
+
+  int32_t value{0};
+  configurator->set_value("test/other/int32", 1024);
+  configurator->get_value("test/other/int32", value);
+  configurator->get_value("/test/other/int32/", value);
+  BOOST_CHECK_EQUAL(value, 1024);
+
+  configurator->set_value("test/other/int32", 1025);
+  configurator->get_value("test/other/int32", value);
+  BOOST_CHECK_EQUAL(value, 1025);
+
+  // Other types are read and cached separately.
+  std::string str;
+  configurator->get_value("test/other/int32", str);
+  BOOST_CHECK_EQUAL(str, "1025");
+
+  // Hits: the second int32 read, and the change detection of the second set_value.
+  Sink sink;
+  Diagnostics::instance().enable(&sink);
+  Diagnostics::instance().disable();
+
+  BOOST_CHECK(std::find(sink.logs.begin(), sink.logs.end(), "config.cache.hits -> 2") != sink.logs.end());
+  BOOST_CHECK(std::find(sink.logs.begin(), sink.logs.end(), "config.cache.misses -> 4") != sink.logs.end());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_rename_int32_t, T, backend_types)
 {
   init<T>();
@@ -1412,6 +1758,157 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_save_load, T, file_backend_types
   BOOST_CHECK_EQUAL(bvalue, false);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_auto_save, T, file_backend_types)
+{
+  init<T>();
+
+  std::filesystem::remove("temp-auto-save");
+  configurator->load("temp-auto-save");
+
+  configurator->set_value("test/other/int32", 1040);
+  for (int i = 0; i < 31; i++)
+    {
+      tick();
+    }
+
+  // Not saved yet; the next auto save is 30s away.
+  configurator->set_value("test/other/int32", 1041);
+
+  // Loading waits for the background write.
+  configurator->load("temp-auto-save");
+
+  int32_t value{0};
+  BOOST_CHECK_EQUAL(configurator->get_value("test/other/int32", value), true);
+  BOOST_CHECK_EQUAL(value, 1040);
+  BOOST_CHECK_EQUAL(std::filesystem::exists("temp-auto-save.tmp"), false);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_auto_save_failed, T, file_backend_types)
+{
+  init<T>();
+
+  std::filesystem::remove("temp-auto-save-failed");
+  configurator->load("temp-auto-save-failed");
+
+  // The temporary file cannot be created while a directory has its name.
+  std::filesystem::create_directory("temp-auto-save-failed.tmp");
+  configurator->set_value("test/other/int32", 1042);
+  for (int i = 0; i < 31; i++)
+    {
+      tick();
+    }
+
+  // Saving waits for the background write.
+  configurator->save();
+  BOOST_CHECK_EQUAL(std::filesystem::exists("temp-auto-save-failed"), false);
+
+  // The failed write is retried.
+  std::filesystem::remove("temp-auto-save-failed.tmp");
+  configurator->save();
+
+  T backend;
+  BOOST_REQUIRE(backend.load("temp-auto-save-failed"));
+  BOOST_CHECK(backend.get_value("test/other/int32", ::ConfigType::Int32) == ConfigValue(1042));
+}
+
+#if !defined(PLATFORM_OS_WINDOWS)
+BOOST_AUTO_TEST_CASE(test_config_writer_keeps_permissions)
+{
+  std::filesystem::remove("temp-writer-permissions");
+  BOOST_REQUIRE(ConfigWriter::write_file("temp-writer-permissions", "1"));
+
+  auto owner_only = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write;
+  std::filesystem::permissions("temp-writer-permissions", owner_only);
+  BOOST_REQUIRE(ConfigWriter::write_file("temp-writer-permissions", "2"));
+  BOOST_CHECK(std::filesystem::status("temp-writer-permissions").permissions() == owner_only);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_config_writer_coalesce)
+{
+  std::filesystem::remove("temp-writer");
+  {
+    ConfigWriter writer;
+    for (int i = 0; i < 100; i++)
+      {
+        writer.write("temp-writer", std::to_string(i));
+      }
+    writer.flush();
+
+    std::ifstream file("temp-writer");
+    std::string contents;
+    file >> contents;
+    BOOST_CHECK_EQUAL(contents, "99");
+
+    writer.write("temp-writer", "100");
+  }
+
+  // Pending files are written on destruction.
+  std::ifstream file("temp-writer");
+  std::string contents;
+  file >> contents;
+  BOOST_CHECK_EQUAL(contents, "100");
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_ini_format)
+{
+  init<FlatIniConfigurator>();
+
+  {
+    std::ofstream file("temp-flat.ini");
+    file << "; Workrave settings\n"
+            "top = 1\n"
+            "\n"
+            "[timers]\n"
+            "# micro pause\n"
+            "micro_pause.limit = 180\n"
+            "micro_pause.auto_reset=30\n"
+            "\n"
+            "[general]\n"
+            "usage_mode=0\n";
+  }
+
+  BOOST_CHECK_EQUAL(configurator->load("temp-flat.ini"), true);
+
+  int32_t value{0};
+  BOOST_CHECK_EQUAL(configurator->get_value("top", value), true);
+  BOOST_CHECK_EQUAL(value, 1);
+  BOOST_CHECK_EQUAL(configurator->get_value("timers/micro_pause/limit", value), true);
+  BOOST_CHECK_EQUAL(value, 180);
+  BOOST_CHECK_EQUAL(configurator->get_value("timers/micro_pause/snooze", value), false);
+
+  configurator->set_value("timers/micro_pause/limit", 200);
+  configurator->set_value("timers/micro_pause/auto_reset", 30);
+  configurator->set_value("timers/rest_break/limit", 2700);
+  configurator->remove_key("general/usage_mode");
+  configurator->set_value("gui/trayicon_enabled", true);
+  configurator->save();
+
+  std::ifstream file("temp-flat.ini");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  BOOST_CHECK_EQUAL(contents.str(),
+                    "; Workrave settings\n"
+                    "top = 1\n"
+                    "\n"
+                    "[timers]\n"
+                    "# micro pause\n"
+                    "micro_pause.limit = 200\n"
+                    "micro_pause.auto_reset=30\n"
+                    "rest_break.limit=2700\n"
+                    "\n"
+                    "[general]\n"
+                    "[gui]\n"
+                    "trayicon_enabled=true\n");
+  file.close();
+
+  // Nothing changed, so nothing is written.
+  std::filesystem::remove("temp-flat.ini");
+  configurator->set_value("timers/micro_pause/limit", 200);
+  configurator->save();
+  BOOST_CHECK_EQUAL(std::filesystem::exists("temp-flat.ini"), false);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(test_configurator_dummy_save_load, T, non_file_backend_types)
 {
   init<T>();
@@ -1871,4 +2368,28 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_settings_group_connect_tracked, T, backend_ty
   BOOST_CHECK_EQUAL(fired, 2);
 };
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_settings_handle, T, backend_types)
+{
+  init<T>();
+
+  static const SettingHandle<int32_t> handle("test/settings/int32");
+  static const SettingHandle<int32_t> default_handle("test/settings/default/int32", 8888);
+  static const SettingGroupHandle group_handle("test/settings");
+
+  BOOST_CHECK_EQUAL(handle.get_id(), SettingCache::intern("test/settings/int32"));
+  BOOST_CHECK_EQUAL(&handle(configurator), &setting_int32());
+  BOOST_CHECK_EQUAL(&group_handle(configurator), &group());
+  BOOST_CHECK_EQUAL(default_handle(configurator).get(), 8888);
+
+  handle(configurator).set(1055);
+  BOOST_CHECK_EQUAL(setting_int32().get(), 1055);
+
+  // Ids survive a reset, settings are recreated.
+  SettingId id = handle.get_id();
+  SettingCache::reset();
+  BOOST_CHECK_EQUAL(SettingCache::intern("test/settings/int32"), id);
+  BOOST_CHECK_EQUAL(handle(configurator).get(), 1055);
+  BOOST_CHECK_EQUAL(&handle(configurator), &setting_int32());
+};
+
 BOOST_AUTO_TEST_SUITE_END()
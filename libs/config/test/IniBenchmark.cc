@@ -0,0 +1,137 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Compares IniConfigurator with FlatIniConfigurator on lookups of missing
+// and present keys, and on saves.
+//
+// Usage: workrave-config-ini-benchmark [lookups]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FlatIniConfigurator.hh"
+#include "IniConfigurator.hh"
+
+//! Returns the best time of several runs.
+template<typename F>
+static double
+measure_ns(std::size_t count, std::size_t &result, F func)
+{
+  double best = 0;
+  for (int run = 0; run < 5; run++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      result = func();
+      auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      best = (run == 0) ? elapsed : std::min(best, elapsed);
+    }
+  return best / static_cast<double>(count);
+}
+
+static void
+run(const char *name,
+    IConfigBackend &backend,
+    const std::vector<std::string> &present,
+    const std::vector<std::string> &missing,
+    std::size_t count)
+{
+  std::size_t found = 0;
+  double miss = measure_ns(count, found, [&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count; i++)
+      {
+        n += backend.get_value(missing[i % missing.size()], ConfigType::Int32).has_value() ? 1 : 0;
+      }
+    return n;
+  });
+
+  double hit = measure_ns(count, found, [&] {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < count; i++)
+      {
+        n += backend.get_value(present[i % present.size()], ConfigType::Int32).has_value() ? 1 : 0;
+      }
+    return n;
+  });
+
+  std::size_t dummy = 0;
+  double save = measure_ns(1, dummy, [&] {
+    backend.set_value(present.front(), ConfigValue{static_cast<int32_t>(dummy++)});
+    backend.save();
+    return dummy;
+  });
+
+  printf("%-20s missing %9.1f ns  present %9.1f ns  save %9.1f us  (%zu found)\n", name, miss, hit, save / 1000.0, found);
+}
+
+int
+main(int argc, char **argv)
+{
+  std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+
+  // About as many keys as a typical workrave.ini.
+  const char *breaks[] = {"micro_pause", "rest_break", "daily_limit"};
+  const char *names[] = {"limit", "auto_reset", "snooze", "max_preludes", "enabled", "ignorable_break", "exercises", "skippable"};
+  std::vector<std::string> present;
+  std::vector<std::string> missing;
+  for (const char *b: breaks)
+    {
+      for (const char *n: names)
+        {
+          present.push_back(std::string("timers/") + b + "/" + n);
+          missing.push_back(std::string("breaks/") + b + "/" + n);
+        }
+    }
+  for (int i = 0; i < 100; i++)
+    {
+      present.push_back("gui/option_" + std::to_string(i));
+      missing.push_back("gui/missing_" + std::to_string(i));
+    }
+
+  std::string filename = (std::filesystem::temp_directory_path() / "workrave-ini-benchmark.ini").string();
+  {
+    IniConfigurator writer;
+    writer.load(filename);
+    for (const auto &key: present)
+      {
+        writer.set_value(key, ConfigValue{42});
+      }
+    writer.save();
+  }
+
+  IniConfigurator ini;
+  ini.load(filename);
+  run("IniConfigurator", ini, present, missing, count);
+
+  FlatIniConfigurator flat;
+  flat.load(filename);
+  run("FlatIniConfigurator", flat, present, missing, count);
+
+  std::filesystem::remove(filename);
+  return 0;
+}
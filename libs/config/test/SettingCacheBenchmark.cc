@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Compares the cost of resolving a setting by string key with interned handles.
+//
+// Usage: workrave-config-setting-benchmark [accesses]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/ConfiguratorFactory.hh"
+#include "config/SettingCache.hh"
+
+using namespace workrave::config;
+
+//! The lookup that SettingCache used before keys were interned.
+static Setting<int> &
+legacy_get(IConfigurator::Ptr config, const std::string &key)
+{
+  static std::map<std::string, std::shared_ptr<SettingBase>> cache;
+  if (cache.find(key) == cache.end())
+    {
+      cache[key] = std::make_shared<Setting<int>>(config, key, 0);
+    }
+  auto ret = std::dynamic_pointer_cast<Setting<int>>(cache[key]);
+  return *ret;
+}
+
+//! Per-break accessors also expanded the key on every call.
+static std::string
+expand(const std::string &key, const std::string &name)
+{
+  std::string str = key;
+  std::string::size_type pos = 0;
+  while ((pos = str.find("%b", pos)) != std::string::npos)
+    {
+      str.replace(pos, 2, name);
+      pos++;
+    }
+  return str;
+}
+
+//! Returns the best time of several runs.
+template<typename F>
+static double
+measure_ns_per_access(std::size_t count, uintptr_t &result, F func)
+{
+  double best = 0;
+  for (int run = 0; run < 5; run++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      result = func();
+      auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      best = (run == 0) ? elapsed : std::min(best, elapsed);
+    }
+  return best / static_cast<double>(count);
+}
+
+int
+main(int argc, char **argv)
+{
+  std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  IConfigurator::Ptr config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+
+  // About as many settings as the core and the GUI use.
+  const char *breaks[] = {"micro_pause", "rest_break", "daily_limit"};
+  const char *names[] = {"limit", "auto_reset", "reset_pred", "snooze", "max_preludes", "enabled", "ignorable_break", "exercises"};
+  std::vector<std::string> patterns;
+  std::vector<std::string> keys;
+  std::vector<SettingHandle<int>> handles;
+  for (const char *name: names)
+    {
+      patterns.push_back(std::string("timers/%b/") + name);
+      for (const char *b: breaks)
+        {
+          keys.push_back(expand(patterns.back(), b));
+          handles.emplace_back(keys.back(), 0);
+        }
+    }
+
+  // Visit the settings in a fixed, scattered order.
+  std::vector<std::size_t> order(count);
+  for (std::size_t i = 0; i < count; i++)
+    {
+      order[i] = (i * 7919) % keys.size();
+    }
+
+  uintptr_t expected = 0;
+  double reference = measure_ns_per_access(count, expected, [&] {
+    uintptr_t sum = 0;
+    for (std::size_t i: order)
+      {
+        sum += reinterpret_cast<uintptr_t>(&legacy_get(config, expand(patterns[i / 3], breaks[i % 3])));
+      }
+    return sum;
+  });
+  printf("%-20s %7.2f ns/access\n", "legacy, expand", reference);
+
+  double legacy = measure_ns_per_access(count, expected, [&] {
+    uintptr_t sum = 0;
+    for (std::size_t i: order)
+      {
+        sum += reinterpret_cast<uintptr_t>(&legacy_get(config, keys[i]));
+      }
+    return sum;
+  });
+  printf("%-20s %7.2f ns/access, %.1fx\n", "legacy", legacy, reference / legacy);
+
+  uintptr_t interned = 0;
+  double by_key = measure_ns_per_access(count, interned, [&] {
+    uintptr_t sum = 0;
+    for (std::size_t i: order)
+      {
+        sum += reinterpret_cast<uintptr_t>(&SettingCache::get<int>(config, keys[i], 0));
+      }
+    return sum;
+  });
+  printf("%-20s %7.2f ns/access, %.1fx\n", "interned key", by_key, reference / by_key);
+
+  uintptr_t result = 0;
+  double by_handle = measure_ns_per_access(count, result, [&] {
+    uintptr_t sum = 0;
+    for (std::size_t i: order)
+      {
+        sum += reinterpret_cast<uintptr_t>(&handles[i](config));
+      }
+    return sum;
+  });
+  printf("%-20s %7.2f ns/access, %.1fx\n", "handle", by_handle, reference / by_handle);
+
+  if (result != interned)
+    {
+      printf("handle result mismatch\n");
+      return 1;
+    }
+  return 0;
+}
@@ -526,8 +526,20 @@ Statistics::get_current_day() const
   return current_day;
 }
 
-Statistics::DailyStatsImpl *
+std::optional<IStatistics::DailyStats>
 Statistics::get_day(int day) const
+{
+  std::optional<DailyStats> ret;
+  DailyStatsImpl *stats = find_day(day);
+  if (stats != nullptr)
+    {
+      ret = *stats;
+    }
+  return ret;
+}
+
+Statistics::DailyStatsImpl *
+Statistics::find_day(int day) const
 {
   DailyStatsImpl *ret = nullptr;
 
@@ -595,6 +607,115 @@ Statistics::get_history_size() const
   return history.size();
 }
 
+//! The history is loaded by init(), so queries complete immediately.
+std::future<std::optional<IStatistics::DailyStats>>
+Statistics::get_day_async(int day)
+{
+  std::promise<std::optional<DailyStats>> promise;
+  promise.set_value(get_day(day));
+  return promise.get_future();
+}
+
+std::future<std::vector<IStatistics::DailyStats>>
+Statistics::get_range_async(const struct tm &from, const struct tm &to)
+{
+  std::promise<std::vector<DailyStats>> promise;
+  std::vector<DailyStats> ret;
+  for (int i = int(history.size()); i >= 0; i--)
+    {
+      DailyStatsImpl *stats = find_day(i);
+      if (stats != nullptr && !stats->starts_before_date(from.tm_year + 1900, from.tm_mon + 1, from.tm_mday)
+          && (stats->starts_before_date(to.tm_year + 1900, to.tm_mon + 1, to.tm_mday)
+              || stats->starts_at_date(to.tm_year + 1900, to.tm_mon + 1, to.tm_mday)))
+        {
+          ret.push_back(*stats);
+        }
+    }
+  promise.set_value(ret);
+  return promise.get_future();
+}
+
+void
+Statistics::when_history_loaded(std::function<void()> callback)
+{
+  callback();
+}
+
+IStatistics::StatsAggregate
+Statistics::get_aggregate(StatsRange range, int y, int m, int d, int week_start)
+{
+  StatsAggregate ret{};
+
+  struct tm first = {};
+  first.tm_year = y - 1900;
+  first.tm_mon = m - 1;
+  first.tm_mday = d;
+  first.tm_hour = 12;
+  mktime(&first);
+
+  struct tm last = first;
+  switch (range)
+    {
+    case StatsRange::Week:
+      first.tm_mday -= (first.tm_wday - week_start + 7) % 7;
+      last = first;
+      last.tm_mday += 7;
+      break;
+    case StatsRange::Month:
+      first.tm_mday = 1;
+      last = first;
+      last.tm_mon++;
+      break;
+    case StatsRange::Year:
+      first.tm_mday = 1;
+      first.tm_mon = 0;
+      last = first;
+      last.tm_year++;
+      break;
+    case StatsRange::All:
+      break;
+    }
+  mktime(&first);
+  mktime(&last);
+
+  for (int i = int(history.size()); i >= 0; i--)
+    {
+      DailyStatsImpl *stats = find_day(i);
+      if (stats == nullptr)
+        {
+          continue;
+        }
+      if (range != StatsRange::All
+          && (stats->starts_before_date(first.tm_year + 1900, first.tm_mon + 1, first.tm_mday)
+              || !stats->starts_before_date(last.tm_year + 1900, last.tm_mon + 1, last.tm_mday)))
+        {
+          continue;
+        }
+
+      ret.days++;
+      ret.includes_today |= (i == 0);
+      for (int b = 0; b < BREAK_ID_SIZEOF; b++)
+        {
+          for (int v = 0; v < STATS_BREAKVALUE_SIZEOF; v++)
+            {
+              ret.break_stats[b][v] += stats->break_stats[b][v];
+            }
+        }
+      for (int v = 0; v < STATS_VALUE_SIZEOF; v++)
+        {
+          ret.misc_stats[v] += stats->misc_stats[v];
+        }
+    }
+  return ret;
+}
+
+//! This core does not record intraday activity.
+IStatistics::IntradaySamples
+Statistics::get_intraday() const
+{
+  return {};
+}
+
 void
 Statistics::update_current_day(bool active)
 {
@@ -118,10 +118,15 @@ public:
   void add_break_counter(workrave::BreakId bt, StatsBreakValueType st, int value);
 
   DailyStatsImpl *get_current_day() const override;
-  DailyStatsImpl *get_day(int day) const override;
+  std::optional<DailyStats> get_day(int day) const override;
   void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const override;
 
   int get_history_size() const override;
+  std::future<std::optional<DailyStats>> get_day_async(int day) override;
+  std::future<std::vector<DailyStats>> get_range_async(const struct tm &from, const struct tm &to) override;
+  void when_history_loaded(std::function<void()> callback) override;
+  StatsAggregate get_aggregate(StatsRange range, int y, int m, int d, int week_start) override;
+  IntradaySamples get_intraday() const override;
   void set_counter(StatsValueType t, int value);
   int64_t get_counter(StatsValueType t);
 
@@ -136,6 +141,7 @@ private:
   void load_history();
 
 private:
+  DailyStatsImpl *find_day(int day) const;
   void save_day(DailyStatsImpl *stats);
   void save_day(DailyStatsImpl *stats, std::ofstream &stats_file);
   void load(std::ifstream &infile, bool history);
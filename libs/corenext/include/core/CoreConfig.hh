@@ -18,10 +18,12 @@
 #ifndef WORKRAVE_BACKEND_CORECONFIG_HH
 #define WORKRAVE_BACKEND_CORECONFIG_HH
 
+#include <array>
 #include <chrono>
 
 #include "config/IConfigurator.hh"
 #include "config/Setting.hh"
+#include "config/SettingCache.hh"
 #include "core/ICore.hh"
 
 class CoreConfig
@@ -107,6 +109,10 @@ private:
 
   static std::string expand(const std::string &key, workrave::BreakId id);
 
+  //! Returns a handle of the setting for each break.
+  template<typename H, typename... Args>
+  static std::array<H, workrave::BREAK_ID_SIZEOF> per_break(const std::string &key, const Args &...args);
+
 public:
   static void init(workrave::config::IConfigurator::Ptr config);
   static std::string get_break_name(workrave::BreakId id);
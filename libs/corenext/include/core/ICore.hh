@@ -48,8 +48,19 @@ namespace workrave
     virtual void init(IApp *app, const char *display) = 0;
 
     //! Periodic heartbeat. The GUI *MUST* call this method every second.
+    /*!
+     *  Calling this method is cheap when no processing is needed. A GUI that
+     *  wants to avoid idle wakeups may instead call it at the time returned by
+     *  get_next_heartbeat_time() and whenever signal_wakeup() is emitted.
+     */
     virtual void heartbeat() = 0;
 
+    //! Returns the monotonic time (in seconds) at which the next heartbeat is needed.
+    [[nodiscard]] virtual int64_t get_next_heartbeat_time() = 0;
+
+    //! Notification that a heartbeat is needed before the next heartbeat time. May be emitted from a non-GUI thread.
+    virtual boost::signals2::signal<void()> &signal_wakeup() = 0;
+
     //! Force a break of the specified type.
     virtual void force_break(BreakId id, workrave::utils::Flags<BreakHint> break_hint) = 0;
 
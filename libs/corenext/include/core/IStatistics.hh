@@ -19,7 +19,11 @@
 #define WORKRAVE_BACKEND_ISTATISTICS_HH
 
 #include <ctime>
+#include <functional>
+#include <future>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #if defined(PLATFORM_OS_WINDOWS_NATIVE)
 typedef __int64 int64_t;
@@ -77,16 +81,73 @@ namespace workrave
       MiscStats misc_stats;
     };
 
+    enum class StatsRange
+    {
+      Week,
+      Month,
+      Year,
+      All,
+    };
+
+    struct StatsAggregate
+    {
+      //! Number of days with statistics.
+      int days;
+
+      //! Whether the current day is included.
+      bool includes_today;
+
+      //! Statistic of each break
+      BreakStats break_stats[BREAK_ID_SIZEOF];
+
+      //! Misc statistics
+      MiscStats misc_stats;
+    };
+
+    //! Activity during one minute of the current day.
+    struct IntradaySample
+    {
+      //! Minutes since midnight.
+      int minute;
+
+      //! Number of seconds with keyboard or mouse input.
+      int active_seconds;
+
+      int keystrokes;
+      int clicks;
+
+      //! Mouse movement in pixels.
+      int64_t movement;
+    };
+
+    using IntradaySamples = std::vector<IntradaySample>;
+
   public:
     virtual ~IStatistics() = default;
 
     virtual bool delete_all_history() = 0;
     virtual void update() = 0;
     virtual DailyStats *get_current_day() const = 0;
-    virtual DailyStats *get_day(int day) const = 0;
+    virtual std::optional<DailyStats> get_day(int day) const = 0;
     virtual void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const = 0;
     virtual int get_history_size() const = 0;
     virtual void dump() = 0;
+
+    //! Returns the statistics of the specified day once the history is available.
+    virtual std::future<std::optional<DailyStats>> get_day_async(int day) = 0;
+
+    //! Returns the statistics of all days that started between the specified dates (inclusive), oldest first.
+    virtual std::future<std::vector<DailyStats>> get_range_async(const struct tm &from, const struct tm &to) = 0;
+
+    //! Runs the callback once the history is loaded, possibly on a background thread.
+    virtual void when_history_loaded(std::function<void()> callback) = 0;
+
+    //! Returns the totals of the week, month or year that contains the specified date, or of all days.
+    /*! Weeks start at week_start, 0 being Sunday. */
+    virtual StatsAggregate get_aggregate(StatsRange range, int y, int m, int d, int week_start) = 0;
+
+    //! Returns the activity per minute of the current day, for the minutes with activity.
+    virtual IntradaySamples get_intraday() const = 0;
   };
 } // namespace workrave
 
@@ -33,7 +33,7 @@ using namespace workrave;
 using namespace workrave::dbus;
 using namespace std;
 
-BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, IDBus::Ptr dbus)
+BreakDBus::BreakDBus(BreakId break_id, Break *owner, BreakStateModel::Ptr break_state_model, IDBus::Ptr dbus)
   : break_id(break_id)
   , break_state_model(break_state_model)
   , dbus(dbus)
@@ -48,7 +48,7 @@ BreakDBus::BreakDBus(BreakId break_id, BreakStateModel::Ptr break_state_model, I
   try
     {
       string path = string("/org/workrave/Workrave/Break/" + break_name);
-      dbus->connect(path, "org.workrave.BreakInterface", this);
+      dbus->connect(path, "org.workrave.BreakInterface", owner);
       dbus->register_object_path(path);
     }
   catch (dbus::DBusException &)
@@ -85,6 +85,7 @@ BreakDBus::on_break_stage_changed(BreakStage stage)
         {
           string break_name = CoreConfig::get_break_name(break_id);
           iface->BreakStateChanged("/org/workrave/Workrave/Break/" + break_name, progress);
+          iface->StatePropertyChanged("/org/workrave/Workrave/Break/" + break_name, progress);
         }
     }
 #endif
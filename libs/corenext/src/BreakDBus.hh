@@ -25,13 +25,15 @@
 
 #include "BreakStateModel.hh"
 
+class Break;
+
 class BreakDBus : public workrave::utils::Trackable
 {
 public:
   using Ptr = std::shared_ptr<BreakDBus>;
 
 public:
-  BreakDBus(workrave::BreakId break_id, BreakStateModel::Ptr break_state_model, workrave::dbus::IDBus::Ptr dbus);
+  BreakDBus(workrave::BreakId break_id, Break *owner, BreakStateModel::Ptr break_state_model, workrave::dbus::IDBus::Ptr dbus);
   virtual ~BreakDBus() = default;
 
 private:
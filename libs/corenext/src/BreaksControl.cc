@@ -21,10 +21,13 @@
 
 #include "debug.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
+#include <spdlog/spdlog.h>
+
 #include "utils/Paths.hh"
 #include "utils/TimeSource.hh"
 #include "dbus/IDBus.hh"
@@ -89,9 +92,10 @@ BreaksControl::init()
   microbreak_activity_monitor = std::make_shared<TimerActivityMonitor>(activity_monitor, timers[BREAK_ID_MICRO_BREAK]);
 
   load_state();
+  last_save_time = TimeSource::get_monotonic_time_sec_sync();
 }
 
-IBreak::Ptr
+Break::Ptr
 BreaksControl::get_break(BreakId break_id)
 {
   return breaks[break_id];
@@ -161,12 +165,83 @@ BreaksControl::heartbeat()
       b->process();
     }
 
+  if (user_is_active || is_busy())
+    {
+      state_changed = true;
+    }
+
   // Make state persistent.
-  if (TimeSource::get_monotonic_time_sec() % SAVESTATETIME == 0)
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+  if (state_changed && now >= last_save_time + SAVESTATETIME)
     {
       statistics->update();
       save_state();
+
+      last_save_time = now;
+      state_changed = false;
+    }
+}
+
+//! Returns the monotonic time at which the next heartbeat is needed.
+/*!
+ *  While a break is active or a timer is running, the timers must be
+ *  processed every second. Otherwise nothing changes until the earliest
+ *  limit, auto reset or daily reset of any timer, or until the user
+ *  becomes active again.
+ *
+ *  \return the next heartbeat time, or 0 if no heartbeat is needed.
+ */
+int64_t
+BreaksControl::get_next_heartbeat_time() const
+{
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+
+  if (is_busy())
+    {
+      return now;
+    }
+
+  int64_t next = 0;
+  auto update = [&next](int64_t t) {
+    if (t != 0 && (next == 0 || t < next))
+      {
+        next = t;
+      }
+  };
+
+  for (const auto &timer: timers)
+    {
+      update(timer->get_next_limit_time());
+      update(timer->get_next_reset_time());
+
+      int64_t daily_reset_time = timer->get_next_daily_reset_time();
+      if (daily_reset_time != 0)
+        {
+          // Daily resets are based on wall-clock time.
+          update(std::max(now, now + daily_reset_time - TimeSource::get_real_time_sec_sync()));
+        }
+    }
+
+  if (state_changed)
+    {
+      update(last_save_time + SAVESTATETIME);
+    }
+
+  return next;
+}
+
+//! Does the state of any break or timer change every second?
+bool
+BreaksControl::is_busy() const
+{
+  for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
+    {
+      if (breaks[break_id]->is_active() || timers[break_id]->is_running())
+        {
+          return true;
+        }
     }
+  return false;
 }
 
 //! Processes all timers.
@@ -430,26 +505,28 @@ BreaksControl::on_break_event(BreakId break_id, BreakEvent event)
 void
 BreaksControl::save_state() const
 {
-  std::filesystem::path path = Paths::get_state_directory() / "state";
-  ofstream stateFile(path.string());
-
-  stateFile << "WorkRaveState 3" << endl << TimeSource::get_real_time_sec() << endl;
+  if (state_store == nullptr)
+    {
+      return;
+    }
 
+  std::vector<TimerStateStore::Entry> entries;
   for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
     {
-      const string stateStr = timers[break_id]->serialize_state();
-
-      stateFile << stateStr << endl;
+      entries.push_back({timers[break_id]->get_id(), timers[break_id]->get_saved_state()});
     }
 
-  stateFile.close();
+  if (!state_store->save(entries))
+    {
+      spdlog::warn("Failed to save timer state");
+    }
 }
 
 //! Loads the current state.
 void
 BreaksControl::load_state()
 {
-  std::filesystem::path path = Paths::get_state_directory() / "state";
+  state_store = std::make_unique<TimerStateStore>(Paths::get_state_directory() / "timers.state");
 
 #if defined(HAVE_TESTS)
   if (hooks->hook_load_timer_state())
@@ -460,6 +537,34 @@ BreaksControl::load_state()
         }
     }
 #endif
+
+  std::vector<TimerStateStore::Entry> entries;
+  if (state_store->load(entries))
+    {
+      for (const auto &entry: entries)
+        {
+          for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
+            {
+              if (timers[break_id]->get_id() == entry.id)
+                {
+                  timers[break_id]->restore_saved_state(entry.state);
+                  break;
+                }
+            }
+        }
+    }
+  else if (load_legacy_state())
+    {
+      // Migrate to the binary store.
+      save_state();
+    }
+}
+
+//! Loads the state from the text file used by older versions.
+bool
+BreaksControl::load_legacy_state()
+{
+  std::filesystem::path path = Paths::get_state_directory() / "state";
   ifstream state_file(path.string());
 
   int version = 0;
@@ -486,6 +591,7 @@ BreaksControl::load_state()
       state_file >> saveTime;
     }
 
+  bool loaded = ok;
   while (ok && !state_file.eof())
     {
       string id;
@@ -503,4 +609,5 @@ BreaksControl::load_state()
             }
         }
     }
+  return loaded;
 }
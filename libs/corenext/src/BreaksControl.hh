@@ -30,6 +30,7 @@
 #include "Statistics.hh"
 #include "ReadingActivityMonitor.hh"
 #include "TimerActivityMonitor.hh"
+#include "TimerStateStore.hh"
 
 class BreaksControl
   : public std::enable_shared_from_this<BreaksControl>
@@ -49,18 +50,21 @@ public:
   void init();
   void heartbeat();
   void save_state() const;
+  int64_t get_next_heartbeat_time() const;
 
   void force_break(workrave::BreakId id, workrave::utils::Flags<workrave::BreakHint> break_hint);
 
-  workrave::IBreak::Ptr get_break(workrave::BreakId id);
+  Break::Ptr get_break(workrave::BreakId id);
 
   void set_insist_policy(workrave::InsistPolicy p);
 
 private:
+  bool is_busy() const;
   void set_freeze_all_breaks(bool freeze);
   void process_timers(bool user_is_active);
   void start_break(workrave::BreakId break_id, workrave::BreakId resume_this_break = workrave::BREAK_ID_NONE);
   void load_state();
+  bool load_legacy_state();
   void defrost();
   void freeze();
   void force_idle();
@@ -84,8 +88,17 @@ private:
   Break::Ptr breaks[workrave::BREAK_ID_SIZEOF];
   Timer::Ptr timers[workrave::BREAK_ID_SIZEOF];
 
+  //! Persistent timer state.
+  std::unique_ptr<TimerStateStore> state_store;
+
   workrave::InsistPolicy insist_policy;
   workrave::InsistPolicy active_insist_policy;
+
+  //! Time the state was last saved.
+  int64_t last_save_time{0};
+
+  //! Did the timer state change since it was last saved?
+  bool state_changed{true};
 };
 
 #endif // BREAKSCONTROL_HH
@@ -54,6 +54,9 @@ using namespace workrave::config;
 using namespace workrave::dbus;
 using namespace workrave::utils;
 
+//! Upper bound on the time between heartbeats, to recover from wall-clock changes.
+static const int64_t MAX_HEARTBEAT_INTERVAL = 600;
+
 ICore::Ptr
 CoreFactory::create()
 {
@@ -110,9 +113,31 @@ Core::init(IApp *app, const char *display_name)
   breaks_control = std::make_shared<BreaksControl>(application, monitor, core_modes, statistics, dbus, hooks);
   breaks_control->init();
 
+  init_wakeup();
   init_bus();
 }
 
+//! Requests a heartbeat on any change that is not reflected in the next heartbeat time.
+void
+Core::init_wakeup()
+{
+  connect(monitor->signal_activity_changed(), this, [this]() { wakeup(); });
+  connect(core_modes->signal_operation_mode_changed(), this, [this](auto) { wakeup(); });
+  connect(core_modes->signal_usage_mode_changed(), this, [this](auto) { wakeup(); });
+
+  for (BreakId break_id = BREAK_ID_MICRO_BREAK; break_id < BREAK_ID_SIZEOF; break_id++)
+    {
+      connect(breaks_control->get_break(break_id)->signal_break_event(), this, [this](auto) { wakeup(); });
+    }
+}
+
+void
+Core::wakeup()
+{
+  wakeup_pending = true;
+  wakeup_signal();
+}
+
 void
 Core::init_configurator()
 {
@@ -193,6 +218,7 @@ Core::init_bus()
 
       dbus->connect(DBUS_PATH_WORKRAVE "Core", "org.workrave.CoreInterface", this);
       dbus->connect(DBUS_PATH_WORKRAVE "Core", "org.workrave.ConfigInterface", configurator.get());
+      dbus->connect(DBUS_PATH_WORKRAVE "Core", "org.workrave.StatisticsInterface", statistics.get());
       dbus->register_object_path(DBUS_PATH_WORKRAVE "Core");
     }
   catch (DBusException &)
@@ -209,8 +235,43 @@ Core::heartbeat()
   TimeSource::sync();
 
   configurator->heartbeat();
-  breaks_control->heartbeat();
-  core_modes->heartbeat();
+  statistics->process_input_events();
+
+  // Nothing changes between deadlines, unless a wakeup was requested.
+  bool wakeup_requested = wakeup_pending.exchange(false);
+  if (wakeup_requested || TimeSource::get_monotonic_time_sec_sync() >= get_next_heartbeat_time())
+    {
+      breaks_control->heartbeat();
+      core_modes->heartbeat();
+    }
+
+  core_dbus->set_user_active(monitor->is_active());
+}
+
+//! Returns the monotonic time (in seconds) at which the next heartbeat is needed.
+int64_t
+Core::get_next_heartbeat_time()
+{
+  int64_t now = TimeSource::get_monotonic_time_sec_sync();
+  int64_t next = now + MAX_HEARTBEAT_INTERVAL;
+
+  for (int64_t t: {breaks_control->get_next_heartbeat_time(),
+                    core_modes->get_next_heartbeat_time(),
+                    configurator->get_next_heartbeat_time()})
+    {
+      if (t != 0 && t < next)
+        {
+          next = t;
+        }
+    }
+
+  return next;
+}
+
+boost::signals2::signal<void()> &
+Core::signal_wakeup()
+{
+  return wakeup_signal;
 }
 
 /********************************************************************************/
@@ -316,6 +377,7 @@ void
 Core::set_operation_mode_override(OperationMode mode, const std::string &id)
 {
   core_modes->set_operation_mode_override(mode, id);
+  wakeup();
 }
 
 //! Removes the overridden operation mode.
@@ -323,6 +385,7 @@ void
 Core::remove_operation_mode_override(const std::string &id)
 {
   core_modes->remove_operation_mode_override(id);
+  wakeup();
 }
 
 //! Retrieves the usage mode.
@@ -392,6 +455,34 @@ Core::report_external_activity(std::string who, bool act)
   // monitor->report_external_activity(who, act);
 }
 
+//! Returns the state of the core and all breaks in one go.
+Core::State
+Core::get_state()
+{
+  State state;
+  state.operation_mode = core_modes->get_regular_operation_mode();
+  state.usage_mode = core_modes->get_usage_mode();
+  state.active = monitor->is_active();
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      auto id = static_cast<BreakId>(i);
+      Break::Ptr b = breaks_control->get_break(id);
+
+      BreakState break_state;
+      break_state.id = id;
+      break_state.running = b->is_running();
+      break_state.elapsed = b->get_elapsed_time();
+      break_state.idle = b->get_elapsed_idle_time();
+      break_state.remaining = b->get_timer_remaining();
+      break_state.overdue = b->get_total_overdue_time();
+      break_state.stage = b->get_break_stage();
+      state.breaks.push_back(break_state);
+    }
+
+  return state;
+}
+
 // TODO: remove
 namespace workrave
 {
@@ -18,10 +18,13 @@
 #ifndef CORE_HH
 #define CORE_HH
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include "dbus/IDBus.hh"
 #include "config/IConfigurator.hh"
+#include "utils/Signals.hh"
 
 #include "core/ICore.hh"
 #include "LocalActivityMonitor.hh"
@@ -37,9 +40,34 @@ namespace workrave
   class IApp;
 }
 
-class Core : public workrave::ICore
+class Core
+  : public workrave::ICore
+  , public workrave::utils::Trackable
 {
 public:
+  //! Snapshot of the timer of a single break.
+  struct BreakState
+  {
+    workrave::BreakId id{workrave::BREAK_ID_NONE};
+    bool running{false};
+    int64_t elapsed{0};
+    int64_t idle{0};
+    int64_t remaining{0};
+    int64_t overdue{0};
+    std::string stage;
+  };
+
+  using BreakStates = std::vector<BreakState>;
+
+  //! Snapshot of the core and all breaks, so that clients need a single D-Bus round-trip.
+  struct State
+  {
+    workrave::OperationMode operation_mode{workrave::OperationMode::Normal};
+    workrave::UsageMode usage_mode{workrave::UsageMode::Normal};
+    bool active{false};
+    BreakStates breaks;
+  };
+
   Core();
   ~Core() override;
 
@@ -48,6 +76,8 @@ public:
   boost::signals2::signal<void(workrave::UsageMode)> &signal_usage_mode_changed() override;
   void init(workrave::IApp *application, const char *display_name) override;
   void heartbeat() override;
+  int64_t get_next_heartbeat_time() override;
+  boost::signals2::signal<void()> &signal_wakeup() override;
   void force_break(workrave::BreakId id, workrave::utils::Flags<workrave::BreakHint> break_hint) override;
   workrave::IBreak::Ptr get_break(workrave::BreakId id) override;
   workrave::IStatistics::Ptr get_statistics() const override;
@@ -70,10 +100,13 @@ public:
 
   // DBus functions.
   void report_external_activity(std::string who, bool act);
+  State get_state();
 
 private:
   void init_configurator();
   void init_bus();
+  void init_wakeup();
+  void wakeup();
 
 private:
   //! List of breaks.
@@ -105,6 +138,12 @@ private:
 
   //! DBUS bridge
   workrave::dbus::IDBus::Ptr dbus;
+
+  //! Must the next heartbeat be processed regardless of the next heartbeat time?
+  std::atomic<bool> wakeup_pending{true};
+
+  //! Wakeup notification.
+  boost::signals2::signal<void()> wakeup_signal;
 };
 
 #endif // CORE_HH
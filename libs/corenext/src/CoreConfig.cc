@@ -159,134 +159,165 @@ CoreConfig::expand(const string &key, workrave::BreakId id)
   return str;
 }
 
+template<typename H, typename... Args>
+std::array<H, BREAK_ID_SIZEOF>
+CoreConfig::per_break(const string &key, const Args &...args)
+{
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<H, BREAK_ID_SIZEOF>{H(expand(key, static_cast<BreakId>(I)), args...)...};
+  }(std::make_index_sequence<BREAK_ID_SIZEOF>());
+}
+
 SettingGroup &
 CoreConfig::key_timer(workrave::BreakId break_id)
 {
-  return SettingCache::group(config, expand(CFG_KEY_TIMER, break_id));
+  static const auto handles = per_break<SettingGroupHandle>(CFG_KEY_TIMER);
+  return handles[break_id](config);
 }
 
 SettingGroup &
 CoreConfig::key_break(workrave::BreakId break_id)
 {
-  return SettingCache::group(config, expand(CFG_KEY_BREAK, break_id));
+  static const auto handles = per_break<SettingGroupHandle>(CFG_KEY_BREAK);
+  return handles[break_id](config);
 }
 
 SettingGroup &
 CoreConfig::key_timers()
 {
-  return SettingCache::group(config, CFG_KEY_TIMERS);
+  static const SettingGroupHandle handle(CFG_KEY_TIMERS);
+  return handle(config);
 }
 
 SettingGroup &
 CoreConfig::key_breaks()
 {
-  return SettingCache::group(config, CFG_KEY_BREAKS);
+  static const SettingGroupHandle handle(CFG_KEY_BREAKS);
+  return handle(config);
 }
 
 SettingGroup &
 CoreConfig::key_monitor()
 {
-  return SettingCache::group(config, CFG_KEY_MONITOR);
+  static const SettingGroupHandle handle(CFG_KEY_MONITOR);
+  return handle(config);
 }
 
 Setting<int> &
 CoreConfig::timer_limit(workrave::BreakId break_id)
 {
-  return SettingCache::get<int>(config, expand(CFG_KEY_TIMER_LIMIT, break_id));
+  static const auto handles = per_break<SettingHandle<int>>(CFG_KEY_TIMER_LIMIT);
+  return handles[break_id](config);
 }
 
 Setting<int> &
 CoreConfig::timer_auto_reset(workrave::BreakId break_id)
 {
-  return SettingCache::get<int>(config, expand(CFG_KEY_TIMER_AUTO_RESET, break_id));
+  static const auto handles = per_break<SettingHandle<int>>(CFG_KEY_TIMER_AUTO_RESET);
+  return handles[break_id](config);
 }
 
 Setting<std::string> &
 CoreConfig::timer_reset_pred(workrave::BreakId break_id)
 {
-  return SettingCache::get<std::string>(config, expand(CFG_KEY_TIMER_RESET_PRED, break_id));
+  static const auto handles = per_break<SettingHandle<std::string>>(CFG_KEY_TIMER_RESET_PRED);
+  return handles[break_id](config);
 }
 
 Setting<int> &
 CoreConfig::timer_snooze(workrave::BreakId break_id)
 {
-  return SettingCache::get<int>(config, expand(CFG_KEY_TIMER_SNOOZE, break_id));
+  static const auto handles = per_break<SettingHandle<int>>(CFG_KEY_TIMER_SNOOZE);
+  return handles[break_id](config);
 }
 
 Setting<bool> &
 CoreConfig::timer_daily_limit_use_micro_break_activity()
 {
-  return SettingCache::get<bool>(config, CFG_KEY_TIMER_DAILY_LIMIT_USE_MICRO_BREAK_ACTIVITY);
+  static const SettingHandle<bool> handle(CFG_KEY_TIMER_DAILY_LIMIT_USE_MICRO_BREAK_ACTIVITY);
+  return handle(config);
 }
 
 Setting<int> &
 CoreConfig::break_max_preludes(workrave::BreakId break_id)
 {
-  return SettingCache::get<int>(config, expand(CFG_KEY_BREAK_MAX_PRELUDES, break_id));
+  static const auto handles = per_break<SettingHandle<int>>(CFG_KEY_BREAK_MAX_PRELUDES);
+  return handles[break_id](config);
 }
 
 Setting<bool> &
 CoreConfig::break_enabled(workrave::BreakId break_id)
 {
-  return SettingCache::get<bool>(config, expand(CFG_KEY_BREAK_ENABLED, break_id));
+  static const auto handles = per_break<SettingHandle<bool>>(CFG_KEY_BREAK_ENABLED);
+  return handles[break_id](config);
 }
 
 Setting<int> &
 CoreConfig::monitor_noise()
 {
-  return SettingCache::get<int>(config, CFG_KEY_MONITOR_NOISE, 9000);
+  static const SettingHandle<int> handle(CFG_KEY_MONITOR_NOISE, 9000);
+  return handle(config);
 }
 
 Setting<int> &
 CoreConfig::monitor_activity()
 {
-  return SettingCache::get<int>(config, CFG_KEY_MONITOR_ACTIVITY, 1000);
+  static const SettingHandle<int> handle(CFG_KEY_MONITOR_ACTIVITY, 1000);
+  return handle(config);
 }
 
 Setting<int> &
 CoreConfig::monitor_idle()
 {
-  return SettingCache::get<int>(config, CFG_KEY_MONITOR_IDLE, 5000);
+  static const SettingHandle<int> handle(CFG_KEY_MONITOR_IDLE, 5000);
+  return handle(config);
 }
 
 Setting<int> &
 CoreConfig::monitor_sensitivity()
 {
-  return SettingCache::get<int>(config, CFG_KEY_MONITOR_SENSITIVITY, 3);
+  static const SettingHandle<int> handle(CFG_KEY_MONITOR_SENSITIVITY, 3);
+  return handle(config);
 }
 
 Setting<std::string> &
 CoreConfig::general_datadir()
 {
-  return SettingCache::get<std::string>(config, CFG_KEY_GENERAL_DATADIR);
+  static const SettingHandle<std::string> handle(CFG_KEY_GENERAL_DATADIR);
+  return handle(config);
 }
 
 Setting<int, workrave::OperationMode> &
 CoreConfig::operation_mode()
 {
-  return SettingCache::get<int, workrave::OperationMode>(config, CFG_KEY_OPERATION_MODE);
+  static const SettingHandle<int, workrave::OperationMode> handle(CFG_KEY_OPERATION_MODE);
+  return handle(config);
 }
 
 Setting<int, workrave::UsageMode> &
 CoreConfig::usage_mode()
 {
-  return SettingCache::get<int, workrave::UsageMode>(config, CFG_KEY_USAGE_MODE);
+  static const SettingHandle<int, workrave::UsageMode> handle(CFG_KEY_USAGE_MODE);
+  return handle(config);
 }
 
 Setting<int, std::chrono::minutes> &
 CoreConfig::operation_mode_auto_reset_duration()
 {
-  return SettingCache::get<int, std::chrono::minutes>(config, CFG_KEY_OPERATION_MODE_RESET_DURATION);
+  static const SettingHandle<int, std::chrono::minutes> handle(CFG_KEY_OPERATION_MODE_RESET_DURATION);
+  return handle(config);
 }
 
 Setting<int64_t, std::chrono::system_clock::time_point> &
 CoreConfig::operation_mode_auto_reset_time()
 {
-  return SettingCache::get<int64_t, std::chrono::system_clock::time_point>(config, CFG_KEY_OPERATION_MODE_RESET_TIME);
+  static const SettingHandle<int64_t, std::chrono::system_clock::time_point> handle(CFG_KEY_OPERATION_MODE_RESET_TIME);
+  return handle(config);
 }
 
 Setting<std::vector<int>, std::vector<std::chrono::minutes>> &
 CoreConfig::operation_mode_auto_reset_options()
 {
-  return SettingCache::get<std::vector<int>, std::vector<std::chrono::minutes>>(config, CFG_KEY_OPERATION_MODE_RESET_OPTIONS);
+  static const SettingHandle<std::vector<int>, std::vector<std::chrono::minutes>> handle(CFG_KEY_OPERATION_MODE_RESET_OPTIONS);
+  return handle(config);
 }
@@ -40,6 +40,25 @@ CoreDBus::CoreDBus(CoreModes::Ptr modes, IDBus::Ptr dbus)
   connect(modes->signal_usage_mode_changed(), this, [this](auto &&mode) { on_usage_mode_changed(std::forward<decltype(mode)>(mode)); });
 }
 
+//! Publishes a change of user activity through the Active property.
+void
+CoreDBus::set_user_active(bool active)
+{
+  if (active == user_active)
+    {
+      return;
+    }
+  user_active = active;
+
+#if defined(HAVE_DBUS)
+  org_workrave_CoreInterface *iface = org_workrave_CoreInterface::instance(dbus);
+  if (iface != nullptr)
+    {
+      iface->ActivePropertyChanged("/org/workrave/Workrave/Core", active);
+    }
+#endif
+}
+
 void
 CoreDBus::on_operation_mode_changed(OperationMode operation_mode)
 {
@@ -48,6 +67,7 @@ CoreDBus::on_operation_mode_changed(OperationMode operation_mode)
   if (iface != nullptr)
     {
       iface->OperationModeChanged("/org/workrave/Workrave/Core", operation_mode);
+      iface->OperationModePropertyChanged("/org/workrave/Workrave/Core", operation_mode);
     }
 #endif
 }
@@ -60,6 +80,7 @@ CoreDBus::on_usage_mode_changed(UsageMode usage_mode)
   if (iface != nullptr)
     {
       iface->UsageModeChanged("/org/workrave/Workrave/Core", usage_mode);
+      iface->UsageModePropertyChanged("/org/workrave/Workrave/Core", usage_mode);
     }
 #endif
 }
@@ -32,12 +32,17 @@ public:
 
   CoreDBus(CoreModes::Ptr modes, workrave::dbus::IDBus::Ptr dbus);
 
+  void set_user_active(bool active);
+
 private:
   void on_operation_mode_changed(workrave::OperationMode operation_mode);
   void on_usage_mode_changed(workrave::UsageMode usage_mode);
 
 private:
   workrave::dbus::IDBus::Ptr dbus;
+
+  //! User activity as last published in the Active property.
+  bool user_active{false};
 };
 
 #endif // COREDBUS_HH
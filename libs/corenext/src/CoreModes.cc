@@ -19,6 +19,7 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <chrono>
 
 #include <spdlog/spdlog.h>
@@ -259,6 +260,22 @@ CoreModes::heartbeat()
   check_auto_reset();
 }
 
+//! Returns the monotonic time at which the operation mode is automatically reset, or 0.
+int64_t
+CoreModes::get_next_heartbeat_time() const
+{
+  using namespace workrave::utils;
+
+  auto next_reset_time = CoreConfig::operation_mode_auto_reset_time()();
+  if ((next_reset_time.time_since_epoch().count() == 0) || (CoreConfig::operation_mode()() == OperationMode::Normal))
+    {
+      return 0;
+    }
+
+  auto remaining = std::chrono::ceil<std::chrono::seconds>(next_reset_time - TimeSource::get_real_time());
+  return TimeSource::get_monotonic_time_sec_sync() + std::max<int64_t>(0, remaining.count());
+}
+
 //! Performs a reset when the daily limit is reached.
 void
 CoreModes::daily_reset()
@@ -51,6 +51,7 @@ public:
   workrave::UsageMode get_usage_mode();
   void set_usage_mode(workrave::UsageMode mode);
   void heartbeat();
+  int64_t get_next_heartbeat_time() const;
   void daily_reset();
 
 private:
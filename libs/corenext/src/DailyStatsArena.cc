@@ -0,0 +1,192 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "DailyStatsArena.hh"
+
+#include <algorithm>
+#include <limits>
+
+// Conversion between civil dates and day numbers, see
+// http://howardhinnant.github.io/date_algorithms.html
+static int64_t
+days_from_civil(int64_t y, unsigned m, unsigned d)
+{
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const auto yoe = static_cast<unsigned>(y - era * 400);
+  const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static void
+civil_from_days(int64_t z, int &year, int &month, int &day)
+{
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const auto doe = static_cast<unsigned>(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  year = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (month <= 2));
+}
+
+static void
+unpack_time(uint16_t day, uint16_t minute, struct tm &date)
+{
+  int y = 0;
+  int m = 0;
+  int d = 0;
+  civil_from_days(day, y, m, d);
+
+  date.tm_year = y - 1900;
+  date.tm_mon = m - 1;
+  date.tm_mday = d;
+  date.tm_hour = minute / 60;
+  date.tm_min = minute % 60;
+  date.tm_wday = static_cast<int>((day + 4) % 7);
+  date.tm_yday = static_cast<int>(day - days_from_civil(y, 1, 1));
+}
+
+std::optional<uint16_t>
+DailyStatsArena::day_number(int year, int month, int day)
+{
+  int64_t days = days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+  if (days < 0 || days > std::numeric_limits<uint16_t>::max())
+    {
+      return {};
+    }
+  return static_cast<uint16_t>(days);
+}
+
+std::optional<uint16_t>
+DailyStatsArena::day_number(const struct tm &date)
+{
+  return day_number(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday);
+}
+
+void
+DailyStatsArena::civil_date(uint16_t day, int &year, int &month, int &mday)
+{
+  civil_from_days(day, year, month, mday);
+}
+
+std::optional<DailyStatsArena::Record>
+DailyStatsArena::pack(const DailyStats &day)
+{
+  std::optional<uint16_t> start_day = day_number(day.start);
+  std::optional<uint16_t> stop_day = day_number(day.stop);
+  if (!start_day || !stop_day)
+    {
+      return {};
+    }
+
+  Record record{};
+  record.start_day = *start_day;
+  record.stop_day = *stop_day;
+  record.start_minute = static_cast<uint16_t>(day.start.tm_hour * 60 + day.start.tm_min);
+  record.stop_minute = static_cast<uint16_t>(day.stop.tm_hour * 60 + day.stop.tm_min);
+
+  for (int i = 0; i < workrave::BREAK_ID_SIZEOF; i++)
+    {
+      std::copy(std::begin(day.break_stats[i]), std::end(day.break_stats[i]), record.break_stats[i]);
+    }
+
+  for (int i = 0; i < workrave::IStatistics::STATS_VALUE_SIZEOF; i++)
+    {
+      record.misc_stats[i] = static_cast<uint32_t>(std::clamp<int64_t>(day.misc_stats[i], 0, std::numeric_limits<uint32_t>::max()));
+    }
+  return record;
+}
+
+DailyStatsArena::DailyStats
+DailyStatsArena::View::to_daily_stats() const
+{
+  DailyStats day{};
+  unpack_time(record->start_day, record->start_minute, day.start);
+  unpack_time(record->stop_day, record->stop_minute, day.stop);
+
+  for (int i = 0; i < workrave::BREAK_ID_SIZEOF; i++)
+    {
+      std::copy(std::begin(record->break_stats[i]), std::end(record->break_stats[i]), day.break_stats[i]);
+    }
+
+  std::copy(std::begin(record->misc_stats), std::end(record->misc_stats), day.misc_stats);
+  return day;
+}
+
+void
+DailyStatsArena::assign(const std::vector<DailyStats> &days)
+{
+  records.clear();
+  records.reserve(days.size());
+  for (const auto &day: days)
+    {
+      if (auto record = pack(day))
+        {
+          records.push_back(*record);
+        }
+    }
+}
+
+bool
+DailyStatsArena::insert(const DailyStats &day)
+{
+  std::optional<Record> record = pack(day);
+  if (!record)
+    {
+      return false;
+    }
+
+  auto i = records.begin() + static_cast<std::ptrdiff_t>(lower_bound(record->start_day));
+  if (i != records.end() && i->start_day == record->start_day)
+    {
+      *i = *record;
+    }
+  else
+    {
+      records.insert(i, *record);
+    }
+  return true;
+}
+
+void
+DailyStatsArena::clear()
+{
+  records = std::vector<Record>();
+}
+
+std::size_t
+DailyStatsArena::lower_bound(uint16_t day) const
+{
+  auto i = std::lower_bound(records.begin(), records.end(), day, [](const Record &record, uint16_t day) { return record.start_day < day; });
+  return static_cast<std::size_t>(i - records.begin());
+}
+
+std::size_t
+DailyStatsArena::upper_bound(uint16_t day) const
+{
+  auto i = std::upper_bound(records.begin(), records.end(), day, [](uint16_t day, const Record &record) { return day < record.start_day; });
+  return static_cast<std::size_t>(i - records.begin());
+}
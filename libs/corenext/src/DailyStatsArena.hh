@@ -0,0 +1,140 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef DAILYSTATSARENA_HH
+#define DAILYSTATSARENA_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <vector>
+
+#include "core/IStatistics.hh"
+
+//! Packed, contiguous storage of the daily statistics history.
+/*!
+ *  Days are kept sorted by date in a single allocation. Dates are stored as
+ *  16-bit day numbers and counters as 32-bit values, saturating on overflow.
+ */
+class DailyStatsArena
+{
+public:
+  using DailyStats = workrave::IStatistics::DailyStats;
+  using StatsBreakValueType = workrave::IStatistics::StatsBreakValueType;
+  using StatsValueType = workrave::IStatistics::StatsValueType;
+
+  struct Record
+  {
+    //! Days since 1970-01-01 of the start and stop time.
+    uint16_t start_day;
+    uint16_t stop_day;
+
+    //! Minutes since midnight of the start and stop time.
+    uint16_t start_minute;
+    uint16_t stop_minute;
+
+    int32_t break_stats[workrave::BREAK_ID_SIZEOF][workrave::IStatistics::STATS_BREAKVALUE_SIZEOF];
+    uint32_t misc_stats[workrave::IStatistics::STATS_VALUE_SIZEOF];
+  };
+
+  //! Read-only view of a day in the arena.
+  class View
+  {
+  public:
+    explicit View(const Record &record)
+      : record(&record)
+    {
+    }
+
+    uint16_t day() const
+    {
+      return record->start_day;
+    }
+
+    int break_stat(workrave::BreakId break_id, StatsBreakValueType type) const
+    {
+      return record->break_stats[break_id][type];
+    }
+
+    int64_t misc_stat(StatsValueType type) const
+    {
+      return record->misc_stats[type];
+    }
+
+    //! Unpacks the day.
+    DailyStats to_daily_stats() const;
+
+  private:
+    const Record *record;
+  };
+
+  std::size_t size() const
+  {
+    return records.size();
+  }
+
+  bool empty() const
+  {
+    return records.empty();
+  }
+
+  View operator[](std::size_t index) const
+  {
+    return View(records[index]);
+  }
+
+  //! Replaces the contents with days that are sorted by date. Days that cannot be stored are skipped.
+  void assign(const std::vector<DailyStats> &days);
+
+  //! Adds a day, replacing an earlier day of the same date.
+  /*!
+   *  Returns false, and leaves the arena unchanged, if the day cannot be stored.
+   */
+  bool insert(const DailyStats &day);
+
+  //! Removes all days and releases the memory.
+  void clear();
+
+  //! Returns the index of the first day not before the given day number.
+  std::size_t lower_bound(uint16_t day) const;
+
+  //! Returns the index of the first day after the given day number.
+  std::size_t upper_bound(uint16_t day) const;
+
+  //! Returns the number of bytes allocated for the days.
+  std::size_t memory_usage() const
+  {
+    return records.capacity() * sizeof(Record);
+  }
+
+  //! Returns the number of days since 1970-01-01, or nothing if it does not fit in 16 bits.
+  static std::optional<uint16_t> day_number(const struct tm &date);
+  static std::optional<uint16_t> day_number(int year, int month, int day);
+
+  //! Returns the date of a day number.
+  static void civil_date(uint16_t day, int &year, int &month, int &mday);
+
+private:
+  static std::optional<Record> pack(const DailyStats &day);
+
+private:
+  std::vector<Record> records;
+};
+
+#endif // DAILYSTATSARENA_HH
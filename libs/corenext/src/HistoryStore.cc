@@ -0,0 +1,301 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "HistoryStore.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include "debug.hh"
+
+using namespace workrave;
+
+namespace
+{
+  constexpr char HISTORY_MAGIC[4] = {'W', 'R', 'H', 'S'};
+  constexpr uint32_t HISTORY_VERSION = 1;
+
+  struct Header
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t break_count;
+    uint32_t break_value_count;
+    uint32_t misc_count;
+  };
+
+  //! Times are stored as mday, mon, year, hour, min, like the text format.
+  struct DayRecord
+  {
+    int32_t start[5];
+    int32_t stop[5];
+    int32_t break_stats[BREAK_ID_SIZEOF][IStatistics::STATS_BREAKVALUE_SIZEOF];
+    int32_t reserved;
+    int64_t misc_stats[IStatistics::STATS_VALUE_SIZEOF];
+  };
+
+  Header make_header()
+  {
+    Header header{};
+    std::memcpy(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC));
+    header.version = HISTORY_VERSION;
+    header.record_size = sizeof(DayRecord);
+    header.break_count = BREAK_ID_SIZEOF;
+    header.break_value_count = IStatistics::STATS_BREAKVALUE_SIZEOF;
+    header.misc_count = IStatistics::STATS_VALUE_SIZEOF;
+    return header;
+  }
+
+  void to_fields(const struct tm &t, int32_t *fields)
+  {
+    fields[0] = t.tm_mday;
+    fields[1] = t.tm_mon;
+    fields[2] = t.tm_year;
+    fields[3] = t.tm_hour;
+    fields[4] = t.tm_min;
+  }
+
+  void from_fields(const int32_t *fields, struct tm &t)
+  {
+    t.tm_mday = fields[0];
+    t.tm_mon = fields[1];
+    t.tm_year = fields[2];
+    t.tm_hour = fields[3];
+    t.tm_min = fields[4];
+  }
+
+  DayRecord to_record(const IStatistics::DailyStats &day)
+  {
+    DayRecord record{};
+    to_fields(day.start, record.start);
+    to_fields(day.stop, record.stop);
+    for (int b = 0; b < BREAK_ID_SIZEOF; b++)
+      {
+        std::copy(std::begin(day.break_stats[b]), std::end(day.break_stats[b]), record.break_stats[b]);
+      }
+    std::copy(std::begin(day.misc_stats), std::end(day.misc_stats), record.misc_stats);
+    return record;
+  }
+
+  void from_record(const DayRecord &record, IStatistics::DailyStats &day)
+  {
+    std::memset((void *)&day, 0, sizeof(day));
+    from_fields(record.start, day.start);
+    from_fields(record.stop, day.stop);
+    for (int b = 0; b < BREAK_ID_SIZEOF; b++)
+      {
+        std::copy(std::begin(record.break_stats[b]), std::end(record.break_stats[b]), day.break_stats[b]);
+      }
+    std::copy(std::begin(record.misc_stats), std::end(record.misc_stats), day.misc_stats);
+  }
+} // namespace
+
+HistoryStore::HistoryStore(std::filesystem::path path)
+  : path(std::move(path))
+{
+}
+
+bool
+HistoryStore::exists() const
+{
+  return std::filesystem::is_regular_file(path);
+}
+
+bool
+HistoryStore::is_history_store(const std::filesystem::path &path)
+{
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(HISTORY_MAGIC)] = {};
+  return file.read(magic, sizeof(magic)) && std::memcmp(magic, HISTORY_MAGIC, sizeof(magic)) == 0;
+}
+
+bool
+HistoryStore::read(const std::function<bool(const DailyStats &)> &func) const
+{
+  TRACE_ENTRY();
+  std::ifstream file(path, std::ios::binary);
+
+  Header header{};
+  Header expected = make_header();
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(&header, &expected, sizeof(header)) != 0)
+    {
+      TRACE_MSG("Incompatible history {}", path.string());
+      return false;
+    }
+
+  // A record that was only partially written is ignored.
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  std::size_t count = ec ? 0 : (size - sizeof(Header)) / sizeof(DayRecord);
+
+  constexpr std::size_t block_size = 256;
+  std::vector<DayRecord> records(std::min(count, block_size));
+  DailyStats day{};
+  for (std::size_t done = 0; done < count;)
+    {
+      std::size_t n = std::min(count - done, block_size);
+      if (!file.read(reinterpret_cast<char *>(records.data()), static_cast<std::streamsize>(n * sizeof(DayRecord))))
+        {
+          return false;
+        }
+
+      for (std::size_t i = 0; i < n; i++)
+        {
+          from_record(records[i], day);
+          if (!func(day))
+            {
+              return true;
+            }
+        }
+      done += n;
+    }
+  return true;
+}
+
+bool
+HistoryStore::load(std::vector<DailyStats> &days) const
+{
+  TRACE_ENTRY();
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  days.clear();
+  days.reserve(ec || size < sizeof(Header) ? 0 : (size - sizeof(Header)) / sizeof(DayRecord));
+
+  if (!read([&days](const DailyStats &day) {
+        days.push_back(day);
+        return true;
+      }))
+    {
+      return false;
+    }
+
+  // Records are appended in date order, unless the clock was changed.
+  auto by_date = [](const DailyStats &a, const DailyStats &b) { return date_key(a.start) < date_key(b.start); };
+  if (!std::is_sorted(days.begin(), days.end(), by_date))
+    {
+      std::stable_sort(days.begin(), days.end(), by_date);
+    }
+
+  // Keep the last record of each date.
+  auto same_date = [](const DailyStats &a, const DailyStats &b) { return date_key(a.start) == date_key(b.start); };
+  std::reverse(days.begin(), days.end());
+  days.erase(std::unique(days.begin(), days.end(), same_date), days.end());
+  std::reverse(days.begin(), days.end());
+  return true;
+}
+
+bool
+HistoryStore::append(const DailyStats &day)
+{
+  TRACE_ENTRY();
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+
+  if (ec || size < sizeof(Header))
+    {
+      return write({&day});
+    }
+
+  std::size_t misaligned = (size - sizeof(Header)) % sizeof(DayRecord);
+  if (misaligned != 0)
+    {
+      // Drop an interrupted append.
+      std::filesystem::resize_file(path, size - misaligned, ec);
+      if (ec)
+        {
+          return false;
+        }
+    }
+
+  std::ofstream file(path, std::ios::binary | std::ios::app);
+  DayRecord record = to_record(day);
+  file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+  file.close();
+  return file.good();
+}
+
+bool
+HistoryStore::write(const std::vector<const DailyStats *> &days)
+{
+  TRACE_ENTRY();
+  std::filesystem::path tmp_path = path;
+  tmp_path += ".tmp";
+
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    Header header = make_header();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<DayRecord> records;
+    records.reserve(days.size());
+    for (const auto *day: days)
+      {
+        records.push_back(to_record(*day));
+      }
+    file.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(DayRecord)));
+    file.close();
+
+    if (!file.good())
+      {
+        return false;
+      }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+bool
+HistoryStore::remove()
+{
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  return !ec;
+}
+
+bool
+HistoryStore::move_aside(std::filesystem::path &moved_to)
+{
+  moved_to = path;
+  moved_to += ".corrupt";
+  std::error_code ec;
+  std::filesystem::rename(path, moved_to, ec);
+  return !ec;
+}
+
+int
+HistoryStore::date_key(const struct tm &date)
+{
+  return date_key(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday);
+}
+
+int
+HistoryStore::date_key(int year, int month, int day)
+{
+  return year * 10000 + month * 100 + day;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef HISTORYSTORE_HH
+#define HISTORYSTORE_HH
+
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include "core/IStatistics.hh"
+
+//! Append-only binary store of the daily statistics history.
+/*!
+ *  Days are stored as fixed-size records. A day that is stored again
+ *  replaces the earlier record of the same date when the history is loaded.
+ */
+class HistoryStore
+{
+public:
+  using DailyStats = workrave::IStatistics::DailyStats;
+
+  explicit HistoryStore(std::filesystem::path path);
+
+  //! Returns true if the store exists.
+  bool exists() const;
+
+  //! Loads all days, sorted by date and with one record per date.
+  bool load(std::vector<DailyStats> &days) const;
+
+  //! Calls func for each record in file order, until it returns false.
+  /*!
+   *  Records are read in blocks, so the store is never fully in memory.
+   *  Records are not sorted and dates may repeat.
+   */
+  bool read(const std::function<bool(const DailyStats &)> &func) const;
+
+  //! Returns true if the file starts like a history store.
+  static bool is_history_store(const std::filesystem::path &path);
+
+  //! Appends a day to the store, creating it if needed.
+  bool append(const DailyStats &day);
+
+  //! Replaces the store with the given days.
+  bool write(const std::vector<const DailyStats *> &days);
+
+  //! Removes the store.
+  bool remove();
+
+  //! Renames a store that failed to load, so that it is kept but no longer used.
+  bool move_aside(std::filesystem::path &moved_to);
+
+  //! Returns the sort key of a date: yyyymmdd.
+  static int date_key(const struct tm &date);
+  static int date_key(int year, int month, int day);
+
+private:
+  std::filesystem::path path;
+};
+
+#endif // HISTORYSTORE_HH
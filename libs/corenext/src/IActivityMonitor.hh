@@ -18,6 +18,8 @@
 #ifndef IACTIVITYMONITOR_HH
 #define IACTIVITYMONITOR_HH
 
+#include <boost/signals2.hpp>
+
 #include "config/Config.hh"
 
 class IActivityMonitorListener
@@ -46,6 +48,9 @@ public:
   virtual void force_idle() = 0;
   virtual bool is_active() = 0;
   virtual void set_listener(IActivityMonitorListener::Ptr l) = 0;
+
+  // Notification that the activity state changed. May be emitted from the input monitor thread.
+  virtual boost::signals2::signal<void()> &signal_activity_changed() = 0;
 };
 
 #endif // IACTIVITYMONITOR_HH
@@ -0,0 +1,329 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "IntradaySeries.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <system_error>
+
+using namespace workrave;
+
+namespace
+{
+  constexpr char SERIES_MAGIC[4] = {'W', 'R', 'I', 'S'};
+  constexpr uint32_t SERIES_VERSION = 1;
+
+  //! Upper bound of the encoded size: at most 16 bytes per minute.
+  constexpr uint32_t SERIES_MAX_SIZE = IntradaySeries::MINUTES_PER_DAY * 16;
+
+  //! Skips of this many minutes or more are followed by a varint with the remainder.
+  constexpr int SKIP_ESCAPE = 15;
+
+  struct Header
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t day;
+    uint32_t size;
+  };
+
+  template<typename T>
+  void saturating_add(T &counter, int64_t value)
+  {
+    counter = static_cast<T>(std::min<int64_t>(counter + value, std::numeric_limits<T>::max()));
+  }
+
+  void put_varint(std::vector<uint8_t> &out, uint64_t value)
+  {
+    while (value >= 0x80)
+      {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+      }
+    out.push_back(static_cast<uint8_t>(value));
+  }
+
+  void put_delta(std::vector<uint8_t> &out, int64_t value, int64_t previous)
+  {
+    int64_t delta = value - previous;
+    put_varint(out, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+  }
+
+  bool get_varint(std::span<const uint8_t> &in, uint64_t &value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64 && !in.empty(); shift += 7)
+      {
+        uint8_t byte = in.front();
+        in = in.subspan(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+  bool get_delta(std::span<const uint8_t> &in, int64_t &value)
+  {
+    uint64_t zigzag = 0;
+    if (!get_varint(in, zigzag))
+      {
+        return false;
+      }
+    value += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    return true;
+  }
+
+  template<typename T>
+  bool fits(int64_t value)
+  {
+    return value >= 0 && value <= std::numeric_limits<T>::max();
+  }
+} // namespace
+
+void
+IntradaySeries::clear()
+{
+  active_seconds.fill(0);
+  keystrokes.fill(0);
+  clicks.fill(0);
+  movement.fill(0);
+  last_active_second = -1;
+}
+
+int
+IntradaySeries::minute_of(int second)
+{
+  return std::clamp(second, 0, SECONDS_PER_DAY - 1) / 60;
+}
+
+void
+IntradaySeries::add_activity(int second)
+{
+  if (second != last_active_second)
+    {
+      last_active_second = second;
+      saturating_add(active_seconds[minute_of(second)], 1);
+    }
+}
+
+void
+IntradaySeries::add_keystroke(int second)
+{
+  saturating_add(keystrokes[minute_of(second)], 1);
+}
+
+void
+IntradaySeries::add_click(int second)
+{
+  saturating_add(clicks[minute_of(second)], 1);
+}
+
+void
+IntradaySeries::add_movement(int second, int64_t distance)
+{
+  if (distance > 0)
+    {
+      saturating_add(movement[minute_of(second)], distance);
+    }
+}
+
+IntradaySeries::Samples
+IntradaySeries::get_samples() const
+{
+  Samples samples;
+  for (int m = 0; m < MINUTES_PER_DAY; m++)
+    {
+      if (active_seconds[m] != 0 || keystrokes[m] != 0 || clicks[m] != 0 || movement[m] != 0)
+        {
+          samples.push_back(Sample{m, active_seconds[m], keystrokes[m], clicks[m], movement[m]});
+        }
+    }
+  return samples;
+}
+
+std::array<int64_t, IntradaySeries::CHANNEL_COUNT>
+IntradaySeries::get_values(int minute) const
+{
+  return {active_seconds[minute], keystrokes[minute], clicks[minute], movement[minute]};
+}
+
+bool
+IntradaySeries::set_values(int minute, const std::array<int64_t, CHANNEL_COUNT> &values)
+{
+  if (!fits<uint8_t>(values[0]) || !fits<uint16_t>(values[1]) || !fits<uint16_t>(values[2]) || !fits<uint32_t>(values[3]))
+    {
+      return false;
+    }
+  active_seconds[minute] = static_cast<uint8_t>(values[0]);
+  keystrokes[minute] = static_cast<uint16_t>(values[1]);
+  clicks[minute] = static_cast<uint16_t>(values[2]);
+  movement[minute] = static_cast<uint32_t>(values[3]);
+  return true;
+}
+
+std::vector<uint8_t>
+IntradaySeries::encode() const
+{
+  std::vector<uint8_t> out;
+  std::array<int64_t, CHANNEL_COUNT> previous{};
+  int previous_minute = -1;
+  for (int m = 0; m < MINUTES_PER_DAY; m++)
+    {
+      auto values = get_values(m);
+      if (values == std::array<int64_t, CHANNEL_COUNT>{})
+        {
+          continue;
+        }
+
+      uint8_t changed = 0;
+      for (int c = 0; c < CHANNEL_COUNT; c++)
+        {
+          changed |= (values[c] != previous[c]) ? (1 << c) : 0;
+        }
+
+      int skip = m - previous_minute - 1;
+      out.push_back(static_cast<uint8_t>((std::min(skip, SKIP_ESCAPE) << CHANNEL_COUNT) | changed));
+      if (skip >= SKIP_ESCAPE)
+        {
+          put_varint(out, skip - SKIP_ESCAPE);
+        }
+
+      for (int c = 0; c < CHANNEL_COUNT; c++)
+        {
+          if ((changed & (1 << c)) != 0)
+            {
+              put_delta(out, values[c], previous[c]);
+            }
+        }
+
+      previous = values;
+      previous_minute = m;
+    }
+  return out;
+}
+
+bool
+IntradaySeries::decode(std::span<const uint8_t> data)
+{
+  clear();
+
+  std::array<int64_t, CHANNEL_COUNT> values{};
+  int minute = -1;
+  while (!data.empty())
+    {
+      uint8_t control = data.front();
+      data = data.subspan(1);
+
+      uint64_t skip = control >> CHANNEL_COUNT;
+      if (skip == SKIP_ESCAPE)
+        {
+          uint64_t extra = 0;
+          if (!get_varint(data, extra) || extra >= MINUTES_PER_DAY)
+            {
+              clear();
+              return false;
+            }
+          skip += extra;
+        }
+
+      minute += static_cast<int>(skip) + 1;
+      if (minute >= MINUTES_PER_DAY)
+        {
+          clear();
+          return false;
+        }
+
+      for (int c = 0; c < CHANNEL_COUNT; c++)
+        {
+          if ((control & (1 << c)) != 0 && !get_delta(data, values[c]))
+            {
+              clear();
+              return false;
+            }
+        }
+
+      if (!set_values(minute, values))
+        {
+          clear();
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+IntradaySeries::save(const std::filesystem::path &path, uint16_t day) const
+{
+  std::vector<uint8_t> data = encode();
+
+  Header header{};
+  std::memcpy(header.magic, SERIES_MAGIC, sizeof(SERIES_MAGIC));
+  header.version = SERIES_VERSION;
+  header.day = day;
+  header.size = static_cast<uint32_t>(data.size());
+
+  std::filesystem::path tmp_path = path;
+  tmp_path += ".tmp";
+
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.close();
+
+    if (!file.good())
+      {
+        return false;
+      }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+bool
+IntradaySeries::load(const std::filesystem::path &path, uint16_t day)
+{
+  clear();
+
+  std::ifstream file(path, std::ios::binary);
+  Header header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(header.magic, SERIES_MAGIC, sizeof(SERIES_MAGIC)) != 0
+      || header.version != SERIES_VERSION || header.day != day || header.size > SERIES_MAX_SIZE)
+    {
+      return false;
+    }
+
+  std::vector<uint8_t> data(header.size);
+  if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())))
+    {
+      return false;
+    }
+  return decode(data);
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef INTRADAYSERIES_HH
+#define INTRADAYSERIES_HH
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "core/IStatistics.hh"
+
+//! Activity per minute of a single day.
+/*!
+ *  Each minute of the day has a fixed slot, so recording is a plain array
+ *  update and memory use does not grow during the day. Counters saturate.
+ *
+ *  The encoded form only contains the minutes with activity. Each starts
+ *  with a byte holding the number of minutes skipped since the previous one
+ *  and a bit per value that changed, followed by the differences of those
+ *  values as zigzag varints. Neighbouring minutes tend to be alike, so most
+ *  minutes take only a few bytes.
+ */
+class IntradaySeries
+{
+public:
+  using Sample = workrave::IStatistics::IntradaySample;
+  using Samples = workrave::IStatistics::IntradaySamples;
+
+  static constexpr int MINUTES_PER_DAY = 24 * 60;
+  static constexpr int SECONDS_PER_DAY = MINUTES_PER_DAY * 60;
+
+  void clear();
+
+  //! Records input during the given second since midnight.
+  /*! Only the first input of each second is counted, so input must be recorded in order. */
+  void add_activity(int second);
+
+  void add_keystroke(int second);
+  void add_click(int second);
+  void add_movement(int second, int64_t distance);
+
+  //! Returns the minutes with activity.
+  Samples get_samples() const;
+
+  std::vector<uint8_t> encode() const;
+  bool decode(std::span<const uint8_t> data);
+
+  //! Saves the series of the given day (days since 1970-01-01).
+  bool save(const std::filesystem::path &path, uint16_t day) const;
+
+  //! Loads the series, if it was saved for the given day.
+  bool load(const std::filesystem::path &path, uint16_t day);
+
+private:
+  static constexpr int CHANNEL_COUNT = 4;
+
+  static int minute_of(int second);
+  std::array<int64_t, CHANNEL_COUNT> get_values(int minute) const;
+  bool set_values(int minute, const std::array<int64_t, CHANNEL_COUNT> &values);
+
+private:
+  std::array<uint8_t, MINUTES_PER_DAY> active_seconds{};
+  std::array<uint16_t, MINUTES_PER_DAY> keystrokes{};
+  std::array<uint16_t, MINUTES_PER_DAY> clicks{};
+  std::array<uint32_t, MINUTES_PER_DAY> movement{};
+
+  //! Last second for which input was recorded.
+  int last_active_second{-1};
+};
+
+#endif // INTRADAYSERIES_HH
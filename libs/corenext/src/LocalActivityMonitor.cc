@@ -23,6 +23,8 @@
 #include "LocalActivityMonitor.hh"
 
 #include <cassert>
+#include <chrono>
+#include <cstdlib>
 #include <cmath>
 #include <cstddef>
 #include <utility>
@@ -31,6 +33,7 @@
 #include "input-monitor/InputMonitorFactory.hh"
 
 #include "core/CoreConfig.hh"
+#include "utils/Diagnostics.hh"
 #include "debug.hh"
 
 using namespace std;
@@ -38,6 +41,9 @@ using namespace workrave::config;
 using namespace workrave::input_monitor;
 using namespace workrave::utils;
 
+//! Activity detection only needs to know whether there was input recently.
+static constexpr std::chrono::milliseconds ACTIVITY_NOTIFY_INTERVAL{250};
+
 LocalActivityMonitor::LocalActivityMonitor(IConfigurator::Ptr config, const char *display_name)
   : config(std::move(config))
   , display_name(display_name)
@@ -58,7 +64,19 @@ LocalActivityMonitor::init()
   input_monitor = InputMonitorFactory::create_monitor(MonitorCapability::Activity);
   if (input_monitor != nullptr)
     {
-      input_monitor->subscribe(this);
+      input_monitor->subscribe(this, InputInterest::All, ACTIVITY_NOTIFY_INTERVAL);
+
+      Diagnostics::instance().register_topic("monitor.input.notifications", [this]() {
+        InputEventCounters counters = input_monitor->get_event_counters();
+        Diagnostics::instance().report("monitor.input.notified", counters.notified);
+        Diagnostics::instance().report("monitor.input.suppressed", counters.suppressed);
+      });
+
+      if (const char *trace = std::getenv("WORKRAVE_INPUT_TRACE"); trace != nullptr)
+        {
+          recorder = std::make_unique<InputEventRecorder>(trace);
+          input_monitor->subscribe(recorder.get());
+        }
     }
 }
 
@@ -69,7 +87,14 @@ LocalActivityMonitor::terminate()
   TRACE_ENTRY();
   if (input_monitor != nullptr)
     {
+      Diagnostics::instance().unregister_topic("monitor.input.notifications");
       input_monitor->terminate();
+
+      if (recorder != nullptr)
+        {
+          input_monitor->unsubscribe(recorder.get());
+          recorder.reset();
+        }
     }
 }
 
@@ -173,12 +198,19 @@ LocalActivityMonitor::set_listener(IActivityMonitorListener::Ptr l)
   lock.unlock();
 }
 
+boost::signals2::signal<void()> &
+LocalActivityMonitor::signal_activity_changed()
+{
+  return activity_changed_signal;
+}
+
 //! Activity is reported by the input monitor.
 void
 LocalActivityMonitor::action_notify()
 {
   lock.lock();
   int64_t now = TimeSource::get_monotonic_time_usec();
+  LocalActivityMonitorState previous_state = state;
 
   switch (state)
     {
@@ -223,7 +255,13 @@ LocalActivityMonitor::action_notify()
     }
 
   last_action_time = now;
+  bool state_changed = state != previous_state;
   lock.unlock();
+
+  if (state_changed)
+    {
+      activity_changed_signal();
+    }
   call_listener();
 }
 
@@ -28,6 +28,7 @@
 #include "utils/Signals.hh"
 #include "input-monitor/IInputMonitor.hh"
 #include "input-monitor/IInputMonitorListener.hh"
+#include "input-monitor/InputEventTrace.hh"
 
 class LocalActivityMonitor
   : public IActivityMonitor
@@ -45,6 +46,7 @@ public:
   void force_idle() override;
   bool is_active() override;
   void set_listener(IActivityMonitorListener::Ptr l) override;
+  boost::signals2::signal<void()> &signal_activity_changed() override;
 
   // IInputMonitorListener
   void action_notify() override;
@@ -81,6 +83,9 @@ private:
   //! The actual monitoring driver.
   workrave::input_monitor::IInputMonitor::Ptr input_monitor;
 
+  //! Records the input events if WORKRAVE_INPUT_TRACE names a trace file.
+  std::unique_ptr<workrave::input_monitor::InputEventRecorder> recorder;
+
   //! the current state.
   LocalActivityMonitorState state{ACTIVITY_MONITOR_IDLE};
 
@@ -116,6 +121,9 @@ private:
 
   //! Activity listener.
   IActivityMonitorListener::Ptr listener;
+
+  //! Activity state changed notification.
+  boost::signals2::signal<void()> activity_changed_signal;
 };
 
 #endif // LOCALACTIVITYMONITOR_HH
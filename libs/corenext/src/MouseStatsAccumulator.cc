@@ -0,0 +1,305 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "MouseStatsAccumulator.hh"
+
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define HAVE_MOUSE_STATS_SSE2
+#  include <emmintrin.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define HAVE_MOUSE_STATS_AVX2
+#  include <immintrin.h>
+#endif
+
+using namespace workrave::input_monitor;
+
+namespace
+{
+  // The kernels compute the distance moved by 'count' samples. 'x' and 'y'
+  // contain count + 1 positions: element 0 is the position before the first
+  // sample. 'distance' receives the distance of each sample, or -1 if the
+  // sample is ignored. All arithmetic is exact up to the final sqrt, so all
+  // kernels produce the same results.
+
+  void
+  distance_scalar(const int32_t *x, const int32_t *y, const int32_t *wheel, int32_t *distance, std::size_t start, std::size_t count)
+  {
+    for (std::size_t i = start; i < count; i++)
+      {
+        int delta_x = std::abs(x[i + 1] - x[i]);
+        int delta_y = std::abs(y[i + 1] - y[i]);
+
+        if (delta_x < MouseStatsAccumulator::MAX_JUMP && delta_y < MouseStatsAccumulator::MAX_JUMP
+            && (delta_x >= MouseStatsAccumulator::SENSITIVITY || delta_y >= MouseStatsAccumulator::SENSITIVITY || wheel[i] != 0))
+          {
+            distance[i] = int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
+          }
+        else
+          {
+            distance[i] = -1;
+          }
+      }
+  }
+
+#if defined(HAVE_MOUSE_STATS_SSE2)
+  void
+  distance_sse2(const int32_t *x, const int32_t *y, const int32_t *wheel, int32_t *distance, std::size_t count)
+  {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d ignored = _mm_set1_pd(-1.0);
+    const __m128d max_jump = _mm_set1_pd(MouseStatsAccumulator::MAX_JUMP);
+    const __m128d sensitivity = _mm_set1_pd(MouseStatsAccumulator::SENSITIVITY);
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+      {
+        __m128d x0 = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x + i)));
+        __m128d x1 = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x + i + 1)));
+        __m128d y0 = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + i)));
+        __m128d y1 = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(y + i + 1)));
+        __m128d w = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(wheel + i)));
+
+        __m128d dx = _mm_andnot_pd(sign, _mm_sub_pd(x1, x0));
+        __m128d dy = _mm_andnot_pd(sign, _mm_sub_pd(y1, y0));
+
+        __m128d in_range = _mm_and_pd(_mm_cmplt_pd(dx, max_jump), _mm_cmplt_pd(dy, max_jump));
+        __m128d moved = _mm_or_pd(_mm_or_pd(_mm_cmpge_pd(dx, sensitivity), _mm_cmpge_pd(dy, sensitivity)), _mm_cmpneq_pd(w, zero));
+        __m128d accept = _mm_and_pd(in_range, moved);
+
+        __m128d dist = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        dist = _mm_or_pd(_mm_and_pd(accept, dist), _mm_andnot_pd(accept, ignored));
+
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(distance + i), _mm_cvttpd_epi32(dist));
+      }
+
+    distance_scalar(x, y, wheel, distance, i, count);
+  }
+#endif
+
+#if defined(HAVE_MOUSE_STATS_AVX2)
+  __attribute__((target("avx2"))) void
+  distance_avx2(const int32_t *x, const int32_t *y, const int32_t *wheel, int32_t *distance, std::size_t count)
+  {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i ignored = _mm256_set1_epi32(-1);
+    const __m256i max_jump = _mm256_set1_epi32(MouseStatsAccumulator::MAX_JUMP);
+    const __m256i min_move = _mm256_set1_epi32(MouseStatsAccumulator::SENSITIVITY - 1);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+      {
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i + 1));
+        __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + i));
+        __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(y + i + 1));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(wheel + i));
+
+        __m256i dx = _mm256_abs_epi32(_mm256_sub_epi32(x1, x0));
+        __m256i dy = _mm256_abs_epi32(_mm256_sub_epi32(y1, y0));
+
+        __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi32(max_jump, dx), _mm256_cmpgt_epi32(max_jump, dy));
+        __m256i moved = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(dx, min_move), _mm256_cmpgt_epi32(dy, min_move)),
+                                        _mm256_xor_si256(_mm256_cmpeq_epi32(w, zero), ignored));
+        __m256i accept = _mm256_and_si256(in_range, moved);
+
+        // dx^2 + dy^2 < 2^28 for accepted samples. The single precision
+        // estimate of its square root is at most one off, which is corrected
+        // with exact integer arithmetic.
+        __m256i n = _mm256_add_epi32(_mm256_mullo_epi32(dx, dx), _mm256_mullo_epi32(dy, dy));
+        __m256i r = _mm256_cvttps_epi32(_mm256_sqrt_ps(_mm256_cvtepi32_ps(n)));
+        r = _mm256_add_epi32(r, _mm256_cmpgt_epi32(_mm256_mullo_epi32(r, r), n));
+        __m256i r1 = _mm256_add_epi32(r, one);
+        r = _mm256_sub_epi32(r, _mm256_xor_si256(_mm256_cmpgt_epi32(_mm256_mullo_epi32(r1, r1), n), ignored));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(distance + i), _mm256_blendv_epi8(ignored, r, accept));
+      }
+
+    distance_scalar(x, y, wheel, distance, i, count);
+  }
+#endif
+} // namespace
+
+MouseStatsAccumulator::Kernel
+MouseStatsAccumulator::get_best_kernel()
+{
+#if defined(HAVE_MOUSE_STATS_AVX2)
+  if (__builtin_cpu_supports("avx2"))
+    {
+      return Kernel::AVX2;
+    }
+#endif
+#if defined(HAVE_MOUSE_STATS_SSE2)
+  return Kernel::SSE2;
+#else
+  return Kernel::Scalar;
+#endif
+}
+
+void
+MouseStatsAccumulator::set_kernel(Kernel kernel)
+{
+  Kernel best = get_best_kernel();
+  this->kernel = (kernel > best) ? best : kernel;
+}
+
+MouseStatsAccumulator::Kernel
+MouseStatsAccumulator::get_kernel() const
+{
+  return kernel;
+}
+
+void
+MouseStatsAccumulator::add(std::span<const InputEvent> events)
+{
+  int32_t x[CHUNK_SIZE + 1];
+  int32_t y[CHUNK_SIZE + 1];
+  int32_t wheel[CHUNK_SIZE];
+  int64_t time[CHUNK_SIZE];
+  std::size_t count = 0;
+
+  // Without a previous position, the first sample counts as a minimal movement.
+  bool have_prev = prev_x != -1 && prev_y != -1;
+
+  for (const auto &event: events)
+    {
+      if (event.type != InputEventType::Mouse || event.x < 0 || event.y < 0)
+        {
+          continue;
+        }
+
+      if (count == 0)
+        {
+          x[0] = have_prev ? prev_x : event.x - SENSITIVITY;
+          y[0] = have_prev ? prev_y : event.y - SENSITIVITY;
+        }
+
+      x[count + 1] = event.x;
+      y[count + 1] = event.y;
+      wheel[count] = event.wheel;
+      time[count] = event.time_usec;
+      count++;
+
+      if (count == CHUNK_SIZE)
+        {
+          process_chunk(x, y, wheel, time, count);
+          prev_x = x[count];
+          prev_y = y[count];
+          have_prev = true;
+          count = 0;
+        }
+    }
+
+  if (count > 0)
+    {
+      process_chunk(x, y, wheel, time, count);
+      prev_x = x[count];
+      prev_y = y[count];
+    }
+}
+
+void
+MouseStatsAccumulator::process_chunk(const int32_t *x, const int32_t *y, const int32_t *wheel, const int64_t *time, std::size_t count)
+{
+  int32_t distance[CHUNK_SIZE];
+
+  switch (kernel)
+    {
+#if defined(HAVE_MOUSE_STATS_AVX2)
+    case Kernel::AVX2:
+      distance_avx2(x, y, wheel, distance, count);
+      break;
+#endif
+#if defined(HAVE_MOUSE_STATS_SSE2)
+    case Kernel::SSE2:
+      distance_sse2(x, y, wheel, distance, count);
+      break;
+#endif
+    default:
+      distance_scalar(x, y, wheel, distance, 0, count);
+      break;
+    }
+
+  // Branch-free, most samples are accepted. Locals avoid reloading the
+  // members, which may alias the arrays.
+  int64_t chunk_movement = 0;
+  int64_t chunk_movement_time = 0;
+  int64_t last_time = last_mouse_time;
+  bool time_valid = false;
+
+  for (std::size_t i = 0; i < count; i++)
+    {
+      bool accepted = distance[i] >= 0;
+      int64_t tv = time[i] - last_time;
+      bool counted = accepted && tv < MAX_MOVEMENT_INTERVAL;
+
+      chunk_movement += accepted ? distance[i] : 0;
+      chunk_movement_time += counted ? tv : 0;
+      time_valid |= counted;
+      last_time = accepted ? time[i] : last_time;
+    }
+
+  movement += chunk_movement;
+  movement_time += chunk_movement_time;
+  movement_time_valid |= time_valid;
+  last_mouse_time = last_time;
+}
+
+int64_t
+MouseStatsAccumulator::take_movement()
+{
+  int64_t ret = movement;
+  movement = 0;
+  return ret;
+}
+
+int64_t
+MouseStatsAccumulator::take_movement_time()
+{
+  int64_t ret = movement_time;
+  movement_time = 0;
+  movement_time_valid = false;
+  return ret;
+}
+
+bool
+MouseStatsAccumulator::has_movement_time() const
+{
+  return movement_time_valid;
+}
+
+int
+MouseStatsAccumulator::get_prev_x() const
+{
+  return prev_x;
+}
+
+int
+MouseStatsAccumulator::get_prev_y() const
+{
+  return prev_y;
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef MOUSESTATSACCUMULATOR_HH
+#define MOUSESTATSACCUMULATOR_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "input-monitor/InputEvent.hh"
+
+//! Accumulates mouse movement distance and movement time from batches of mouse events.
+/*!
+ *  The distance of each motion sample is computed by a vectorized kernel
+ *  (AVX2 or SSE2 when available) on fixed-size chunks on the stack. The
+ *  results are identical to processing the events one by one.
+ */
+class MouseStatsAccumulator
+{
+public:
+  enum class Kernel
+  {
+    Scalar,
+    SSE2,
+    AVX2,
+  };
+
+  //! Movements smaller than this (in pixels) are ignored, unless the wheel moved.
+  static constexpr int SENSITIVITY = 3;
+
+  //! Movements of this size or more (in pixels) are ignored.
+  static constexpr int MAX_JUMP = 10000;
+
+  //! Movement times of this size or more (in microseconds) are not counted as movement time.
+  static constexpr int64_t MAX_MOVEMENT_INTERVAL = 1000000;
+
+  //! Processes mouse events. Events of other types are ignored.
+  void add(std::span<const workrave::input_monitor::InputEvent> events);
+
+  //! Returns and clears the distance moved since the last call.
+  int64_t take_movement();
+
+  //! Returns and clears the movement time (in microseconds) since the last call.
+  int64_t take_movement_time();
+
+  //! Returns true if movement time was accumulated since the last take_movement_time().
+  bool has_movement_time() const;
+
+  //! Last reported pointer position, -1 if unknown.
+  int get_prev_x() const;
+  int get_prev_y() const;
+
+  //! Returns the best kernel supported by this CPU.
+  static Kernel get_best_kernel();
+
+  //! Selects the kernel to use. Unsupported kernels fall back to the best supported kernel.
+  void set_kernel(Kernel kernel);
+  Kernel get_kernel() const;
+
+private:
+  static constexpr std::size_t CHUNK_SIZE = 256;
+
+  void process_chunk(const int32_t *x, const int32_t *y, const int32_t *wheel, const int64_t *time, std::size_t count);
+
+private:
+  Kernel kernel{get_best_kernel()};
+  int prev_x{-1};
+  int prev_y{-1};
+  int64_t last_mouse_time{0};
+  int64_t movement{0};
+  int64_t movement_time{0};
+  bool movement_time_valid{false};
+};
+
+#endif // MOUSESTATSACCUMULATOR_HH
@@ -27,14 +27,20 @@
 #  include "MacOSHelpers.hh"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <cassert>
 #include <cmath>
+#include <limits>
+
+#include <spdlog/spdlog.h>
 
 #include "debug.hh"
 
 #include "utils/Paths.hh"
+#include "utils/TimeSource.hh"
+#include "StatisticsReader.hh"
 #include "Timer.hh"
 #include "input-monitor/InputMonitorFactory.hh"
 #include "input-monitor/IInputMonitor.hh"
@@ -42,19 +48,87 @@
 static const char *WORKRAVESTATS = "WorkRaveStats";
 static const int STATSVERSION = 4;
 
-#define MAX_JUMP (10000)
+//! Pointer motion is sampled at 100 Hz, finer than the movement statistics need.
+static constexpr std::chrono::milliseconds MOTION_INTERVAL{10};
 
 using namespace std;
 using namespace workrave;
 using namespace workrave::utils;
 using namespace workrave::input_monitor;
 
+//! Returns the day number of a query date. Dates outside the range of the history saturate.
+static uint16_t
+get_query_day(int y, int m, int d)
+{
+  std::optional<uint16_t> day = DailyStatsArena::day_number(y, m, d);
+  if (!day)
+    {
+      return y < 1970 ? 0 : std::numeric_limits<uint16_t>::max();
+    }
+  return *day;
+}
+
+static uint16_t
+get_query_day(const struct tm &date)
+{
+  return get_query_day(date.tm_year + 1900, date.tm_mon + 1, date.tm_mday);
+}
+
+//! Returns the first day of the range that contains the day.
+static uint16_t
+get_range_start(IStatistics::StatsRange range, uint16_t day, int week_start)
+{
+  int y = 0;
+  int m = 0;
+  int d = 0;
+  DailyStatsArena::civil_date(day, y, m, d);
+
+  switch (range)
+    {
+    case IStatistics::StatsRange::Week:
+      {
+        // Day 0 is a Thursday.
+        int offset = ((day + 4) % 7 - week_start + 7) % 7;
+        return static_cast<uint16_t>(std::max(0, day - offset));
+      }
+    case IStatistics::StatsRange::Month:
+      return get_query_day(y, m, 1);
+    case IStatistics::StatsRange::Year:
+      return get_query_day(y, 1, 1);
+    case IStatistics::StatsRange::All:
+      break;
+    }
+  return 0;
+}
+
+static uint32_t
+get_rollup_key(IStatistics::StatsRange range, uint16_t start)
+{
+  return (static_cast<uint32_t>(range) << 16) | start;
+}
+
+static void
+accumulate(IStatistics::StatsAggregate &aggregate, const IStatistics::DailyStats &stats, int sign)
+{
+  aggregate.days += sign;
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      for (int j = 0; j < IStatistics::STATS_BREAKVALUE_SIZEOF; j++)
+        {
+          aggregate.break_stats[i][j] += sign * stats.break_stats[i][j];
+        }
+    }
+  for (int j = 0; j < IStatistics::STATS_VALUE_SIZEOF; j++)
+    {
+      aggregate.misc_stats[j] += sign * stats.misc_stats[j];
+    }
+}
+
 Statistics::Statistics(IActivityMonitor::Ptr monitor)
   : monitor(monitor)
   , current_day(nullptr)
   , been_active(false)
-  , prev_x(-1)
-  , prev_y(-1)
+  , history_store(Paths::get_state_directory() / "history.bin")
   , click_x(-1)
   , click_y(-1)
 {
@@ -63,13 +137,13 @@ Statistics::Statistics(IActivityMonitor::Ptr monitor)
 //! Destructor
 Statistics::~Statistics()
 {
-  update();
-
-  for (auto &item: history)
+  if (history_loader.joinable())
     {
-      delete item;
+      history_loader.join();
     }
 
+  update();
+
   delete current_day;
 
   if (input_monitor != nullptr)
@@ -85,7 +159,7 @@ Statistics::init()
   input_monitor = InputMonitorFactory::create_monitor(MonitorCapability::Statistics);
   if (input_monitor != nullptr)
     {
-      input_monitor->subscribe(this);
+      input_monitor->subscribe(this, MOTION_INTERVAL);
     }
 
   current_day = nullptr;
@@ -94,8 +168,6 @@ Statistics::init()
     {
       start_new_day();
     }
-
-  load_history();
 }
 
 //! Periodic heartbeat.
@@ -103,6 +175,7 @@ void
 Statistics::update()
 {
   TRACE_ENTRY();
+  process_input_events();
   if (monitor->is_active())
     {
       const time_t now = time(nullptr);
@@ -122,22 +195,24 @@ bool
 Statistics::delete_all_history()
 {
   update();
+  wait_for_history();
 
-  std::filesystem::path histpath = Paths::get_state_directory() / "historystats";
-  if (std::filesystem::is_regular_file(histpath) && std::filesystem::remove(histpath))
+  std::error_code ec;
+  std::filesystem::remove(Paths::get_state_directory() / "historystats", ec);
+  if (ec || !history_store.remove())
     {
       return false;
     }
 
-  for (auto i = history.begin(); (i != history.end()); ++i)
-    {
-      delete *i;
-    }
+  {
+    std::scoped_lock l(history_lock);
+    history.clear();
+    rollups.clear();
+  }
 
-  history.clear();
-
-  std::filesystem::path todaypath = Paths::get_state_directory() / "todaystats";
-  if (std::filesystem::is_regular_file(todaypath) && std::filesystem::remove(todaypath))
+  std::filesystem::remove(Paths::get_state_directory() / "todaystats", ec);
+  std::filesystem::remove(Paths::get_state_directory() / "todayseries", ec);
+  if (ec)
     {
       return false;
     }
@@ -174,6 +249,11 @@ Statistics::start_new_day()
       current_day = new DailyStatsImpl();
       been_active = false;
 
+      {
+        std::scoped_lock sl(lock);
+        intraday.clear();
+      }
+
       current_day->start = *tmnow;
       current_day->stop = *tmnow;
     }
@@ -185,20 +265,29 @@ Statistics::start_new_day()
 void
 Statistics::day_to_history(DailyStatsImpl *stats)
 {
-  add_history(stats);
-
-  std::filesystem::path path = Paths::get_state_directory() / "historystats";
-
-  bool exists = std::filesystem::is_regular_file(path);
-  ofstream stats_file(path.string(), ios::app);
-
-  if (!exists)
-    {
-      stats_file << WORKRAVESTATS << " " << STATSVERSION << std::endl;
-    }
-
-  save_day(stats, stats_file);
-  stats_file.close();
+  {
+    std::scoped_lock l(history_lock);
+    // Without a store, the loader must convert the text history before the first append.
+    if (history_state == HistoryState::Unloaded && history_store.exists())
+      {
+        // The loader will read the day from the store.
+        if (!history_store.append(*stats))
+          {
+            TRACE_MSG("Failed to append to history");
+          }
+        delete stats;
+        return;
+      }
+  }
+
+  wait_for_history();
+  add_history(*stats);
+
+  if (!history_store.append(*stats))
+    {
+      TRACE_MSG("Failed to append to history");
+    }
+  delete stats;
 }
 
 //! Adds the current day to this history.
@@ -208,9 +297,9 @@ Statistics::day_to_remote_history(DailyStatsImpl *stats)
   (void)stats;
 }
 
-//! Saves the current day to the specified stream.
+//! Saves the day to the specified stream in text format.
 void
-Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
+Statistics::save_day(const DailyStats *stats, ostream &stats_file)
 {
   stats_file << "D " << stats->start.tm_mday << " " << stats->start.tm_mon << " " << stats->start.tm_year << " " << stats->start.tm_hour
              << " " << stats->start.tm_min << " " << stats->stop.tm_mday << " " << stats->stop.tm_mon << " " << stats->stop.tm_year << " "
@@ -218,7 +307,7 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
-      BreakStats &bs = stats->break_stats[i];
+      const BreakStats &bs = stats->break_stats[i];
 
       stats_file << "B " << i << " " << STATS_BREAKVALUE_SIZEOF << " ";
       for (auto &b: bs)
@@ -234,8 +323,6 @@ Statistics::save_day(DailyStatsImpl *stats, ofstream &stats_file)
       stats_file << misc_stat << " ";
     }
   stats_file << endl;
-
-  stats_file.close();
 }
 
 //! Saves the statistics of the specified day.
@@ -248,56 +335,62 @@ Statistics::save_day(DailyStatsImpl *stats)
   stats_file << WORKRAVESTATS << " " << STATSVERSION << endl;
 
   save_day(stats, stats_file);
+  save_intraday(stats);
+}
+
+//! Saves the activity per minute of the specified day, next to its statistics.
+void
+Statistics::save_intraday(DailyStatsImpl *stats)
+{
+  std::scoped_lock sl(lock);
+  if (!intraday.save(Paths::get_state_directory() / "todayseries", get_query_day(stats->start)))
+    {
+      TRACE_MSG("Failed to save intraday series");
+    }
 }
 
 //! Add the stats the the history list.
 void
-Statistics::add_history(DailyStatsImpl *stats)
+Statistics::add_history(const DailyStats &stats)
 {
-  if (history.empty())
+  std::optional<uint16_t> day = DailyStatsArena::day_number(stats.start);
+  if (!day || !DailyStatsArena::day_number(stats.stop))
     {
-      history.push_back(stats);
+      TRACE_MSG("Date out of range");
+      return;
     }
-  else
+
+  std::size_t i = history.lower_bound(*day);
+  if (i < history.size() && history[i].day() == *day)
     {
-      bool found = false;
-      auto i = history.rbegin();
-      while (i != history.rend())
-        {
-          DailyStatsImpl *ref = *i;
+      update_rollups(history[i].to_daily_stats(), -1);
+    }
 
-          if (stats->start.tm_year == ref->start.tm_year && stats->start.tm_mon == ref->start.tm_mon
-              && stats->start.tm_mday == ref->start.tm_mday)
-            {
-              delete *i;
-              *i = stats;
-              found = true;
-              break;
-            }
+  history.insert(stats);
 
-          if (stats->start.tm_year > ref->start.tm_year
-              || (stats->start.tm_year == ref->start.tm_year
-                  && (stats->start.tm_mon > ref->start.tm_mon
-                      || (stats->start.tm_mon == ref->start.tm_mon && stats->start.tm_mday > ref->start.tm_mday))))
-            {
-              if (i == history.rbegin())
-                {
-                  history.push_back(stats);
-                }
-              else
-                {
-                  history.insert(i.base(), stats);
-                }
-              found = true;
-              break;
-            }
-          ++i;
-        }
+  // Use the stored values, counters may have saturated.
+  update_rollups(history[history.lower_bound(*day)].to_daily_stats(), 1);
+}
 
-      if (!found)
-        {
-          history.insert(history.begin(), stats);
-        }
+//! Adds the day to, or with a negative sign removes it from, the rollups.
+void
+Statistics::update_rollups(const DailyStats &stats, int sign)
+{
+  uint16_t day = get_query_day(stats.start);
+  for (auto range: {StatsRange::Week, StatsRange::Month, StatsRange::Year, StatsRange::All})
+    {
+      uint16_t start = get_range_start(range, day, rollup_week_start);
+      accumulate(rollups[get_rollup_key(range, start)], stats, sign);
+    }
+}
+
+void
+Statistics::rebuild_rollups()
+{
+  rollups.clear();
+  for (std::size_t i = 0; i < history.size(); i++)
+    {
+      update_rollups(history[i].to_daily_stats(), 1);
     }
 }
 
@@ -311,6 +404,12 @@ Statistics::load_current_day()
 
   load(stats_file, false);
 
+  if (current_day != nullptr)
+    {
+      std::scoped_lock sl(lock);
+      intraday.load(Paths::get_state_directory() / "todayseries", get_query_day(current_day->start));
+    }
+
   been_active = true;
 
   return current_day != nullptr;
@@ -321,137 +420,144 @@ void
 Statistics::load_history()
 {
   TRACE_ENTRY();
-  std::filesystem::path path = Paths::get_state_directory() / "historystats";
+  if (!history_store.exists())
+    {
+      convert_history();
+    }
+  else
+    {
+      std::vector<DailyStats> days;
+      if (history_store.load(days))
+        {
+          history.assign(days);
+        }
+      else
+        {
+          // The text history is older than the store, so it must not replace it.
+          std::filesystem::path moved_to;
+          if (history_store.move_aside(moved_to))
+            {
+              spdlog::error("Failed to load history, moved it to {}", moved_to.string());
+            }
+          else
+            {
+              spdlog::error("Failed to load history");
+            }
+        }
+    }
 
-  ifstream stats_file(path.string());
+  rebuild_rollups();
+}
 
-  load(stats_file, true);
+//! Starts loading the history in the background, if not done already.
+void
+Statistics::start_history_loader() const
+{
+  if (history_state != HistoryState::Unloaded)
+    {
+      return;
+    }
+
+  history_state = HistoryState::Loading;
+
+  // Lazy loading is an implementation detail of the const accessors.
+  auto *self = const_cast<Statistics *>(this);
+  history_loader = std::thread([self]() {
+    self->load_history();
+
+    std::scoped_lock l(self->history_lock);
+    for (auto &task: self->history_tasks)
+      {
+        task();
+      }
+    self->history_tasks.clear();
+    self->history_state = HistoryState::Loaded;
+    self->history_loaded.notify_all();
+  });
 }
 
-//! Loads the statistics.
+//! Blocks until the history is loaded.
 void
-Statistics::load(ifstream &infile, bool history)
+Statistics::wait_for_history() const
 {
-  TRACE_ENTRY();
-  DailyStatsImpl *stats = nullptr;
+  std::unique_lock l(history_lock);
+  start_history_loader();
+  history_loaded.wait(l, [this]() { return history_state == HistoryState::Loaded; });
+}
 
-  bool ok = infile.good();
+//! Runs the task as soon as the history is loaded.
+void
+Statistics::when_history_loaded(std::function<void()> task)
+{
+  {
+    std::scoped_lock l(history_lock);
+    if (history_state != HistoryState::Loaded)
+      {
+        history_tasks.push_back(std::move(task));
+        start_history_loader();
+        return;
+      }
+  }
+
+  task();
+}
 
-  if (ok)
-    {
-      string tag;
-      infile >> tag;
+//! Converts the history from the text format of older versions.
+void
+Statistics::convert_history()
+{
+  TRACE_ENTRY();
+  std::filesystem::path path = Paths::get_state_directory() / "historystats";
 
-      ok = (tag == WORKRAVESTATS);
-    }
+  ifstream stats_file(path.string());
+  load(stats_file, true);
 
-  if (ok)
+  if (!history.empty())
     {
-      int version;
-      infile >> version;
-
-      ok = (version == STATSVERSION) || (version == 3);
+      std::vector<DailyStats> days;
+      std::vector<const DailyStats *> refs;
+      days.reserve(history.size());
+      for (std::size_t i = 0; i < history.size(); i++)
+        {
+          days.push_back(history[i].to_daily_stats());
+          refs.push_back(&days.back());
+        }
+      history_store.write(refs);
     }
+}
 
-  while (ok && !infile.eof())
+//! Writes the history in the text format.
+void
+Statistics::export_history(std::ostream &out) const
+{
+  wait_for_history();
+
+  out << WORKRAVESTATS << " " << STATSVERSION << endl;
+  for (std::size_t i = 0; i < history.size(); i++)
     {
-      char line[BUFSIZ] = "";
+      DailyStats stats = history[i].to_daily_stats();
+      save_day(&stats, out);
+    }
+}
 
-      infile.getline(line, BUFSIZ);
+//! Loads the statistics.
+void
+Statistics::load(ifstream &infile, bool history)
+{
+  TRACE_ENTRY();
+  StatisticsReader reader(infile);
 
-      if (strlen(line) > 1)
+  DailyStats day{};
+  if (history)
+    {
+      while (reader.next(day))
         {
-          char cmd = line[0];
-
-          stringstream ss(line + 1);
-
-          if (cmd == 'D')
-            {
-              if (history && stats != nullptr)
-                {
-                  add_history(stats);
-                  stats = nullptr;
-                }
-              else if (!history && stats != nullptr)
-                {
-                  /* Corrupt today stats */
-                  return;
-                }
-
-              stats = new DailyStatsImpl();
-
-              ss >> stats->start.tm_mday >> stats->start.tm_mon >> stats->start.tm_year >> stats->start.tm_hour >> stats->start.tm_min
-                >> stats->stop.tm_mday >> stats->stop.tm_mon >> stats->stop.tm_year >> stats->stop.tm_hour >> stats->stop.tm_min;
-
-              if (!history)
-                {
-                  current_day = stats;
-                }
-            }
-          else if (stats != nullptr)
-            {
-              if (cmd == 'B')
-                {
-                  int bt = 0;
-                  int size = 0;
-                  ss >> bt;
-                  ss >> size;
-
-                  BreakStats &bs = stats->break_stats[bt];
-
-                  if (size > STATS_BREAKVALUE_SIZEOF)
-                    {
-                      size = STATS_BREAKVALUE_SIZEOF;
-                    }
-
-                  for (int j = 0; j < size; j++)
-                    {
-                      int value = 0;
-                      ss >> value;
-
-                      bs[j] = value;
-                    }
-                }
-              else if (cmd == 'M' || cmd == 'm')
-                {
-                  int size = 0;
-                  ss >> size;
-
-                  if (size > STATS_VALUE_SIZEOF)
-                    {
-                      size = STATS_VALUE_SIZEOF;
-                    }
-
-                  for (int j = 0; j < size; j++)
-                    {
-                      int value = 0;
-                      ss >> value;
-
-                      if (cmd == 'm')
-                        {
-                          // Ignore older 'M' stats. they are broken....
-                          stats->misc_stats[j] = value;
-                        }
-                      else
-                        {
-                          stats->misc_stats[j] = 0;
-                        }
-                    }
-                }
-              else if (cmd == 'G')
-                {
-                  int total_active = 0;
-                  ss >> total_active;
-
-                  stats->misc_stats[STATS_VALUE_TOTAL_ACTIVE_TIME] = total_active;
-                }
-            }
+          add_history(day);
         }
     }
-
-  if (history && stats != nullptr)
+  else if (reader.next(day) && DailyStatsArena::day_number(day.start) && DailyStatsArena::day_number(day.stop))
     {
-      add_history(stats);
+      current_day = new DailyStatsImpl(day);
     }
 }
 
@@ -536,17 +642,19 @@ Statistics::get_current_day() const
   return current_day;
 }
 
-Statistics::DailyStatsImpl *
+std::optional<IStatistics::DailyStats>
 Statistics::get_day(int day) const
 {
-  DailyStatsImpl *ret = nullptr;
+  std::optional<DailyStats> ret;
 
   if (day == 0)
     {
-      ret = current_day;
+      ret = *current_day;
     }
   else
     {
+      wait_for_history();
+
       if (day > 0)
         {
           day = static_cast<int>(history.size()) - day;
@@ -559,7 +667,7 @@ Statistics::get_day(int day) const
 
       if (day < int(history.size()) && day >= 0)
         {
-          ret = history[day];
+          ret = history[day].to_daily_stats();
         }
     }
 
@@ -571,29 +679,36 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
 {
   TRACE_ENTRY_PAR(y, m, d);
   idx = next = prev = -1;
-  for (int i = 0; i <= static_cast<int>(history.size()); i++)
+  wait_for_history();
+
+  // History is sorted by date, index i is day history.size() - i.
+  uint16_t key = get_query_day(y, m, d);
+  int lower = static_cast<int>(history.lower_bound(key));
+  int upper = static_cast<int>(history.upper_bound(key));
+
+  int size = static_cast<int>(history.size());
+  if (lower != upper)
     {
-      int j = static_cast<int>(history.size() - i);
-      DailyStatsImpl *stats = j == 0 ? current_day : history[i];
-      if (idx < 0 && stats->starts_at_date(y, m, d))
-        {
-          idx = j;
-        }
-      else if (stats->starts_before_date(y, m, d))
-        {
-          prev = j;
-        }
-      else if (next < 0)
-        {
-          next = j;
-        }
+      idx = size - lower;
+    }
+  if (lower != 0)
+    {
+      prev = size - lower + 1;
+    }
+  if (upper != size)
+    {
+      next = size - upper;
     }
 
-  if (prev < 0 && current_day->starts_before_date(y, m, d))
+  if (idx < 0 && current_day->starts_at_date(y, m, d))
+    {
+      idx = 0;
+    }
+  else if (current_day->starts_before_date(y, m, d))
     {
       prev = 0;
     }
-  if (next < 0 && !current_day->starts_at_date(y, m, d) && !current_day->starts_before_date(y, m, d))
+  else if (next < 0)
     {
       next = 0;
     }
@@ -602,9 +717,106 @@ Statistics::get_day_index_by_date(int y, int m, int d, int &idx, int &next, int
 int
 Statistics::get_history_size() const
 {
+  wait_for_history();
   return static_cast<int>(history.size());
 }
 
+std::future<std::optional<IStatistics::DailyStats>>
+Statistics::get_day_async(int day)
+{
+  auto promise = std::make_shared<std::promise<std::optional<DailyStats>>>();
+  auto future = promise->get_future();
+
+  if (day == 0)
+    {
+      promise->set_value(*current_day);
+    }
+  else
+    {
+      when_history_loaded([this, day, promise]() {
+        std::optional<DailyStats> ret;
+        int size = static_cast<int>(history.size());
+        int i = day > 0 ? size - day : -day - 1;
+        if (i >= 0 && i < size)
+          {
+            ret = history[i].to_daily_stats();
+          }
+        promise->set_value(ret);
+      });
+    }
+
+  return future;
+}
+
+std::future<std::vector<IStatistics::DailyStats>>
+Statistics::get_range_async(const struct tm &from, const struct tm &to)
+{
+  auto promise = std::make_shared<std::promise<std::vector<DailyStats>>>();
+  auto future = promise->get_future();
+
+  uint16_t from_key = get_query_day(from);
+  uint16_t to_key = get_query_day(to);
+
+  std::optional<DailyStats> today;
+  uint16_t today_key = get_query_day(current_day->start);
+  if (today_key >= from_key && today_key <= to_key)
+    {
+      today = *current_day;
+    }
+
+  when_history_loaded([this, from_key, to_key, today_key, today, promise]() {
+    std::vector<DailyStats> ret;
+    std::size_t last = history.upper_bound(to_key);
+    for (std::size_t i = history.lower_bound(from_key); i < last; i++)
+      {
+        ret.push_back(history[i].to_daily_stats());
+      }
+    if (today && (ret.empty() || get_query_day(ret.back().start) < today_key))
+      {
+        ret.push_back(*today);
+      }
+    promise->set_value(std::move(ret));
+  });
+
+  return future;
+}
+
+IStatistics::StatsAggregate
+Statistics::get_aggregate(StatsRange range, int y, int m, int d, int week_start)
+{
+  wait_for_history();
+
+  if (range == StatsRange::Week && week_start != rollup_week_start)
+    {
+      rollup_week_start = week_start;
+      rebuild_rollups();
+    }
+
+  StatsAggregate ret{};
+  uint16_t start = get_range_start(range, get_query_day(y, m, d), week_start);
+  auto i = rollups.find(get_rollup_key(range, start));
+  if (i != rollups.end())
+    {
+      ret = i->second;
+    }
+
+  // The current day is not part of the history, unless it was archived already.
+  uint16_t today = get_query_day(current_day->start);
+  if (get_range_start(range, today, week_start) == start && history.lower_bound(today) == history.upper_bound(today))
+    {
+      accumulate(ret, *current_day, 1);
+      ret.includes_today = true;
+    }
+  return ret;
+}
+
+IStatistics::IntradaySamples
+Statistics::get_intraday() const
+{
+  std::scoped_lock sl(lock);
+  return intraday.get_samples();
+}
+
 bool
 Statistics::DailyStatsImpl::starts_at_date(int y, int m, int d)
 {
@@ -618,109 +830,121 @@ Statistics::DailyStatsImpl::starts_before_date(int y, int m, int d)
           || (start.tm_year + 1900 == y && (start.tm_mon + 1 < m || (start.tm_mon + 1 == m && start.tm_mday < d))));
 }
 
-//! Activity is reported by the input monitor.
+//! Processes the input events queued by the input monitor.
 void
-Statistics::action_notify()
+Statistics::process_input_events()
 {
+  if (input_monitor != nullptr)
+    {
+      input_monitor->drain(this);
+    }
 }
 
-//! Mouse activity is reported by the input monitor.
+//! A batch of input events is reported by the input monitor.
 void
-Statistics::mouse_notify(int x, int y, int wheel_delta)
+Statistics::input_events_notify(std::span<const InputEvent> events)
 {
-  static const int sensitivity = 3;
+  std::scoped_lock sl(lock);
 
-  lock.lock();
+  if (current_day == nullptr)
+    {
+      return;
+    }
+
+  // Events carry the monotonic time at which they were received, the
+  // intraday series is indexed by the local time of day.
+  const time_t now = TimeSource::get_real_time_sec();
+  struct tm *tmnow = localtime(&now);
+  int now_second = (tmnow->tm_hour * 60 + tmnow->tm_min) * 60 + tmnow->tm_sec;
+  int64_t now_usec = TimeSource::get_monotonic_time_usec();
 
-  if (current_day != nullptr && x >= 0 && y >= 0)
+  // Runs of mouse events are handed to the accumulator at once. Button
+  // events need the pointer position at the time of the click.
+  std::size_t run_start = 0;
+  for (std::size_t i = 0; i < events.size(); i++)
     {
-      int delta_x = sensitivity;
-      int delta_y = sensitivity;
+      const InputEvent &event = events[i];
+      int second = now_second - static_cast<int>((now_usec - event.time_usec) / TimeSource::TIME_USEC_PER_SEC);
+      intraday.add_activity(second);
 
-      if (prev_x != -1 && prev_y != -1)
+      if (event.type == InputEventType::Mouse)
         {
-          delta_x = abs(x - prev_x);
-          delta_y = abs(y - prev_y);
+          continue;
         }
 
-      prev_x = x;
-      prev_y = y;
+      mouse_stats.add(events.subspan(run_start, i - run_start));
+      run_start = i + 1;
 
-      // Sanity checks, ignore unreasonable large jumps...
-      if (delta_x < MAX_JUMP && delta_y < MAX_JUMP && (delta_x >= sensitivity || delta_y >= sensitivity || wheel_delta != 0))
+      switch (event.type)
         {
-          int64_t movement = current_day->misc_stats[STATS_VALUE_TOTAL_MOUSE_MOVEMENT];
-          int distance = int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
-
-          movement += distance;
-          if (movement > 0)
-            {
-              current_day->misc_stats[STATS_VALUE_TOTAL_MOUSE_MOVEMENT] = movement;
-            }
-
-          auto now = std::chrono::system_clock::now();
-          auto tv = now - last_mouse_time;
+        case InputEventType::Button:
+          button_event(event, second);
+          break;
+        case InputEventType::Keyboard:
+          keyboard_event(event, second);
+          break;
+        default:
+          break;
+        }
+    }
+  mouse_stats.add(events.subspan(run_start));
 
-          if (tv < std::chrono::seconds(1))
-            {
-              current_day->total_mouse_time += tv;
-              current_day->misc_stats[STATS_VALUE_TOTAL_MOVEMENT_TIME] =
-                std::chrono::duration_cast<std::chrono::seconds>(current_day->total_mouse_time.time_since_epoch()).count();
-            }
+  int64_t distance = mouse_stats.take_movement();
+  intraday.add_movement(now_second, distance);
 
-          last_mouse_time = now;
-        }
+  int64_t movement = current_day->misc_stats[STATS_VALUE_TOTAL_MOUSE_MOVEMENT] + distance;
+  if (movement > 0)
+    {
+      current_day->misc_stats[STATS_VALUE_TOTAL_MOUSE_MOVEMENT] = movement;
     }
 
-  lock.unlock();
+  if (mouse_stats.has_movement_time())
+    {
+      current_day->total_mouse_time += std::chrono::microseconds(mouse_stats.take_movement_time());
+      current_day->misc_stats[STATS_VALUE_TOTAL_MOVEMENT_TIME] =
+        std::chrono::duration_cast<std::chrono::seconds>(current_day->total_mouse_time.time_since_epoch()).count();
+    }
 }
 
 //! Mouse button activity is reported by the input monitor.
 void
-Statistics::button_notify(bool is_press)
+Statistics::button_event(const InputEvent &event, int second)
 {
-  lock.lock();
-  if (current_day != nullptr)
+  int prev_x = mouse_stats.get_prev_x();
+  int prev_y = mouse_stats.get_prev_y();
+
+  if (click_x != -1 && click_y != -1 && prev_x != -1 && prev_y != -1)
     {
-      if (click_x != -1 && click_y != -1 && prev_x != -1 && prev_y != -1)
-        {
-          int delta_x = click_x - prev_x;
-          int delta_y = click_y - prev_y;
+      int delta_x = click_x - prev_x;
+      int delta_y = click_y - prev_y;
 
-          int64_t movement = current_day->misc_stats[STATS_VALUE_TOTAL_CLICK_MOVEMENT];
-          int64_t distance = int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
+      int64_t movement = current_day->misc_stats[STATS_VALUE_TOTAL_CLICK_MOVEMENT];
+      int64_t distance = int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
 
-          movement += distance;
-          if (movement > 0)
-            {
-              current_day->misc_stats[STATS_VALUE_TOTAL_CLICK_MOVEMENT] = movement;
-            }
+      movement += distance;
+      if (movement > 0)
+        {
+          current_day->misc_stats[STATS_VALUE_TOTAL_CLICK_MOVEMENT] = movement;
         }
+    }
 
-      click_x = prev_x;
-      click_y = prev_y;
+  click_x = prev_x;
+  click_y = prev_y;
 
-      if (is_press)
-        {
-          current_day->misc_stats[STATS_VALUE_TOTAL_CLICKS]++;
-        }
+  if (event.is_press())
+    {
+      current_day->misc_stats[STATS_VALUE_TOTAL_CLICKS]++;
+      intraday.add_click(second);
     }
-  lock.unlock();
 }
 
 //! Keyboard activity is reported by the input monitor.
 void
-Statistics::keyboard_notify(bool repeat)
+Statistics::keyboard_event(const InputEvent &event, int second)
 {
-  if (repeat)
-    {
-      return;
-    }
-
-  lock.lock();
-  if (current_day != nullptr)
+  if (!event.is_repeat())
     {
       current_day->misc_stats[STATS_VALUE_TOTAL_KEYSTROKES]++;
+      intraday.add_keystroke(second);
     }
-  lock.unlock();
 }
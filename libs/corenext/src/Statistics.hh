@@ -21,6 +21,9 @@
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
 
 #include <chrono>
 
@@ -31,19 +34,30 @@
 #include <cstring>
 
 #include "input-monitor/IInputMonitor.hh"
-#include "input-monitor/IInputMonitorListener.hh"
+#include "input-monitor/IInputMonitorBatchListener.hh"
 
 #include "core/IStatistics.hh"
 #include "IActivityMonitor.hh"
+#include "DailyStatsArena.hh"
+#include "HistoryStore.hh"
+#include "IntradaySeries.hh"
+#include "MouseStatsAccumulator.hh"
 
 class Statistics
   : public workrave::IStatistics
-  , public workrave::input_monitor::IInputMonitorListener
+  , public workrave::input_monitor::IInputMonitorBatchListener
 {
 public:
   using Ptr = std::shared_ptr<Statistics>;
 
 private:
+  enum class HistoryState
+  {
+    Unloaded,
+    Loading,
+    Loaded,
+  };
+
   enum StatsMarker
   {
     STATS_MARKER_TODAY,
@@ -82,6 +96,11 @@ private:
       start.tm_year = 0;
     }
 
+    explicit DailyStatsImpl(const DailyStats &stats)
+      : DailyStats(stats)
+    {
+    }
+
     bool starts_at_date(int y, int m, int d);
     bool starts_before_date(int y, int m, int d);
     bool is_empty() const
@@ -90,10 +109,6 @@ private:
     }
   };
 
-  using History = std::vector<DailyStatsImpl *>;
-  using HistoryIter = std::vector<DailyStatsImpl *>::iterator;
-  using HistoryRIter = std::vector<DailyStatsImpl *>::reverse_iterator;
-
 public:
   //! Constructor.
   explicit Statistics(IActivityMonitor::Ptr monitor);
@@ -107,6 +122,7 @@ public:
   void init();
   void update() override;
   void dump() override;
+  void process_input_events();
   void start_new_day();
 
   void increment_break_counter(workrave::BreakId, StatsBreakValueType st);
@@ -114,31 +130,43 @@ public:
   void add_break_counter(workrave::BreakId bt, StatsBreakValueType st, int value);
 
   DailyStatsImpl *get_current_day() const override;
-  DailyStatsImpl *get_day(int day) const override;
+  std::optional<DailyStats> get_day(int day) const override;
   void get_day_index_by_date(int y, int m, int d, int &idx, int &next, int &prev) const override;
 
   int get_history_size() const override;
+  std::future<std::optional<DailyStats>> get_day_async(int day) override;
+  std::future<std::vector<DailyStats>> get_range_async(const struct tm &from, const struct tm &to) override;
+  void when_history_loaded(std::function<void()> task) override;
+  StatsAggregate get_aggregate(StatsRange range, int y, int m, int d, int week_start) override;
+  IntradaySamples get_intraday() const override;
+  void export_history(std::ostream &out) const;
   void set_counter(StatsValueType t, int value);
   int64_t get_counter(StatsValueType t);
 
 private:
-  void action_notify() override;
-  void mouse_notify(int x, int y, int wheel = 0) override;
-  void button_notify(bool is_press) override;
-  void keyboard_notify(bool repeat) override;
+  void input_events_notify(std::span<const workrave::input_monitor::InputEvent> events) override;
+  void button_event(const workrave::input_monitor::InputEvent &event, int second);
+  void keyboard_event(const workrave::input_monitor::InputEvent &event, int second);
 
   bool load_current_day();
   void load_history();
 
+  void start_history_loader() const;
+  void wait_for_history() const;
+
 private:
   void save_day(DailyStatsImpl *stats);
-  void save_day(DailyStatsImpl *stats, std::ofstream &stats_file);
+  static void save_day(const DailyStats *stats, std::ostream &stats_file);
+  void save_intraday(DailyStatsImpl *stats);
   void load(std::ifstream &infile, bool history);
+  void convert_history();
 
   void day_to_history(DailyStatsImpl *stats);
   void day_to_remote_history(DailyStatsImpl *stats);
 
-  void add_history(DailyStatsImpl *stats);
+  void add_history(const DailyStats &stats);
+  void update_rollups(const DailyStats &stats, int sign);
+  void rebuild_rollups();
 
 private:
   IActivityMonitor::Ptr monitor;
@@ -146,26 +174,47 @@ private:
   //! Mouse/Keyboard monitoring.
   workrave::input_monitor::IInputMonitor::Ptr input_monitor;
 
-  //! Last time a mouse event was received.
-  std::chrono::system_clock::time_point last_mouse_time;
-
   //! Statistics of current day.
   DailyStatsImpl *current_day;
 
   //! Has the user been active on the current day?
   bool been_active;
 
-  //! History
-  History history;
+  //! History, sorted by date.
+  DailyStatsArena history;
+
+  //! Totals per week, month and year, and of all days, by range and first day.
+  std::unordered_map<uint32_t, StatsAggregate> rollups;
+
+  //! First day of the week of the weekly rollups.
+  int rollup_week_start{1};
+
+  //! Binary history store.
+  HistoryStore history_store;
+
+  //! Protects the history while it is loaded in the background.
+  mutable std::mutex history_lock;
+
+  //! Signalled when the history has been loaded.
+  mutable std::condition_variable history_loaded;
+
+  //! Loading state of the history.
+  mutable HistoryState history_state{HistoryState::Unloaded};
+
+  //! Background history loader.
+  mutable std::thread history_loader;
+
+  //! Queries waiting for the history to be loaded.
+  std::vector<std::function<void()>> history_tasks;
 
   //! Internal locking
-  std::mutex lock;
+  mutable std::mutex lock;
 
-  //! Previous X coordinate
-  int prev_x;
+  //! Activity per minute of the current day.
+  IntradaySeries intraday;
 
-  //! Previous Y coordinate
-  int prev_y;
+  //! Mouse movement statistics.
+  MouseStatsAccumulator mouse_stats;
 
   //! Previous X-click coordinate
   int click_x;
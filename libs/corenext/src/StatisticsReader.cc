@@ -0,0 +1,213 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "StatisticsReader.hh"
+
+#include <charconv>
+#include <cstring>
+
+using namespace workrave;
+
+static const char *WORKRAVESTATS = "WorkRaveStats";
+static const int STATSVERSION = 4;
+
+StatisticsReader::StatisticsReader(std::istream &in)
+  : in(&in)
+{
+  valid = read_header();
+}
+
+StatisticsReader::StatisticsReader(std::string_view text, bool header)
+  : text(text)
+{
+  valid = header ? read_header() : true;
+}
+
+bool
+StatisticsReader::is_valid() const
+{
+  return valid;
+}
+
+//! Parses the next number on the line, leaving 0 if there is none.
+static int64_t
+parse_number(std::string_view line, std::size_t &pos)
+{
+  while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+    {
+      pos++;
+    }
+
+  int64_t value = 0;
+  auto [end, ec] = std::from_chars(line.data() + pos, line.data() + line.size(), value);
+  pos = end - line.data();
+  return ec == std::errc() ? value : 0;
+}
+
+bool
+StatisticsReader::read_line(std::string_view &line)
+{
+  if (in != nullptr)
+    {
+      if (!std::getline(*in, buffer))
+        {
+          return false;
+        }
+      line = buffer;
+    }
+  else
+    {
+      if (text.empty())
+        {
+          return false;
+        }
+      std::size_t end = text.find('\n');
+      line = text.substr(0, end);
+      text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+
+  if (!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+  return true;
+}
+
+bool
+StatisticsReader::read_header()
+{
+  std::string_view line;
+  if (!read_line(line) || line.substr(0, std::strlen(WORKRAVESTATS)) != WORKRAVESTATS)
+    {
+      return false;
+    }
+
+  std::size_t pos = std::strlen(WORKRAVESTATS);
+  int64_t version = parse_number(line, pos);
+  return version == STATSVERSION || version == 3;
+}
+
+bool
+StatisticsReader::next(DailyStats &day)
+{
+  if (!valid)
+    {
+      return false;
+    }
+
+  std::string_view line = pending;
+  pending = {};
+  if (line.empty())
+    {
+      while (read_line(line) && (line.size() <= 1 || line[0] != 'D'))
+        {
+        }
+      if (line.size() <= 1 || line[0] != 'D')
+        {
+          return false;
+        }
+    }
+
+  parse_day(line, day);
+
+  while (read_line(line))
+    {
+      if (line.size() <= 1)
+        {
+          continue;
+        }
+      if (line[0] == 'D')
+        {
+          pending = line;
+          break;
+        }
+      parse_stats(line, day);
+    }
+  return true;
+}
+
+void
+StatisticsReader::parse_day(std::string_view line, DailyStats &day)
+{
+  std::memset((void *)&day, 0, sizeof(day));
+
+  std::size_t pos = 1;
+  for (struct tm *t: {&day.start, &day.stop})
+    {
+      t->tm_mday = static_cast<int>(parse_number(line, pos));
+      t->tm_mon = static_cast<int>(parse_number(line, pos));
+      t->tm_year = static_cast<int>(parse_number(line, pos));
+      t->tm_hour = static_cast<int>(parse_number(line, pos));
+      t->tm_min = static_cast<int>(parse_number(line, pos));
+    }
+}
+
+void
+StatisticsReader::parse_stats(std::string_view line, DailyStats &day)
+{
+  char cmd = line[0];
+  std::size_t pos = 1;
+
+  if (cmd == 'B')
+    {
+      int64_t bt = parse_number(line, pos);
+      int64_t size = parse_number(line, pos);
+
+      if (bt < 0 || bt >= BREAK_ID_SIZEOF)
+        {
+          return;
+        }
+
+      IStatistics::BreakStats &bs = day.break_stats[bt];
+
+      if (size > IStatistics::STATS_BREAKVALUE_SIZEOF)
+        {
+          size = IStatistics::STATS_BREAKVALUE_SIZEOF;
+        }
+
+      for (int j = 0; j < size; j++)
+        {
+          bs[j] = static_cast<int>(parse_number(line, pos));
+        }
+    }
+  else if (cmd == 'M' || cmd == 'm')
+    {
+      int64_t size = parse_number(line, pos);
+
+      if (size > IStatistics::STATS_VALUE_SIZEOF)
+        {
+          size = IStatistics::STATS_VALUE_SIZEOF;
+        }
+
+      for (int j = 0; j < size; j++)
+        {
+          int64_t value = parse_number(line, pos);
+
+          // Ignore older 'M' stats. they are broken....
+          day.misc_stats[j] = (cmd == 'm') ? value : 0;
+        }
+    }
+  else if (cmd == 'G')
+    {
+      day.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME] = parse_number(line, pos);
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef STATISTICSREADER_HH
+#define STATISTICSREADER_HH
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+#include "core/IStatistics.hh"
+
+//! Reads days from the WorkRaveStats text format, one day at a time.
+/*!
+ *  Only the current day is kept in memory, so files of any size can be read.
+ *  Headers in the middle of the input, as found in concatenated files, are
+ *  skipped.
+ */
+class StatisticsReader
+{
+public:
+  using DailyStats = workrave::IStatistics::DailyStats;
+
+  explicit StatisticsReader(std::istream &in);
+
+  //! Reads from memory, for example a mapped file.
+  /*!
+   *  Without a header, text must start at a day, as is the case for a part
+   *  of a file that was split at the start of a day.
+   */
+  explicit StatisticsReader(std::string_view text, bool header = true);
+
+  //! Returns true if the input starts with a supported header.
+  bool is_valid() const;
+
+  //! Reads the next day. Returns false at the end of the input.
+  bool next(DailyStats &day);
+
+private:
+  bool read_line(std::string_view &line);
+  bool read_header();
+  static void parse_day(std::string_view line, DailyStats &day);
+  static void parse_stats(std::string_view line, DailyStats &day);
+
+private:
+  std::istream *in{nullptr};
+  std::string_view text;
+  std::string buffer;
+  bool valid{false};
+
+  //! Start line of the next day, already read from the input.
+  std::string_view pending;
+};
+
+#endif // STATISTICSREADER_HH
@@ -433,6 +433,12 @@ Timer::get_next_reset_time() const
   return next_reset_time;
 }
 
+int64_t
+Timer::get_next_daily_reset_time() const
+{
+  return daily_auto_reset != nullptr ? next_daily_reset_time : 0;
+}
+
 void
 Timer::set_limit(int limit_time)
 {
@@ -496,10 +502,11 @@ Timer::get_id() const
 std::string
 Timer::serialize_state() const
 {
+  SavedTimerState state = get_saved_state();
   stringstream ss;
 
-  ss << timer_id << " " << TimeSource::get_real_time_sec_sync() << " " << get_elapsed_time() << " " << last_daily_reset_time << " "
-     << total_overdue_timespan << " " << snooze_inhibited << " " << 0 << " " << elapsed_timespan_at_last_limit << " " << 0 /* timezone */;
+  ss << timer_id << " " << state.save_time << " " << state.elapsed << " " << state.last_reset << " " << state.overdue << " "
+     << state.snooze_inhibited << " " << 0 << " " << state.elapsed_at_last_limit << " " << 0 /* timezone */;
 
   return ss.str();
 }
@@ -510,15 +517,10 @@ Timer::deserialize_state(const std::string &state, int version)
   TRACE_ENTRY();
   istringstream ss(state);
 
-  int64_t save_time = 0;
-  int64_t elapsed = 0;
-  int64_t last_reset = 0;
-  int64_t overdue = 0;
+  SavedTimerState saved;
   int64_t llt = 0;
-  int64_t lle = 0;
-  bool si = false;
 
-  ss >> save_time >> elapsed >> last_reset >> overdue >> si >> llt >> lle;
+  ss >> saved.save_time >> saved.elapsed >> saved.last_reset >> saved.overdue >> saved.snooze_inhibited >> llt >> saved.elapsed_at_last_limit;
 
   if (version == 3)
     {
@@ -527,22 +529,45 @@ Timer::deserialize_state(const std::string &state, int version)
       ss >> tz;
     }
 
+  restore_saved_state(saved);
+  return true;
+}
+
+SavedTimerState
+Timer::get_saved_state() const
+{
+  SavedTimerState state;
+  state.save_time = TimeSource::get_real_time_sec_sync();
+  state.elapsed = get_elapsed_time();
+  state.last_reset = last_daily_reset_time;
+  state.overdue = total_overdue_timespan;
+  state.snooze_inhibited = snooze_inhibited;
+  state.elapsed_at_last_limit = elapsed_timespan_at_last_limit;
+  return state;
+}
+
+void
+Timer::restore_saved_state(const SavedTimerState &state)
+{
+  TRACE_ENTRY();
+  int64_t last_reset = state.last_reset;
+
   // Sanity check...
-  if (last_reset > save_time)
+  if (last_reset > state.save_time)
     {
-      last_reset = save_time;
+      last_reset = state.save_time;
     }
 
-  TRACE_VAR(si, llt, lle);
+  TRACE_VAR(state.snooze_inhibited, state.elapsed_at_last_limit);
   TRACE_VAR(snooze_inhibited);
 
   last_daily_reset_time = last_reset;
-  total_overdue_timespan = overdue;
+  total_overdue_timespan = state.overdue;
   elapsed_timespan = 0;
   last_start_time = 0;
   last_stop_time = 0;
 
-  bool tooOld = (is_auto_reset_enabled() && (TimeSource::get_real_time_sec_sync() - save_time > auto_reset_interval));
+  bool tooOld = (is_auto_reset_enabled() && (TimeSource::get_real_time_sec_sync() - state.save_time > auto_reset_interval));
 
   if (!tooOld)
     {
@@ -550,21 +575,20 @@ Timer::deserialize_state(const std::string &state, int version)
         {
           next_reset_time = TimeSource::get_monotonic_time_sec_sync() + auto_reset_interval;
         }
-      elapsed_timespan = elapsed;
-      snooze_inhibited = si;
+      elapsed_timespan = state.elapsed;
+      snooze_inhibited = state.snooze_inhibited;
     }
 
   // overdue, so snooze
   if (is_limit_enabled() && get_elapsed_time() >= limit_interval)
     {
-      elapsed_timespan_at_last_limit = lle;
+      elapsed_timespan_at_last_limit = state.elapsed_at_last_limit;
       compute_next_limit_time();
     }
 
   compute_next_daily_reset_time();
 
   TRACE_MSG("elapsed = {}", elapsed_timespan);
-  return true;
 }
 
 // void
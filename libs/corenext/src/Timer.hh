@@ -47,6 +47,18 @@ enum TimerEvent
   TIMER_EVENT_LIMIT_REACHED,
 };
 
+//! The state of a timer that is preserved across restarts.
+struct SavedTimerState
+{
+  //! Real time at which the state was saved.
+  int64_t save_time{0};
+  int64_t elapsed{0};
+  int64_t last_reset{0};
+  int64_t overdue{0};
+  int64_t elapsed_at_last_limit{0};
+  bool snooze_inhibited{false};
+};
+
 //! The Timer class.
 /*!
  *  The Timer receives 'active' and 'idle' events from an activity monitor.
@@ -92,6 +104,7 @@ public:
   bool is_auto_reset_enabled() const;
   int64_t get_auto_reset() const;
   int64_t get_next_reset_time() const;
+  int64_t get_next_daily_reset_time() const;
 
   // Limiting.
   void set_limit(int limit_time);
@@ -110,6 +123,8 @@ public:
   // State serialization.
   std::string serialize_state() const;
   bool deserialize_state(const std::string &state, int version);
+  SavedTimerState get_saved_state() const;
+  void restore_saved_state(const SavedTimerState &state);
   // void set_state(int elapsed, int idle, int overdue = -1);
 
   int64_t get_total_overdue_time() const;
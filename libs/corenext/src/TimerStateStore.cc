@@ -0,0 +1,222 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "TimerStateStore.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "debug.hh"
+
+using namespace boost::interprocess;
+
+static constexpr char STORE_MAGIC[4] = {'W', 'R', 'T', 'S'};
+static constexpr uint32_t STORE_VERSION = 1;
+
+TimerStateStore::TimerStateStore(std::filesystem::path path)
+  : path(std::move(path))
+{
+}
+
+TimerStateStore::~TimerStateStore()
+{
+  if (region)
+    {
+      region->flush(0, 0, false);
+    }
+}
+
+bool
+TimerStateStore::save(const std::vector<Entry> &entries)
+{
+  TRACE_ENTRY();
+  bool fits = std::all_of(entries.begin(), entries.end(), [](const Entry &e) { return e.id.size() < MAX_ID_LENGTH; });
+  if (entries.size() > MAX_TIMERS || !fits || !map())
+    {
+      return false;
+    }
+
+  Layout *layout = get_layout();
+  bool valid0 = is_valid(layout->slots[0]);
+  bool valid1 = is_valid(layout->slots[1]);
+
+  uint64_t sequence = std::max(valid0 ? layout->slots[0].sequence : 0, valid1 ? layout->slots[1].sequence : 0);
+
+  // Overwrite the oldest or invalid slot, the other one stays intact.
+  Slot *slot = &layout->slots[0];
+  if (valid0 && (!valid1 || layout->slots[1].sequence < layout->slots[0].sequence))
+    {
+      slot = &layout->slots[1];
+    }
+
+  std::memset(slot->records, 0, sizeof(slot->records));
+  for (std::size_t i = 0; i < entries.size(); i++)
+    {
+      const Entry &entry = entries[i];
+      Record &record = slot->records[i];
+
+      std::memcpy(record.id, entry.id.data(), entry.id.size());
+      record.save_time = entry.state.save_time;
+      record.elapsed = entry.state.elapsed;
+      record.last_reset = entry.state.last_reset;
+      record.overdue = entry.state.overdue;
+      record.elapsed_at_last_limit = entry.state.elapsed_at_last_limit;
+      record.snooze_inhibited = entry.state.snooze_inhibited ? 1 : 0;
+    }
+  slot->count = static_cast<uint32_t>(entries.size());
+  slot->reserved = 0;
+  slot->sequence = sequence + 1;
+  slot->checksum = compute_checksum(*slot);
+
+  // msync needs page alignment, and the whole store fits in one page.
+  return region->flush(0, 0, true);
+}
+
+bool
+TimerStateStore::load(std::vector<Entry> &entries)
+{
+  TRACE_ENTRY();
+  if (!std::filesystem::exists(path) || !map())
+    {
+      return false;
+    }
+
+  Layout *layout = get_layout();
+  const Slot *slot = nullptr;
+  for (const Slot &s: layout->slots)
+    {
+      if (is_valid(s) && (slot == nullptr || s.sequence > slot->sequence))
+        {
+          slot = &s;
+        }
+    }
+
+  if (slot == nullptr)
+    {
+      return false;
+    }
+
+  entries.clear();
+  for (std::size_t i = 0; i < slot->count; i++)
+    {
+      const Record &record = slot->records[i];
+
+      Entry entry;
+      entry.id = record.id;
+      entry.state.save_time = record.save_time;
+      entry.state.elapsed = record.elapsed;
+      entry.state.last_reset = record.last_reset;
+      entry.state.overdue = record.overdue;
+      entry.state.elapsed_at_last_limit = record.elapsed_at_last_limit;
+      entry.state.snooze_inhibited = record.snooze_inhibited != 0;
+      entries.push_back(entry);
+    }
+  return true;
+}
+
+//! Maps the store, creating or resetting it if its layout is unknown.
+bool
+TimerStateStore::map()
+{
+  if (region)
+    {
+      return true;
+    }
+
+  try
+    {
+      std::error_code ec;
+      if (std::filesystem::file_size(path, ec) != sizeof(Layout) || ec)
+        {
+          // Only happens once; afterwards the file is updated in place.
+          std::ofstream file(path, std::ios::binary | std::ios::trunc);
+          file.close();
+          std::filesystem::resize_file(path, sizeof(Layout));
+        }
+
+      file_mapping mapping(path.string().c_str(), read_write);
+      region = std::make_unique<mapped_region>(mapping, read_write, 0, sizeof(Layout));
+
+      Header &header = get_layout()->header;
+      if (std::memcmp(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0 || header.version != STORE_VERSION
+          || header.slot_size != sizeof(Slot))
+        {
+          std::memset(region->get_address(), 0, sizeof(Layout));
+          std::memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+          header.version = STORE_VERSION;
+          header.slot_size = sizeof(Slot);
+          region->flush(0, 0, true);
+        }
+    }
+  catch (interprocess_exception &e)
+    {
+      TRACE_MSG("Cannot map {}: {}", path.string(), e.what());
+      region.reset();
+    }
+  catch (std::filesystem::filesystem_error &e)
+    {
+      TRACE_MSG("Cannot create {}: {}", path.string(), e.what());
+      region.reset();
+    }
+
+  return region != nullptr;
+}
+
+TimerStateStore::Layout *
+TimerStateStore::get_layout() const
+{
+  return static_cast<Layout *>(region->get_address());
+}
+
+//! 64-bit FNV-1a of the slot, excluding the checksum itself.
+uint64_t
+TimerStateStore::compute_checksum(const Slot &slot)
+{
+  const auto *data = reinterpret_cast<const unsigned char *>(&slot);
+  uint64_t hash = 14695981039346656037ULL;
+  for (std::size_t i = 0; i < offsetof(Slot, checksum); i++)
+    {
+      hash ^= data[i];
+      hash *= 1099511628211ULL;
+    }
+  return hash;
+}
+
+bool
+TimerStateStore::is_valid(const Slot &slot)
+{
+  if (slot.sequence == 0 || slot.count > MAX_TIMERS || slot.checksum != compute_checksum(slot))
+    {
+      return false;
+    }
+
+  return std::all_of(std::begin(slot.records), std::begin(slot.records) + slot.count, [](const Record &r) {
+    return r.id[MAX_ID_LENGTH - 1] == '\0';
+  });
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef TIMERSTATESTORE_HH
+#define TIMERSTATESTORE_HH
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Timer.hh"
+
+namespace boost::interprocess
+{
+  class mapped_region;
+}
+
+//! Crash-consistent binary store of the timer states.
+/*!
+ *  The state lives in a small fixed-size memory-mapped file with two slots.
+ *  A save overwrites the oldest slot in place and stamps it with a sequence
+ *  number and checksum, so an interrupted save never damages the slot that
+ *  was written before it.
+ */
+class TimerStateStore
+{
+public:
+  struct Entry
+  {
+    std::string id;
+    SavedTimerState state;
+  };
+
+  explicit TimerStateStore(std::filesystem::path path);
+  ~TimerStateStore();
+
+  TimerStateStore(const TimerStateStore &) = delete;
+  TimerStateStore &operator=(const TimerStateStore &) = delete;
+
+  //! Writes the states to the oldest slot, returns false on failure.
+  bool save(const std::vector<Entry> &entries);
+
+  //! Reads the states of the newest valid slot, returns false if there is none.
+  bool load(std::vector<Entry> &entries);
+
+  //! Maximum number of timers in a slot.
+  static constexpr std::size_t MAX_TIMERS = 8;
+
+  //! Maximum length of a timer id, including the terminating zero.
+  static constexpr std::size_t MAX_ID_LENGTH = 32;
+
+private:
+  struct Record
+  {
+    char id[MAX_ID_LENGTH];
+    int64_t save_time;
+    int64_t elapsed;
+    int64_t last_reset;
+    int64_t overdue;
+    int64_t elapsed_at_last_limit;
+    uint8_t snooze_inhibited;
+    uint8_t reserved[7];
+  };
+
+  struct Slot
+  {
+    uint64_t sequence;
+    uint32_t count;
+    uint32_t reserved;
+    Record records[MAX_TIMERS];
+    uint64_t checksum;
+  };
+
+  struct Header
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t slot_size;
+    uint32_t reserved;
+  };
+
+  struct Layout
+  {
+    Header header;
+    Slot slots[2];
+  };
+
+  bool map();
+  Layout *get_layout() const;
+  static uint64_t compute_checksum(const Slot &slot);
+  static bool is_valid(const Slot &slot);
+
+private:
+  std::filesystem::path path;
+  std::unique_ptr<boost::interprocess::mapped_region> region;
+};
+
+#endif // TIMERSTATESTORE_HH
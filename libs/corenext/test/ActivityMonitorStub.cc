@@ -38,8 +38,14 @@ ActivityMonitorStub::ActivityMonitorStub()
 void
 ActivityMonitorStub::set_active(bool active)
 {
+  bool was_active = is_active();
   this->active = active;
   forced_idle = false;
+
+  if (is_active() != was_active)
+    {
+      activity_changed_signal();
+    }
 }
 
 void
@@ -82,11 +88,19 @@ ActivityMonitorStub::set_listener(IActivityMonitorListener::Ptr l)
   listener = l;
 }
 
+boost::signals2::signal<void()> &
+ActivityMonitorStub::signal_activity_changed()
+{
+  return activity_changed_signal;
+}
+
 void
 ActivityMonitorStub::notify()
 {
   IActivityMonitorListener::Ptr l;
 
+  activity_changed_signal();
+
   l = listener;
   if (l)
     {
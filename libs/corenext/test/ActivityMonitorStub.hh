@@ -40,6 +40,7 @@ public:
   void force_idle() override;
   bool is_active() override;
   void set_listener(IActivityMonitorListener::Ptr l) override;
+  boost::signals2::signal<void()> &signal_activity_changed() override;
 
   void notify();
 
@@ -48,6 +49,7 @@ private:
   bool suspended;
   bool forced_idle;
   IActivityMonitorListener::Ptr listener;
+  boost::signals2::signal<void()> activity_changed_signal;
 };
 
 #endif // LOCALACTIVITYMONITOR_HH
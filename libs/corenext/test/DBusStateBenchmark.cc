@@ -0,0 +1,137 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Compares the cost of polling the timer state of a running Workrave over
+// D-Bus with the per-break getters against a single GetState call.
+//
+// Usage: workrave-core-next-dbus-state-benchmark [iterations]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+#include <gio/gio.h>
+
+static const char *const service_name = "org.workrave.Workrave";
+static const char *const core_path = "/org/workrave/Workrave/Core";
+static const char *const break_paths[] = {
+  "/org/workrave/Workrave/Break/micro_pause",
+  "/org/workrave/Workrave/Break/rest_break",
+  "/org/workrave/Workrave/Break/daily_limit",
+};
+static const char *const break_methods[] = {
+  "IsTimerRunning",
+  "GetTimerElapsed",
+  "GetTimerIdle",
+  "GetTimerRemaining",
+  "GetTimerOverdue",
+  "GetBreakState",
+};
+
+static bool
+call(GDBusConnection *connection, const char *path, const char *interface, const char *method)
+{
+  GError *error = nullptr;
+  GVariant *result = g_dbus_connection_call_sync(
+    connection, service_name, path, interface, method, nullptr, nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+  if (result == nullptr)
+    {
+      printf("%s.%s failed: %s\n", interface, method, error->message);
+      g_error_free(error);
+      return false;
+    }
+  g_variant_unref(result);
+  return true;
+}
+
+//! Polls the state the way the applets used to: one call per value.
+static bool
+poll_per_call(GDBusConnection *connection)
+{
+  bool ok = call(connection, core_path, "org.workrave.CoreInterface", "GetOperationMode")
+            && call(connection, core_path, "org.workrave.CoreInterface", "GetUsageMode")
+            && call(connection, core_path, "org.workrave.CoreInterface", "IsActive");
+
+  for (const char *path: break_paths)
+    {
+      for (const char *method: break_methods)
+        {
+          ok = ok && call(connection, path, "org.workrave.BreakInterface", method);
+        }
+    }
+  return ok;
+}
+
+static bool
+poll_batched(GDBusConnection *connection)
+{
+  return call(connection, core_path, "org.workrave.CoreInterface", "GetState");
+}
+
+static void
+report(const char *name, int iterations, int calls, std::chrono::steady_clock::duration elapsed)
+{
+  double us = std::chrono::duration<double, std::micro>(elapsed).count();
+  printf("%-10s %4d calls/poll %10.1f us/poll\n", name, calls, us / iterations);
+}
+
+int
+main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? static_cast<int>(std::strtol(argv[1], nullptr, 10)) : 1000;
+
+  GError *error = nullptr;
+  GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+  if (connection == nullptr)
+    {
+      printf("No session bus: %s\n", error->message);
+      g_error_free(error);
+      return 0;
+    }
+
+  if (!poll_batched(connection))
+    {
+      printf("Workrave is not running, nothing to measure\n");
+      g_object_unref(connection);
+      return 0;
+    }
+
+  const int per_call = 3 + static_cast<int>(std::size(break_paths) * std::size(break_methods));
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    {
+      poll_per_call(connection);
+    }
+  report("per-call", iterations, per_call, std::chrono::steady_clock::now() - start);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    {
+      poll_batched(connection);
+    }
+  report("GetState", iterations, 1, std::chrono::steady_clock::now() - start);
+
+  g_object_unref(connection);
+  return 0;
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Compares the memory used by the history as heap-allocated days with
+// the packed arena.
+//
+// Usage: workrave-core-next-history-memory-benchmark [days]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <vector>
+
+#include "DailyStatsArena.hh"
+
+using namespace workrave;
+
+static std::size_t allocated_bytes = 0;
+static std::size_t allocations = 0;
+
+void *
+operator new(std::size_t size)
+{
+  allocated_bytes += size;
+  allocations++;
+  if (void *ptr = std::malloc(size))
+    {
+      return ptr;
+    }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+//! The layout of a day that Statistics used before the arena.
+struct LegacyDay : public IStatistics::DailyStats
+{
+  std::chrono::system_clock::time_point total_mouse_time;
+};
+
+static IStatistics::DailyStats
+create_day(int index)
+{
+  IStatistics::DailyStats day{};
+  time_t t = 1262347200 + static_cast<time_t>(index) * 86400;
+  day.start = *gmtime(&t);
+  day.stop = day.start;
+  day.stop.tm_hour += 8;
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      for (int j = 0; j < IStatistics::STATS_BREAKVALUE_SIZEOF; j++)
+        {
+          day.break_stats[i][j] = (index + i + j) % 50;
+        }
+    }
+  for (int j = 0; j < IStatistics::STATS_VALUE_SIZEOF; j++)
+    {
+      day.misc_stats[j] = (index * 37 + j) % 100000;
+    }
+  return day;
+}
+
+static void
+report(const char *name, std::size_t count, std::size_t bytes, std::size_t allocs)
+{
+  printf("%-8s %9zu bytes %6zu allocations %7.1f bytes/day\n", name, bytes, allocs, static_cast<double>(bytes) / static_cast<double>(count));
+}
+
+int
+main(int argc, char **argv)
+{
+  std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+
+  std::vector<IStatistics::DailyStats> days;
+  days.reserve(count);
+  for (std::size_t i = 0; i < count; i++)
+    {
+      days.push_back(create_day(static_cast<int>(i)));
+    }
+
+  int64_t legacy_total = 0;
+  {
+    std::size_t bytes = allocated_bytes;
+    std::size_t allocs = allocations;
+
+    std::vector<LegacyDay *> history;
+    history.reserve(count);
+    for (const auto &day: days)
+      {
+        auto *legacy = new LegacyDay();
+        static_cast<IStatistics::DailyStats &>(*legacy) = day;
+        history.push_back(legacy);
+      }
+
+    report("legacy", count, allocated_bytes - bytes, allocations - allocs);
+
+    for (const auto *day: history)
+      {
+        legacy_total += day->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+        delete day;
+      }
+  }
+
+  int64_t arena_total = 0;
+  {
+    std::size_t bytes = allocated_bytes;
+    std::size_t allocs = allocations;
+
+    DailyStatsArena history;
+    history.assign(days);
+
+    report("arena", count, allocated_bytes - bytes, allocations - allocs);
+
+    for (std::size_t i = 0; i < history.size(); i++)
+      {
+        arena_total += history[i].misc_stat(IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME);
+      }
+  }
+
+  if (legacy_total != arena_total)
+    {
+      printf("result mismatch\n");
+      return 1;
+    }
+  return 0;
+}
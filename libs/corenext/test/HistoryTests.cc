@@ -0,0 +1,518 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_history
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "utils/Paths.hh"
+
+#include "ActivityMonitorStub.hh"
+#include "DailyStatsArena.hh"
+#include "HistoryStore.hh"
+#include "IntradaySeries.hh"
+#include "Statistics.hh"
+#include "StatisticsReader.hh"
+
+using namespace workrave;
+using namespace workrave::utils;
+
+struct Fixture
+{
+  Fixture()
+  {
+    dir = std::filesystem::temp_directory_path() / "workrave-history-test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    Paths::set_portable_directory(dir.string());
+  }
+
+  ~Fixture()
+  {
+    std::filesystem::remove_all(dir);
+  }
+
+  static IStatistics::DailyStats make_day(int year, int month, int day, int value)
+  {
+    IStatistics::DailyStats stats{};
+    stats.start.tm_year = year - 1900;
+    stats.start.tm_mon = month - 1;
+    stats.start.tm_mday = day;
+    stats.start.tm_hour = 8;
+    stats.stop = stats.start;
+    stats.stop.tm_hour = 17;
+    stats.break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN] = value;
+    stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES] = 1000 * value;
+    return stats;
+  }
+
+  std::filesystem::path dir;
+};
+
+BOOST_FIXTURE_TEST_SUITE(history, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_store_round_trip)
+{
+  HistoryStore store(dir / "history.bin");
+  BOOST_CHECK(!store.exists());
+
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 1, 1)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 2, 2)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 3, 3)));
+
+  std::vector<IStatistics::DailyStats> days;
+  BOOST_REQUIRE(store.load(days));
+  BOOST_REQUIRE_EQUAL(days.size(), 3);
+  for (int i = 0; i < 3; i++)
+    {
+      BOOST_CHECK_EQUAL(HistoryStore::date_key(days[i].start), 20230101 + i);
+      BOOST_CHECK_EQUAL(days[i].stop.tm_hour, 17);
+      BOOST_CHECK_EQUAL(days[i].break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], i + 1);
+      BOOST_CHECK_EQUAL(days[i].misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 1000 * (i + 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_store_out_of_order)
+{
+  HistoryStore store(dir / "history.bin");
+  BOOST_REQUIRE(store.append(make_day(2023, 3, 1, 1)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 1, 2)));
+  BOOST_REQUIRE(store.append(make_day(2023, 3, 1, 3)));
+  BOOST_REQUIRE(store.append(make_day(2023, 2, 1, 4)));
+
+  std::vector<IStatistics::DailyStats> days;
+  BOOST_REQUIRE(store.load(days));
+  BOOST_REQUIRE_EQUAL(days.size(), 3);
+  BOOST_CHECK_EQUAL(HistoryStore::date_key(days[0].start), 20230101);
+  BOOST_CHECK_EQUAL(HistoryStore::date_key(days[1].start), 20230201);
+  BOOST_CHECK_EQUAL(HistoryStore::date_key(days[2].start), 20230301);
+
+  // The last record of a date wins.
+  BOOST_CHECK_EQUAL(days[2].break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_store_interrupted_append)
+{
+  std::filesystem::path path = dir / "history.bin";
+  HistoryStore store(path);
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 1, 1)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 2, 2)));
+
+  // Simulate a crash halfway through the second append.
+  auto size = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, size - 50);
+
+  std::vector<IStatistics::DailyStats> days;
+  BOOST_REQUIRE(store.load(days));
+  BOOST_CHECK_EQUAL(days.size(), 1);
+
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 3, 3)));
+  BOOST_REQUIRE(store.load(days));
+  BOOST_REQUIRE_EQUAL(days.size(), 2);
+  BOOST_CHECK_EQUAL(HistoryStore::date_key(days[1].start), 20230103);
+}
+
+BOOST_AUTO_TEST_CASE(test_arena)
+{
+  BOOST_CHECK(DailyStatsArena::day_number(1970, 1, 1) == 0);
+  BOOST_CHECK(DailyStatsArena::day_number(2000, 3, 1) == 11017);
+  BOOST_CHECK(!DailyStatsArena::day_number(1960, 1, 1));
+  BOOST_CHECK(!DailyStatsArena::day_number(2200, 1, 1));
+
+  DailyStatsArena arena;
+  arena.insert(make_day(2024, 3, 1, 3));
+  arena.insert(make_day(2024, 2, 29, 2));
+  arena.insert(make_day(2023, 12, 31, 1));
+
+  auto day = make_day(2024, 3, 1, 4);
+  day.stop.tm_min = 59;
+  day.misc_stats[IStatistics::STATS_VALUE_TOTAL_MOUSE_MOVEMENT] = 1LL << 40;
+  arena.insert(day);
+
+  // Out of range dates are not stored as 1970-01-01.
+  BOOST_CHECK(!arena.insert(make_day(1960, 1, 1, 5)));
+
+  BOOST_REQUIRE_EQUAL(arena.size(), 3);
+  BOOST_CHECK_EQUAL(arena.lower_bound(*DailyStatsArena::day_number(2024, 1, 1)), 1);
+  BOOST_CHECK_EQUAL(arena.upper_bound(*DailyStatsArena::day_number(2024, 2, 29)), 2);
+
+  IStatistics::DailyStats stats = arena[2].to_daily_stats();
+  BOOST_CHECK_EQUAL(stats.start.tm_year, 124);
+  BOOST_CHECK_EQUAL(stats.start.tm_mon, 2);
+  BOOST_CHECK_EQUAL(stats.start.tm_mday, 1);
+  BOOST_CHECK_EQUAL(stats.start.tm_hour, 8);
+  BOOST_CHECK_EQUAL(stats.stop.tm_hour, 17);
+  BOOST_CHECK_EQUAL(stats.stop.tm_min, 59);
+  BOOST_CHECK_EQUAL(stats.break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], 4);
+  BOOST_CHECK_EQUAL(stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 4000);
+  BOOST_CHECK_EQUAL(stats.misc_stats[IStatistics::STATS_VALUE_TOTAL_MOUSE_MOVEMENT], 0xffffffffLL);
+
+  BOOST_CHECK_EQUAL(arena[1].to_daily_stats().start.tm_mday, 29);
+
+  arena.clear();
+  BOOST_CHECK(arena.empty());
+  BOOST_CHECK_EQUAL(arena.memory_usage(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_intraday_series)
+{
+  IntradaySeries series;
+
+  // Only the first input of a second is counted.
+  series.add_activity(8 * 3600);
+  series.add_activity(8 * 3600);
+  series.add_activity(8 * 3600 + 1);
+  series.add_keystroke(8 * 3600);
+  series.add_click(8 * 3600 + 59);
+  series.add_movement(8 * 3600 + 60, 1000);
+  series.add_movement(8 * 3600 + 60, -5);
+
+  for (int s = 0; s < 70000; s++)
+    {
+      series.add_keystroke(23 * 3600);
+    }
+
+  auto samples = series.get_samples();
+  BOOST_REQUIRE_EQUAL(samples.size(), 3);
+  BOOST_CHECK_EQUAL(samples[0].minute, 8 * 60);
+  BOOST_CHECK_EQUAL(samples[0].active_seconds, 2);
+  BOOST_CHECK_EQUAL(samples[0].keystrokes, 1);
+  BOOST_CHECK_EQUAL(samples[0].clicks, 1);
+  BOOST_CHECK_EQUAL(samples[1].minute, 8 * 60 + 1);
+  BOOST_CHECK_EQUAL(samples[1].movement, 1000);
+  BOOST_CHECK_EQUAL(samples[2].keystrokes, 65535);
+
+  IntradaySeries copy;
+  BOOST_REQUIRE(copy.decode(series.encode()));
+  BOOST_CHECK(copy.encode() == series.encode());
+
+  std::vector<uint8_t> truncated = series.encode();
+  truncated.pop_back();
+  BOOST_CHECK(!copy.decode(truncated));
+  BOOST_CHECK(copy.get_samples().empty());
+
+  BOOST_REQUIRE(series.save(dir / "todayseries", 20000));
+  BOOST_CHECK(!copy.load(dir / "todayseries", 20001));
+  BOOST_REQUIRE(copy.load(dir / "todayseries", 20000));
+  BOOST_CHECK_EQUAL(copy.get_samples().size(), 3);
+
+  // A working day of eight hours with steady typing.
+  series.clear();
+  for (int s = 9 * 3600; s < 17 * 3600; s++)
+    {
+      series.add_activity(s);
+      if (s % 3 == 0)
+        {
+          series.add_keystroke(s);
+        }
+      if (s % 20 == 0)
+        {
+          series.add_click(s);
+          series.add_movement(s, 150);
+        }
+    }
+  BOOST_CHECK_EQUAL(series.get_samples().size(), 8 * 60);
+  BOOST_TEST_MESSAGE("Encoded working day: " << series.encode().size() << " bytes");
+  BOOST_CHECK_LE(series.encode().size(), 1500);
+}
+
+BOOST_AUTO_TEST_CASE(test_reader_concatenated)
+{
+  std::stringstream text(
+    "WorkRaveStats 4\n"
+    "D 1 0 123 8 0 1 0 123 17 0\n"
+    "B 1 7 0 1 0 0 0 0 0 \n"
+    "m 6 100 0 0 0 0 10 \n"
+    "WorkRaveStats 4\n"
+    "D 2 0 123 8 0 2 0 123 17 0\n"
+    "G 3600\n"
+    "\n"
+    "D 3 0 123 8 0 3 0 123 17 30\n"
+    "m 6 100 0 0 0 0 5000000000 \n");
+
+  StatisticsReader reader(text);
+  BOOST_REQUIRE(reader.is_valid());
+
+  IStatistics::DailyStats day{};
+  BOOST_REQUIRE(reader.next(day));
+  BOOST_CHECK_EQUAL(day.start.tm_mday, 1);
+  BOOST_CHECK_EQUAL(day.break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], 1);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 10);
+
+  BOOST_REQUIRE(reader.next(day));
+  BOOST_CHECK_EQUAL(day.start.tm_mday, 2);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME], 3600);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 0);
+
+  BOOST_REQUIRE(reader.next(day));
+  BOOST_CHECK_EQUAL(day.stop.tm_min, 30);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 5000000000LL);
+
+  BOOST_CHECK(!reader.next(day));
+
+  std::stringstream invalid("NotWorkRaveStats 4\n");
+  BOOST_CHECK(!StatisticsReader(invalid).is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(test_reader_shards)
+{
+  std::string_view text =
+    "WorkRaveStats 4\r\n"
+    "D 1 0 123 8 0 1 0 123 17 0\r\n"
+    "m 6 100 0 0 0 0 10 \r\n"
+    "D 2 0 123 8 0 2 0 123 17 0\r\n"
+    "m 6 100 0 0 0 0 20";
+
+  std::size_t split = text.find("\nD 2") + 1;
+  StatisticsReader first(text.substr(0, split));
+  StatisticsReader second(text.substr(split), false);
+  BOOST_REQUIRE(first.is_valid());
+  BOOST_REQUIRE(second.is_valid());
+
+  IStatistics::DailyStats day{};
+  BOOST_REQUIRE(first.next(day));
+  BOOST_CHECK_EQUAL(day.start.tm_mday, 1);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 10);
+  BOOST_CHECK(!first.next(day));
+
+  BOOST_REQUIRE(second.next(day));
+  BOOST_CHECK_EQUAL(day.start.tm_mday, 2);
+  BOOST_CHECK_EQUAL(day.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 20);
+  BOOST_CHECK(!second.next(day));
+
+  BOOST_CHECK(!StatisticsReader(text.substr(split)).is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_text_history)
+{
+  // Out of order, as produced by clock changes. The day in 1960 cannot be stored and is skipped.
+  const char *text =
+    "WorkRaveStats 4\n"
+    "D 1 0 60 8 0 1 0 60 17 0\n"
+    "B 1 7 0 9 0 0 0 0 0 \n"
+    "D 2 0 123 8 0 2 0 123 17 0\n"
+    "B 1 7 0 2 0 0 0 0 0 \n"
+    "m 6 100 0 0 0 0 20 \n"
+    "D 1 0 123 8 0 1 0 123 17 0\n"
+    "B 1 7 0 1 0 0 0 0 0 \n"
+    "m 6 100 0 0 0 0 10 \n"
+    "D 5 0 123 8 0 5 0 123 17 0\n"
+    "B 1 7 0 5 0 0 0 0 0 \n"
+    "m 6 100 0 0 0 0 50 \n";
+  {
+    std::ofstream file(dir / "historystats");
+    file << text;
+  }
+
+  auto monitor = std::make_shared<ActivityMonitorStub>();
+  {
+    Statistics statistics(monitor);
+    statistics.init();
+
+    BOOST_REQUIRE_EQUAL(statistics.get_history_size(), 3);
+    BOOST_CHECK(std::filesystem::exists(dir / "history.bin"));
+
+    // Index 3 is the oldest day.
+    BOOST_CHECK_EQUAL(statistics.get_day(3)->start.tm_mday, 1);
+    BOOST_CHECK_EQUAL(statistics.get_day(1)->start.tm_mday, 5);
+    BOOST_CHECK_EQUAL(statistics.get_day(2)->misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES], 20);
+
+    int idx = 0;
+    int next = 0;
+    int prev = 0;
+    statistics.get_day_index_by_date(2023, 1, 2, idx, next, prev);
+    BOOST_CHECK_EQUAL(idx, 2);
+    BOOST_CHECK_EQUAL(prev, 3);
+    BOOST_CHECK_EQUAL(next, 1);
+
+    statistics.get_day_index_by_date(2023, 1, 3, idx, next, prev);
+    BOOST_CHECK_EQUAL(idx, -1);
+    BOOST_CHECK_EQUAL(prev, 2);
+    BOOST_CHECK_EQUAL(next, 1);
+
+    statistics.get_day_index_by_date(2022, 12, 31, idx, next, prev);
+    BOOST_CHECK_EQUAL(idx, -1);
+    BOOST_CHECK_EQUAL(prev, -1);
+    BOOST_CHECK_EQUAL(next, 3);
+
+    statistics.get_day_index_by_date(2023, 1, 6, idx, next, prev);
+    BOOST_CHECK_EQUAL(idx, -1);
+    BOOST_CHECK_EQUAL(prev, 1);
+
+    std::stringstream exported;
+    statistics.export_history(exported);
+    BOOST_CHECK(exported.str().starts_with("WorkRaveStats 4\nD 1 0 123 8 0 1 0 123 17 0\n"));
+  }
+
+  // The binary history is used from now on.
+  std::filesystem::remove(dir / "historystats");
+  {
+    Statistics statistics(monitor);
+    statistics.init();
+    BOOST_CHECK_EQUAL(statistics.get_history_size(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_text_history_on_new_day)
+{
+  {
+    std::ofstream file(dir / "historystats");
+    file << "WorkRaveStats 4\n"
+            "D 1 0 123 8 0 1 0 123 17 0\n"
+            "D 2 0 123 8 0 2 0 123 17 0\n";
+  }
+  {
+    std::ofstream file(dir / "todaystats");
+    file << "WorkRaveStats 4\n"
+            "D 3 0 123 8 0 3 0 123 17 0\n";
+  }
+
+  // The first day rollover creates the store, which must not hide the text history.
+  auto monitor = std::make_shared<ActivityMonitorStub>();
+  {
+    Statistics statistics(monitor);
+    statistics.init();
+    statistics.start_new_day();
+    BOOST_CHECK_EQUAL(statistics.get_history_size(), 3);
+  }
+
+  std::filesystem::remove(dir / "historystats");
+  {
+    Statistics statistics(monitor);
+    statistics.init();
+    BOOST_REQUIRE_EQUAL(statistics.get_history_size(), 3);
+    BOOST_CHECK_EQUAL(statistics.get_day(3)->start.tm_mday, 1);
+    BOOST_CHECK_EQUAL(statistics.get_day(1)->start.tm_mday, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupt_store_is_moved_aside)
+{
+  {
+    std::ofstream file(dir / "historystats");
+    file << "WorkRaveStats 4\n"
+            "D 1 0 123 8 0 1 0 123 17 0\n";
+  }
+  {
+    std::ofstream file(dir / "history.bin");
+    file << "garbage";
+  }
+
+  // The stale text history must not replace the store.
+  auto monitor = std::make_shared<ActivityMonitorStub>();
+  Statistics statistics(monitor);
+  statistics.init();
+  BOOST_CHECK_EQUAL(statistics.get_history_size(), 0);
+  BOOST_CHECK(!std::filesystem::exists(dir / "history.bin"));
+  BOOST_CHECK(std::filesystem::exists(dir / "history.bin.corrupt"));
+}
+
+BOOST_AUTO_TEST_CASE(test_lazy_history)
+{
+  HistoryStore store(dir / "history.bin");
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 1, 1)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 2, 2)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 4, 4)));
+
+  auto monitor = std::make_shared<ActivityMonitorStub>();
+  Statistics statistics(monitor);
+  statistics.init();
+
+  // Queries are answered once the history is loaded in the background.
+  std::tm from{};
+  from.tm_year = 123;
+  from.tm_mon = 0;
+  from.tm_mday = 2;
+  std::tm to = from;
+  to.tm_mday = 31;
+  auto range = statistics.get_range_async(from, to);
+  auto day = statistics.get_day_async(3);
+  auto missing = statistics.get_day_async(4);
+
+  std::vector<IStatistics::DailyStats> days = range.get();
+  BOOST_REQUIRE_EQUAL(days.size(), 2);
+  BOOST_CHECK_EQUAL(days[0].start.tm_mday, 2);
+  BOOST_CHECK_EQUAL(days[1].start.tm_mday, 4);
+
+  auto stats = day.get();
+  BOOST_REQUIRE(stats.has_value());
+  BOOST_CHECK_EQUAL(stats->break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], 1);
+  BOOST_CHECK(!missing.get().has_value());
+
+  // Today does not depend on the history.
+  auto today = statistics.get_day_async(0);
+  BOOST_REQUIRE(today.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  BOOST_CHECK(today.get().has_value());
+
+  BOOST_CHECK_EQUAL(statistics.get_history_size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_aggregate)
+{
+  HistoryStore store(dir / "history.bin");
+  BOOST_REQUIRE(store.append(make_day(2022, 12, 31, 5)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 1, 1)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 2, 2)));
+  BOOST_REQUIRE(store.append(make_day(2023, 1, 9, 3)));
+  BOOST_REQUIRE(store.append(make_day(2023, 2, 1, 4)));
+
+  auto monitor = std::make_shared<ActivityMonitorStub>();
+  Statistics statistics(monitor);
+  statistics.init();
+
+  auto keystrokes = [](const IStatistics::StatsAggregate &aggregate) {
+    return aggregate.misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES];
+  };
+
+  // 2023-01-01 is a Sunday.
+  auto week = statistics.get_aggregate(IStatistics::StatsRange::Week, 2023, 1, 2, 1);
+  BOOST_CHECK_EQUAL(week.days, 1);
+  BOOST_CHECK_EQUAL(keystrokes(week), 2000);
+  BOOST_CHECK(!week.includes_today);
+
+  week = statistics.get_aggregate(IStatistics::StatsRange::Week, 2023, 1, 7, 0);
+  BOOST_CHECK_EQUAL(week.days, 2);
+  BOOST_CHECK_EQUAL(keystrokes(week), 3000);
+
+  auto month = statistics.get_aggregate(IStatistics::StatsRange::Month, 2023, 1, 15, 0);
+  BOOST_CHECK_EQUAL(month.days, 3);
+  BOOST_CHECK_EQUAL(keystrokes(month), 6000);
+  BOOST_CHECK_EQUAL(month.break_stats[BREAK_ID_REST_BREAK][IStatistics::STATS_BREAKVALUE_TAKEN], 6);
+
+  auto year = statistics.get_aggregate(IStatistics::StatsRange::Year, 2023, 6, 1, 0);
+  BOOST_CHECK_EQUAL(year.days, 4);
+  BOOST_CHECK_EQUAL(keystrokes(year), 10000);
+
+  auto empty = statistics.get_aggregate(IStatistics::StatsRange::Month, 2023, 3, 1, 0);
+  BOOST_CHECK_EQUAL(empty.days, 0);
+
+  auto all = statistics.get_aggregate(IStatistics::StatsRange::All, 2023, 1, 1, 0);
+  BOOST_CHECK_EQUAL(all.days, 6);
+  BOOST_CHECK(all.includes_today);
+  BOOST_CHECK_EQUAL(keystrokes(all), 15000 + statistics.get_current_day()->misc_stats[IStatistics::STATS_VALUE_TOTAL_KEYSTROKES]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,224 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Replays an input event trace into the input consumers of the core and
+// reports the throughput of the input path.
+//
+// Usage: workrave-core-next-input-benchmark [--realtime] [--events N] [trace-file]
+//
+// Without a trace file a synthetic trace of N events is generated. Traces
+// can be recorded by running Workrave with WORKRAVE_INPUT_TRACE=<file>.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+
+#include "config/ConfiguratorFactory.hh"
+#include "core/CoreConfig.hh"
+#include "input-monitor/InputEventTrace.hh"
+#include "input-monitor/InputMonitorFactory.hh"
+#include "utils/Paths.hh"
+#include "utils/TimeSource.hh"
+
+#include "LocalActivityMonitor.hh"
+#include "ReplayInputMonitor.hh"
+#include "Statistics.hh"
+#include "Timer.hh"
+#include "TimerActivityMonitor.hh"
+
+using namespace workrave;
+using namespace workrave::config;
+using namespace workrave::input_monitor;
+using namespace workrave::utils;
+
+//! Number of events replayed before the consumers process them.
+static constexpr std::size_t CHUNK_SIZE = 1024;
+
+static InputEventTrace
+create_synthetic_trace(std::size_t count)
+{
+  InputEventTrace trace;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> step(-8, 8);
+
+  int x = 500;
+  int y = 500;
+  int64_t time = TimeSource::get_monotonic_time_usec();
+
+  for (std::size_t i = 0; i < count; i++)
+    {
+      InputEvent event;
+      event.time_usec = time;
+      time += 1000;
+
+      if (i % 50 == 0)
+        {
+          event.type = InputEventType::Button;
+          event.flags = (i % 100 == 0) ? InputEvent::FLAG_PRESS : 0;
+        }
+      else if (i % 5 == 0)
+        {
+          event.type = InputEventType::Keyboard;
+          event.flags = (i % 15 == 0) ? InputEvent::FLAG_REPEAT : 0;
+        }
+      else
+        {
+          x = std::max(0, x + step(rng));
+          y = std::max(0, y + step(rng));
+          event.type = InputEventType::Mouse;
+          event.x = x;
+          event.y = y;
+        }
+      trace.add(event);
+    }
+  return trace;
+}
+
+static int64_t
+count_keystrokes(const InputEventTrace &trace)
+{
+  int64_t count = 0;
+  for (const auto &event: trace.get_events())
+    {
+      if (event.type == InputEventType::Keyboard && !event.is_repeat())
+        {
+          count++;
+        }
+    }
+  return count;
+}
+
+int
+main(int argc, char **argv)
+{
+  bool realtime = false;
+  std::size_t num_events = 1000000;
+  std::string trace_file;
+
+  for (int i = 1; i < argc; i++)
+    {
+      std::string arg = argv[i];
+      if (arg == "--realtime")
+        {
+          realtime = true;
+        }
+      else if (arg == "--events" && i + 1 < argc)
+        {
+          num_events = std::strtoul(argv[++i], nullptr, 10);
+        }
+      else
+        {
+          trace_file = arg;
+        }
+    }
+
+  InputEventTrace trace;
+  if (trace_file.empty())
+    {
+      trace = create_synthetic_trace(num_events);
+    }
+  else if (!trace.load(trace_file))
+    {
+      fprintf(stderr, "Cannot load trace %s\n", trace_file.c_str());
+      return 1;
+    }
+
+  auto state_dir = std::filesystem::temp_directory_path() / "workrave-input-benchmark";
+  std::filesystem::create_directories(state_dir);
+  Paths::set_portable_directory(state_dir.string());
+
+  IConfigurator::Ptr config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+  CoreConfig::init(config);
+
+  auto monitor = std::dynamic_pointer_cast<ReplayInputMonitor>(InputMonitorFactory::create_monitor(MonitorCapability::Activity));
+  if (monitor == nullptr)
+    {
+      fprintf(stderr, "Input monitor does not support replay\n");
+      return 1;
+    }
+
+  auto activity_monitor = std::make_shared<LocalActivityMonitor>(config, "");
+  activity_monitor->init();
+
+  auto statistics = std::make_shared<Statistics>(activity_monitor);
+  statistics->init();
+  statistics->set_counter(IStatistics::STATS_VALUE_TOTAL_KEYSTROKES, 0);
+
+  auto timer = std::make_shared<Timer>("micro_pause");
+  TimerActivityMonitor timer_activity_monitor(activity_monitor, timer);
+
+  const auto &events = trace.get_events();
+  std::span<const InputEvent> remaining(events);
+
+  auto start = std::chrono::steady_clock::now();
+  while (!remaining.empty())
+    {
+      auto chunk = remaining.first(std::min(CHUNK_SIZE, remaining.size()));
+      remaining = remaining.subspan(chunk.size());
+
+      monitor->replay(chunk, realtime);
+      statistics->process_input_events();
+      timer_activity_monitor.is_active();
+    }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  InputEventCounters counters = monitor->get_event_counters();
+  double ns_per_event = events.empty() ? 0.0 : elapsed * 1e9 / static_cast<double>(events.size());
+
+  printf("events:      %zu\n", events.size());
+  printf("time:        %.3f s\n", elapsed);
+  printf("events/s:    %.0f\n", elapsed > 0 ? static_cast<double>(events.size()) / elapsed : 0.0);
+  printf("ns/event:    %.1f\n", ns_per_event);
+  printf("queued:      %llu\n", static_cast<unsigned long long>(counters.queued));
+  printf("dropped:     %llu\n", static_cast<unsigned long long>(counters.dropped));
+  printf("coalesced:   %llu\n", static_cast<unsigned long long>(counters.coalesced));
+
+  // Listener callbacks per minute of trace time, with and without debouncing.
+  double trace_minutes = events.empty() ? 0.0 : static_cast<double>(events.back().time_usec - events.front().time_usec) / 60e6;
+  if (trace_minutes > 0)
+    {
+      printf("notified/m:  %.0f\n", static_cast<double>(counters.notified) / trace_minutes);
+      printf("undebounced: %.0f\n", static_cast<double>(counters.notified + counters.suppressed) / trace_minutes);
+    }
+
+  int64_t keystrokes = statistics->get_counter(IStatistics::STATS_VALUE_TOTAL_KEYSTROKES);
+  int64_t expected = count_keystrokes(trace);
+  bool ok = counters.dropped == 0 && keystrokes == expected;
+
+  statistics.reset();
+  activity_monitor->terminate();
+
+  if (!ok)
+    {
+      fprintf(stderr,
+              "Replay mismatch: %lld keystrokes counted, %lld expected\n",
+              static_cast<long long>(keystrokes),
+              static_cast<long long>(expected));
+      return 1;
+    }
+  return 0;
+}
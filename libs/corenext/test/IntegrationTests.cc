@@ -1463,6 +1463,76 @@ BOOST_AUTO_TEST_CASE(test_user_active)
   verify();
 }
 
+BOOST_AUTO_TEST_CASE(test_user_idle_next_heartbeat_time)
+{
+  init();
+
+  int wakeups = 0;
+  boost::signals2::scoped_connection c = core->signal_wakeup().connect([&wakeups]() { wakeups++; });
+
+  tick(true, 100);
+  BOOST_CHECK_EQUAL(core->get_next_heartbeat_time(), TimeSource::get_monotonic_time_sec_sync());
+
+  tick(false, 10);
+  int64_t delay = core->get_next_heartbeat_time() - TimeSource::get_monotonic_time_sec_sync();
+  BOOST_CHECK_GT(delay, 1);
+  BOOST_CHECK_LE(delay, 20);
+
+  tick(false, 400);
+  BOOST_CHECK_GT(core->get_next_heartbeat_time(), TimeSource::get_monotonic_time_sec_sync() + 60);
+
+  wakeups = 0;
+  tick(true, 1);
+  BOOST_CHECK_GE(wakeups, 1);
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      auto b = core->get_break(BreakId(i));
+      BOOST_CHECK(b->is_running());
+    }
+
+  verify();
+}
+
+BOOST_AUTO_TEST_CASE(test_user_idle_scheduled_heartbeats)
+{
+  init();
+
+  bool wakeup = false;
+  boost::signals2::scoped_connection c = core->signal_wakeup().connect([&wakeup]() { wakeup = true; });
+
+  tick(false, 10);
+
+  // Run the heartbeat the way the toolkit timer does: at the next heartbeat time, or at once on a wakeup.
+  int ticks = 0;
+  int64_t end = TimeSource::get_monotonic_time_sec_sync() + 3600;
+  while (TimeSource::get_monotonic_time_sec_sync() < end)
+    {
+      wakeup = false;
+      core->heartbeat();
+      ticks++;
+
+      int64_t delay = wakeup ? 0 : std::max<int64_t>(core->get_next_heartbeat_time() - TimeSource::get_monotonic_time_sec_sync(), 1);
+      sim->current_time += delay * 1000000;
+      TimeSource::sync();
+    }
+
+  BOOST_TEST_MESSAGE("heartbeats while idle for an hour: " << ticks);
+  BOOST_CHECK_LT(ticks, 60);
+
+  monitor->set_active(true);
+  BOOST_CHECK(wakeup);
+  core->heartbeat();
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      auto b = core->get_break(BreakId(i));
+      BOOST_CHECK(b->is_running());
+    }
+
+  verify();
+}
+
 BOOST_AUTO_TEST_CASE(test_user_ignores_first_prelude)
 {
   init();
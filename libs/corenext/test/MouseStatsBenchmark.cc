@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Compares the per-event mouse statistics code with the batched kernels.
+//
+// Usage: workrave-core-next-mouse-stats-benchmark [samples]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "MouseStatsAccumulator.hh"
+
+using namespace workrave::input_monitor;
+
+static std::vector<InputEvent>
+create_motion(std::size_t count)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> step(-12, 12);
+
+  std::vector<InputEvent> events(count);
+  int x = 1000;
+  int y = 1000;
+  for (std::size_t i = 0; i < count; i++)
+    {
+      x = std::max(0, x + step(rng));
+      y = std::max(0, y + step(rng));
+      events[i].type = InputEventType::Mouse;
+      events[i].x = x;
+      events[i].y = y;
+      events[i].time_usec = static_cast<int64_t>(i) * 1000;
+    }
+  return events;
+}
+
+//! The per-event code that Statistics used before the accumulator.
+static int64_t
+per_event(std::span<const InputEvent> events)
+{
+  int prev_x = -1;
+  int prev_y = -1;
+  int64_t last_mouse_time = 0;
+  int64_t movement = 0;
+  int64_t movement_time = 0;
+
+  for (const auto &event: events)
+    {
+      int delta_x = 3;
+      int delta_y = 3;
+      if (prev_x != -1 && prev_y != -1)
+        {
+          delta_x = abs(event.x - prev_x);
+          delta_y = abs(event.y - prev_y);
+        }
+      prev_x = event.x;
+      prev_y = event.y;
+
+      if (delta_x < 10000 && delta_y < 10000 && (delta_x >= 3 || delta_y >= 3 || event.wheel != 0))
+        {
+          movement += int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
+          int64_t tv = event.time_usec - last_mouse_time;
+          if (tv < 1000000)
+            {
+              movement_time += tv;
+            }
+          last_mouse_time = event.time_usec;
+        }
+    }
+  return movement + movement_time;
+}
+
+static int64_t
+batched(std::span<const InputEvent> events, MouseStatsAccumulator::Kernel kernel)
+{
+  MouseStatsAccumulator accumulator;
+  accumulator.set_kernel(kernel);
+
+  for (std::size_t i = 0; i < events.size(); i += 1024)
+    {
+      accumulator.add(events.subspan(i, std::min<std::size_t>(1024, events.size() - i)));
+    }
+  return accumulator.take_movement() + accumulator.take_movement_time();
+}
+
+//! Returns the best time of several runs.
+template<typename F>
+static double
+measure_ns_per_sample(std::size_t count, int64_t &result, F func)
+{
+  double best = 0;
+  for (int run = 0; run < 5; run++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      result = func();
+      auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      best = (run == 0) ? elapsed : std::min(best, elapsed);
+    }
+  return best / static_cast<double>(count);
+}
+
+int
+main(int argc, char **argv)
+{
+  std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  std::vector<InputEvent> events = create_motion(count);
+
+  int64_t expected = 0;
+  double reference = measure_ns_per_sample(count, expected, [&] { return per_event(events); });
+  printf("%-10s %6.2f ns/sample\n", "per-event", reference);
+
+  const std::pair<const char *, MouseStatsAccumulator::Kernel> kernels[] = {
+    {"scalar", MouseStatsAccumulator::Kernel::Scalar},
+    {"sse2", MouseStatsAccumulator::Kernel::SSE2},
+    {"avx2", MouseStatsAccumulator::Kernel::AVX2},
+  };
+
+  int ret = 0;
+  for (const auto &[name, kernel]: kernels)
+    {
+      if (kernel > MouseStatsAccumulator::get_best_kernel())
+        {
+          printf("%-10s unsupported\n", name);
+          continue;
+        }
+
+      int64_t result = 0;
+      double ns = measure_ns_per_sample(count, result, [&] { return batched(events, kernel); });
+      printf("%-10s %6.2f ns/sample, %.2fx\n", name, ns, reference / ns);
+
+      if (result != expected)
+        {
+          printf("%-10s result mismatch\n", name);
+          ret = 1;
+        }
+    }
+  return ret;
+}
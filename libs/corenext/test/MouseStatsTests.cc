@@ -0,0 +1,232 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_mouse_stats
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "MouseStatsAccumulator.hh"
+
+using namespace workrave::input_monitor;
+
+//! The original per-event implementation of Statistics::mouse_notify.
+class ReferenceMouseStats
+{
+public:
+  void mouse_notify(const InputEvent &event)
+  {
+    static const int sensitivity = 3;
+    int x = event.x;
+    int y = event.y;
+
+    if (event.type != InputEventType::Mouse || x < 0 || y < 0)
+      {
+        return;
+      }
+
+    int delta_x = sensitivity;
+    int delta_y = sensitivity;
+
+    if (prev_x != -1 && prev_y != -1)
+      {
+        delta_x = abs(x - prev_x);
+        delta_y = abs(y - prev_y);
+      }
+
+    prev_x = x;
+    prev_y = y;
+
+    if (delta_x < 10000 && delta_y < 10000 && (delta_x >= sensitivity || delta_y >= sensitivity || event.wheel != 0))
+      {
+        int distance = int(sqrt(static_cast<double>(delta_x * delta_x + delta_y * delta_y)));
+        movement += distance;
+
+        auto tv = std::chrono::microseconds(event.time_usec - last_mouse_time);
+        if (tv < std::chrono::seconds(1))
+          {
+            total_mouse_time += tv;
+            movement_time = std::chrono::duration_cast<std::chrono::seconds>(total_mouse_time.time_since_epoch()).count();
+          }
+        last_mouse_time = event.time_usec;
+      }
+  }
+
+  int64_t movement{0};
+  int64_t movement_time{0};
+
+private:
+  int prev_x{-1};
+  int prev_y{-1};
+  int64_t last_mouse_time{0};
+  std::chrono::system_clock::time_point total_mouse_time;
+};
+
+static std::vector<InputEvent>
+create_events(std::size_t count, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> kind(0, 99);
+  std::uniform_int_distribution<int> step(-40, 40);
+  std::uniform_int_distribution<int> interval(0, 20000);
+
+  std::vector<InputEvent> events;
+  int x = 100;
+  int y = 100;
+  int64_t time = 1000000;
+
+  for (std::size_t i = 0; i < count; i++)
+    {
+      InputEvent event;
+      int k = kind(rng);
+
+      time += (k == 0) ? 2000000 : interval(rng);
+      event.time_usec = time;
+      event.type = InputEventType::Mouse;
+
+      if (k < 5)
+        {
+          event.type = (k < 3) ? InputEventType::Keyboard : InputEventType::Button;
+        }
+      else if (k < 8)
+        {
+          x = std::abs(x + 20000);
+        }
+      else if (k < 10)
+        {
+          event.wheel = static_cast<int16_t>((k == 8) ? 1 : -1);
+        }
+      else if (k < 12)
+        {
+          // Invalid positions are ignored.
+          event.x = -1;
+          event.y = 10;
+          events.push_back(event);
+          continue;
+        }
+      else if (k < 20)
+        {
+          x += k % 3;
+        }
+      else
+        {
+          x = std::max(0, x + step(rng));
+          y = std::max(0, y + step(rng));
+        }
+
+      event.x = x;
+      event.y = y;
+      events.push_back(event);
+    }
+  return events;
+}
+
+static void
+check_kernel(MouseStatsAccumulator::Kernel kernel, unsigned int seed)
+{
+  std::vector<InputEvent> events = create_events(20000, seed);
+
+  ReferenceMouseStats reference;
+  for (const auto &event: events)
+    {
+      reference.mouse_notify(event);
+    }
+
+  MouseStatsAccumulator accumulator;
+  accumulator.set_kernel(kernel);
+
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<std::size_t> batch_size(0, 700);
+
+  int64_t movement = 0;
+  std::chrono::system_clock::time_point total_mouse_time;
+  int64_t movement_time = 0;
+
+  std::span<const InputEvent> remaining(events);
+  while (!remaining.empty())
+    {
+      auto batch = remaining.first(std::min(batch_size(rng), remaining.size()));
+      remaining = remaining.subspan(batch.size());
+
+      accumulator.add(batch);
+      movement += accumulator.take_movement();
+      if (accumulator.has_movement_time())
+        {
+          total_mouse_time += std::chrono::microseconds(accumulator.take_movement_time());
+          movement_time = std::chrono::duration_cast<std::chrono::seconds>(total_mouse_time.time_since_epoch()).count();
+        }
+    }
+
+  BOOST_CHECK_GT(reference.movement, 0);
+  BOOST_CHECK_EQUAL(movement, reference.movement);
+  BOOST_CHECK_EQUAL(movement_time, reference.movement_time);
+}
+
+BOOST_AUTO_TEST_SUITE(mouse_stats)
+
+BOOST_AUTO_TEST_CASE(test_scalar_matches_per_event)
+{
+  for (unsigned int seed = 1; seed <= 5; seed++)
+    {
+      check_kernel(MouseStatsAccumulator::Kernel::Scalar, seed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sse2_matches_per_event)
+{
+  for (unsigned int seed = 1; seed <= 5; seed++)
+    {
+      check_kernel(MouseStatsAccumulator::Kernel::SSE2, seed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_avx2_matches_per_event)
+{
+  for (unsigned int seed = 1; seed <= 5; seed++)
+    {
+      check_kernel(MouseStatsAccumulator::Kernel::AVX2, seed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_first_sample)
+{
+  MouseStatsAccumulator accumulator;
+
+  InputEvent event;
+  event.type = InputEventType::Mouse;
+  event.x = 10;
+  event.y = 10;
+  event.time_usec = 100;
+  accumulator.add({&event, 1});
+
+  // Without a previous position, the first sample moved sqrt(3^2 + 3^2) pixels.
+  BOOST_CHECK_EQUAL(accumulator.take_movement(), 4);
+  BOOST_CHECK_EQUAL(accumulator.get_prev_x(), 10);
+  BOOST_CHECK_EQUAL(accumulator.get_prev_y(), 10);
+  BOOST_CHECK(accumulator.has_movement_time());
+  BOOST_CHECK_EQUAL(accumulator.take_movement_time(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,181 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_timer_state_store
+#include <boost/test/unit_test.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "TimerStateStore.hh"
+
+struct Fixture
+{
+  Fixture()
+  {
+    dir = std::filesystem::temp_directory_path() / "workrave-timer-state-test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    path = dir / "timers.state";
+  }
+
+  ~Fixture()
+  {
+    std::filesystem::remove_all(dir);
+  }
+
+  static std::vector<TimerStateStore::Entry> make_entries(int64_t elapsed)
+  {
+    std::vector<TimerStateStore::Entry> entries;
+    for (const char *id: {"micro_pause", "rest_break", "daily_limit"})
+      {
+        TimerStateStore::Entry entry;
+        entry.id = id;
+        entry.state.save_time = 1700000000;
+        entry.state.elapsed = elapsed;
+        entry.state.last_reset = 1690000000;
+        entry.state.overdue = 2 * elapsed;
+        entry.state.elapsed_at_last_limit = elapsed / 2;
+        entry.state.snooze_inhibited = elapsed % 2 == 1;
+        entries.push_back(entry);
+        elapsed++;
+      }
+    return entries;
+  }
+
+  static void check_entries(const std::vector<TimerStateStore::Entry> &actual, const std::vector<TimerStateStore::Entry> &expected)
+  {
+    BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); i++)
+      {
+        BOOST_CHECK_EQUAL(actual[i].id, expected[i].id);
+        BOOST_CHECK_EQUAL(actual[i].state.save_time, expected[i].state.save_time);
+        BOOST_CHECK_EQUAL(actual[i].state.elapsed, expected[i].state.elapsed);
+        BOOST_CHECK_EQUAL(actual[i].state.last_reset, expected[i].state.last_reset);
+        BOOST_CHECK_EQUAL(actual[i].state.overdue, expected[i].state.overdue);
+        BOOST_CHECK_EQUAL(actual[i].state.elapsed_at_last_limit, expected[i].state.elapsed_at_last_limit);
+        BOOST_CHECK_EQUAL(actual[i].state.snooze_inhibited, expected[i].state.snooze_inhibited);
+      }
+  }
+
+  //! Flips a byte in the slot that was written last.
+  void corrupt_newest_slot(std::size_t slot_offset)
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(static_cast<std::streamoff>(slot_offset));
+    char c = 0;
+    file.read(&c, 1);
+    c ^= 0x55;
+    file.seekp(static_cast<std::streamoff>(slot_offset));
+    file.write(&c, 1);
+  }
+
+  std::filesystem::path dir;
+  std::filesystem::path path;
+};
+
+BOOST_FIXTURE_TEST_SUITE(timer_state_store, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_empty)
+{
+  TimerStateStore store(path);
+  std::vector<TimerStateStore::Entry> entries;
+  BOOST_CHECK(!store.load(entries));
+  BOOST_CHECK(!std::filesystem::exists(path));
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip)
+{
+  auto expected = make_entries(100);
+  {
+    TimerStateStore store(path);
+    BOOST_REQUIRE(store.save(make_entries(1)));
+    BOOST_REQUIRE(store.save(expected));
+  }
+
+  auto size = std::filesystem::file_size(path);
+
+  TimerStateStore store(path);
+  std::vector<TimerStateStore::Entry> entries;
+  BOOST_REQUIRE(store.load(entries));
+  check_entries(entries, expected);
+
+  // Updates are in place.
+  for (int i = 0; i < 10; i++)
+    {
+      BOOST_REQUIRE(store.save(make_entries(200 + i)));
+    }
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(path), size);
+
+  BOOST_REQUIRE(store.load(entries));
+  check_entries(entries, make_entries(209));
+}
+
+BOOST_AUTO_TEST_CASE(test_torn_write_falls_back)
+{
+  {
+    TimerStateStore store(path);
+    BOOST_REQUIRE(store.save(make_entries(1)));
+    BOOST_REQUIRE(store.save(make_entries(2)));
+  }
+
+  // The second save went to the second slot. Damage its first record.
+  auto size = std::filesystem::file_size(path);
+  std::size_t slot_size = (size - 16) / 2;
+  corrupt_newest_slot(16 + slot_size + 20);
+
+  TimerStateStore store(path);
+  std::vector<TimerStateStore::Entry> entries;
+  BOOST_REQUIRE(store.load(entries));
+  check_entries(entries, make_entries(1));
+
+  // The next save replaces the damaged slot.
+  BOOST_REQUIRE(store.save(make_entries(3)));
+  BOOST_REQUIRE(store.load(entries));
+  check_entries(entries, make_entries(3));
+}
+
+BOOST_AUTO_TEST_CASE(test_unknown_layout)
+{
+  {
+    std::ofstream file(path);
+    file << "WorkRaveState 3\n";
+  }
+
+  TimerStateStore store(path);
+  std::vector<TimerStateStore::Entry> entries;
+  BOOST_CHECK(!store.load(entries));
+
+  BOOST_REQUIRE(store.save(make_entries(5)));
+  BOOST_REQUIRE(store.load(entries));
+  check_entries(entries, make_entries(5));
+}
+
+BOOST_AUTO_TEST_CASE(test_too_many_timers)
+{
+  TimerStateStore store(path);
+  std::vector<TimerStateStore::Entry> entries(TimerStateStore::MAX_TIMERS + 1);
+  BOOST_CHECK(!store.save(entries));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,406 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Exports the statistics history as CSV, JSON Lines or a columnar binary format.
+//
+// Usage: workrave-stats [--format csv|jsonl|columnar] [--from YYYY-MM-DD] [--to YYYY-MM-DD] [--output FILE] [FILE...]
+//
+// Text files are streamed one day at a time, in constant memory. A history.bin is loaded whole, to
+// sort it and keep only the last record of each date as Workrave does; that takes a few hundred bytes per day.
+// Without files, the history and today's statistics of the current user are exported.
+//
+// The columnar format consists of:
+//   - the magic "WRSC", a uint32 version and a uint32 column count,
+//   - the NUL-terminated column names,
+//   - blocks of a uint32 row count followed by the int64 values of each column in turn,
+//   - an empty block.
+// Integers are in host byte order. Times are encoded as yyyymmddHHMM.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "utils/Paths.hh"
+
+#include "HistoryStore.hh"
+#include "StatisticsReader.hh"
+
+using namespace workrave;
+using namespace workrave::utils;
+
+namespace po = boost::program_options;
+
+using DailyStats = IStatistics::DailyStats;
+
+namespace
+{
+  constexpr int TIME_COLUMNS = 2;
+  constexpr int COLUMN_COUNT = TIME_COLUMNS + BREAK_ID_SIZEOF * IStatistics::STATS_BREAKVALUE_SIZEOF + IStatistics::STATS_VALUE_SIZEOF;
+
+  std::vector<std::string> column_names()
+  {
+    const char *breaks[] = {"microbreak", "restbreak", "dailylimit"};
+    const char *break_values[] = {"prompted", "taken", "natural_taken", "skipped", "postponed", "unique_breaks", "total_overdue"};
+    const char *misc_values[] = {"active_time", "mouse_movement", "click_movement", "movement_time", "clicks", "keystrokes"};
+
+    std::vector<std::string> names{"start", "stop"};
+    for (const char *b: breaks)
+      {
+        for (const char *v: break_values)
+          {
+            names.push_back(std::string(b) + "_" + v);
+          }
+      }
+    for (const char *v: misc_values)
+      {
+        names.emplace_back(v);
+      }
+    return names;
+  }
+
+  int64_t encode_time(const struct tm &t)
+  {
+    return ((((t.tm_year + 1900) * 100LL + t.tm_mon + 1) * 100 + t.tm_mday) * 100 + t.tm_hour) * 100 + t.tm_min;
+  }
+
+  std::string format_time(const struct tm &t)
+  {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d", t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min);
+    return buf;
+  }
+
+  //! Returns the values of all columns after the time columns.
+  void counter_values(const DailyStats &day, int64_t *values)
+  {
+    for (int b = 0; b < BREAK_ID_SIZEOF; b++)
+      {
+        for (int v = 0; v < IStatistics::STATS_BREAKVALUE_SIZEOF; v++)
+          {
+            *values++ = day.break_stats[b][v];
+          }
+      }
+    for (int v = 0; v < IStatistics::STATS_VALUE_SIZEOF; v++)
+      {
+        *values++ = day.misc_stats[v];
+      }
+  }
+
+  class Writer
+  {
+  public:
+    explicit Writer(std::ostream &out)
+      : out(out)
+    {
+    }
+    virtual ~Writer() = default;
+
+    virtual void write(const DailyStats &day) = 0;
+    virtual void finish()
+    {
+    }
+
+  protected:
+    std::ostream &out;
+    const std::vector<std::string> names{column_names()};
+  };
+
+  class CsvWriter : public Writer
+  {
+  public:
+    explicit CsvWriter(std::ostream &out)
+      : Writer(out)
+    {
+      for (std::size_t i = 0; i < names.size(); i++)
+        {
+          out << (i == 0 ? "" : ",") << names[i];
+        }
+      out << '\n';
+    }
+
+    void write(const DailyStats &day) override
+    {
+      int64_t values[COLUMN_COUNT - TIME_COLUMNS];
+      counter_values(day, values);
+
+      out << format_time(day.start) << ',' << format_time(day.stop);
+      for (int64_t value: values)
+        {
+          out << ',' << value;
+        }
+      out << '\n';
+    }
+  };
+
+  class JsonLinesWriter : public Writer
+  {
+  public:
+    using Writer::Writer;
+
+    void write(const DailyStats &day) override
+    {
+      int64_t values[COLUMN_COUNT - TIME_COLUMNS];
+      counter_values(day, values);
+
+      out << R"({"start":")" << format_time(day.start) << R"(","stop":")" << format_time(day.stop) << '"';
+      for (int i = 0; i < COLUMN_COUNT - TIME_COLUMNS; i++)
+        {
+          out << ",\"" << names[TIME_COLUMNS + i] << "\":" << values[i];
+        }
+      out << "}\n";
+    }
+  };
+
+  class ColumnarWriter : public Writer
+  {
+  public:
+    explicit ColumnarWriter(std::ostream &out)
+      : Writer(out)
+      , columns(COLUMN_COUNT)
+    {
+      out.write("WRSC", 4);
+      write_uint32(VERSION);
+      write_uint32(COLUMN_COUNT);
+      for (const auto &name: names)
+        {
+          out.write(name.c_str(), static_cast<std::streamsize>(name.size() + 1));
+        }
+
+      for (auto &column: columns)
+        {
+          column.reserve(BLOCK_SIZE);
+        }
+    }
+
+    void write(const DailyStats &day) override
+    {
+      int64_t values[COLUMN_COUNT];
+      values[0] = encode_time(day.start);
+      values[1] = encode_time(day.stop);
+      counter_values(day, values + TIME_COLUMNS);
+
+      for (int i = 0; i < COLUMN_COUNT; i++)
+        {
+          columns[i].push_back(values[i]);
+        }
+      if (columns[0].size() == BLOCK_SIZE)
+        {
+          flush();
+        }
+    }
+
+    void finish() override
+    {
+      flush();
+      write_uint32(0);
+    }
+
+  private:
+    void flush()
+    {
+      if (columns[0].empty())
+        {
+          return;
+        }
+
+      write_uint32(static_cast<uint32_t>(columns[0].size()));
+      for (auto &column: columns)
+        {
+          out.write(reinterpret_cast<const char *>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(int64_t)));
+          column.clear();
+        }
+    }
+
+    void write_uint32(uint32_t value)
+    {
+      out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+  private:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr std::size_t BLOCK_SIZE = 4096;
+    std::vector<std::vector<int64_t>> columns;
+  };
+
+  int parse_date(const std::string &date)
+  {
+    int y = 0;
+    int m = 0;
+    int d = 0;
+    if (sscanf(date.c_str(), "%d-%d-%d", &y, &m, &d) != 3)
+      {
+        throw po::validation_error(po::validation_error::invalid_option_value, date);
+      }
+    return HistoryStore::date_key(y, m, d);
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  std::string format;
+  std::string from;
+  std::string to;
+  std::string output;
+  std::vector<std::string> files;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "Show this help");
+  options.add_options()("format,f", po::value<std::string>(&format)->default_value("csv"), "Output format: csv, jsonl or columnar");
+  options.add_options()("from", po::value<std::string>(&from), "Only export days from this date (YYYY-MM-DD)");
+  options.add_options()("to", po::value<std::string>(&to), "Only export days up to and including this date (YYYY-MM-DD)");
+  options.add_options()("output,o", po::value<std::string>(&output), "Write to this file instead of standard output");
+  options.add_options()("input", po::value<std::vector<std::string>>(&files), "historystats, todaystats or history.bin files, - for standard input");
+
+  po::positional_options_description positional;
+  positional.add("input", -1);
+
+  int from_key = 0;
+  int to_key = 99999999;
+  try
+    {
+      po::variables_map vm;
+      po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+      po::notify(vm);
+
+      if (vm.count("help") > 0)
+        {
+          std::cout << "Usage: workrave-stats [options] [FILE...]\n" << options;
+          return 0;
+        }
+      if (!from.empty())
+        {
+          from_key = parse_date(from);
+        }
+      if (!to.empty())
+        {
+          to_key = parse_date(to);
+        }
+    }
+  catch (po::error &e)
+    {
+      std::cerr << "workrave-stats: " << e.what() << "\n";
+      return 1;
+    }
+
+  // Before the output is truncated.
+  if (format != "csv" && format != "jsonl" && format != "columnar")
+    {
+      std::cerr << "workrave-stats: unknown format " << format << "\n";
+      return 1;
+    }
+
+  if (files.empty())
+    {
+      std::filesystem::path dir = Paths::get_state_directory();
+      files.push_back((dir / (HistoryStore(dir / "history.bin").exists() ? "history.bin" : "historystats")).string());
+      files.push_back((dir / "todaystats").string());
+    }
+
+  std::ofstream output_file;
+  if (!output.empty())
+    {
+      output_file.open(output, std::ios::binary | std::ios::trunc);
+      if (!output_file)
+        {
+          std::cerr << "workrave-stats: cannot write " << output << "\n";
+          return 1;
+        }
+    }
+  std::ostream &out = output.empty() ? std::cout : output_file;
+
+  std::unique_ptr<Writer> writer;
+  if (format == "csv")
+    {
+      writer = std::make_unique<CsvWriter>(out);
+    }
+  else if (format == "jsonl")
+    {
+      writer = std::make_unique<JsonLinesWriter>(out);
+    }
+  else
+    {
+      writer = std::make_unique<ColumnarWriter>(out);
+    }
+
+  auto export_day = [&](const DailyStats &day) {
+    int key = HistoryStore::date_key(day.start);
+    if (key >= from_key && key <= to_key)
+      {
+        writer->write(day);
+      }
+    return true;
+  };
+
+  int ret = 0;
+  for (const auto &file: files)
+    {
+      if (file != "-" && HistoryStore::is_history_store(file))
+        {
+          // Sorted, and with only the last record of each date, as Workrave loads it.
+          std::vector<DailyStats> days;
+          if (!HistoryStore(file).load(days))
+            {
+              std::cerr << "workrave-stats: cannot read " << file << "\n";
+              ret = 1;
+              continue;
+            }
+          for (const auto &day: days)
+            {
+              export_day(day);
+            }
+          continue;
+        }
+
+      std::ifstream input_file;
+      if (file != "-")
+        {
+          input_file.open(file);
+        }
+      std::istream &in = (file == "-") ? std::cin : input_file;
+
+      StatisticsReader reader(in);
+      if (!reader.is_valid())
+        {
+          std::cerr << "workrave-stats: cannot read " << file << "\n";
+          ret = 1;
+          continue;
+        }
+
+      DailyStats day{};
+      while (reader.next(day))
+        {
+          export_day(day);
+        }
+    }
+
+  writer->finish();
+  out.flush();
+  return out.good() ? ret : 1;
+}
@@ -0,0 +1,510 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Aggregates the statistics history of many workstations into organisation-wide percentiles.
+//
+// Usage: workrave-stats-aggregate [--threads N] DIR|FILE...
+//
+// Each historystats file is mapped into memory. Large files are split into shards at the start
+// of a day. Files and shards are parsed on a work-stealing thread pool: every worker owns a queue,
+// takes work from the front of its own queue and steals from the back of the others. A worker
+// that finds no work sleeps until another worker queues shards or all work is done.
+//
+// Every worker collects the per-day values in its own log-bucketed histograms, which are merged
+// once all work is done. Values below 16 are exact, larger values are rounded down to within
+// 1/16 (6%), so the reported percentiles are approximate. Means and maxima are exact.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/program_options.hpp>
+
+#include "StatisticsReader.hh"
+
+using namespace workrave;
+
+namespace po = boost::program_options;
+namespace ip = boost::interprocess;
+
+using DailyStats = IStatistics::DailyStats;
+
+namespace
+{
+  //! Files larger than this are split into shards of about this size.
+  constexpr std::size_t SHARD_SIZE = 4 * 1024 * 1024;
+
+  struct Metric
+  {
+    const char *name;
+    int64_t (*value)(const DailyStats &day);
+  };
+
+  template<BreakId id, IStatistics::StatsBreakValueType type>
+  int64_t break_value(const DailyStats &day)
+  {
+    return day.break_stats[id][type];
+  }
+
+  template<IStatistics::StatsValueType type>
+  int64_t misc_value(const DailyStats &day)
+  {
+    return day.misc_stats[type];
+  }
+
+  const std::array metrics{
+    Metric{"microbreak_taken", break_value<BREAK_ID_MICRO_BREAK, IStatistics::STATS_BREAKVALUE_TAKEN>},
+    Metric{"microbreak_skipped", break_value<BREAK_ID_MICRO_BREAK, IStatistics::STATS_BREAKVALUE_SKIPPED>},
+    Metric{"microbreak_postponed", break_value<BREAK_ID_MICRO_BREAK, IStatistics::STATS_BREAKVALUE_POSTPONED>},
+    Metric{"restbreak_taken", break_value<BREAK_ID_REST_BREAK, IStatistics::STATS_BREAKVALUE_TAKEN>},
+    Metric{"restbreak_skipped", break_value<BREAK_ID_REST_BREAK, IStatistics::STATS_BREAKVALUE_SKIPPED>},
+    Metric{"restbreak_postponed", break_value<BREAK_ID_REST_BREAK, IStatistics::STATS_BREAKVALUE_POSTPONED>},
+    Metric{"dailylimit_taken", break_value<BREAK_ID_DAILY_LIMIT, IStatistics::STATS_BREAKVALUE_TAKEN>},
+    Metric{"dailylimit_skipped", break_value<BREAK_ID_DAILY_LIMIT, IStatistics::STATS_BREAKVALUE_SKIPPED>},
+    Metric{"dailylimit_postponed", break_value<BREAK_ID_DAILY_LIMIT, IStatistics::STATS_BREAKVALUE_POSTPONED>},
+    Metric{"keystrokes", misc_value<IStatistics::STATS_VALUE_TOTAL_KEYSTROKES>},
+    Metric{"active_time", misc_value<IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME>},
+  };
+
+  //! Histogram with logarithmically sized buckets.
+  class Histogram
+  {
+  public:
+    void add(int64_t value)
+    {
+      value = std::max<int64_t>(value, 0);
+      buckets[bucket(static_cast<uint64_t>(value))]++;
+      count++;
+      sum += static_cast<double>(value);
+      max = std::max(max, value);
+    }
+
+    void merge(const Histogram &other)
+    {
+      for (int i = 0; i < BUCKET_COUNT; i++)
+        {
+          buckets[i] += other.buckets[i];
+        }
+      count += other.count;
+      sum += other.sum;
+      max = std::max(max, other.max);
+    }
+
+    //! Returns the lower bound of the bucket that contains the given percentile.
+    int64_t percentile(double p) const
+    {
+      auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count))));
+      uint64_t seen = 0;
+      for (int i = 0; i < BUCKET_COUNT; i++)
+        {
+          seen += buckets[i];
+          if (seen >= rank)
+            {
+              return std::min(lower_bound(i), max);
+            }
+        }
+      return max;
+    }
+
+    double mean() const
+    {
+      return count > 0 ? sum / static_cast<double>(count) : 0.0;
+    }
+
+    int64_t maximum() const
+    {
+      return max;
+    }
+
+  private:
+    // Values below 2^SUB_BITS have a bucket of their own. Larger values share a bucket with the values
+    // that have the same SUB_BITS most significant bits.
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int BUCKET_COUNT = SUB_COUNT + (63 - SUB_BITS) * SUB_COUNT;
+
+    static int bucket(uint64_t value)
+    {
+      if (value < SUB_COUNT)
+        {
+          return static_cast<int>(value);
+        }
+      int shift = static_cast<int>(std::bit_width(value)) - 1 - SUB_BITS;
+      return SUB_COUNT + shift * SUB_COUNT + static_cast<int>((value >> shift) & (SUB_COUNT - 1));
+    }
+
+    static int64_t lower_bound(int index)
+    {
+      if (index < SUB_COUNT)
+        {
+          return index;
+        }
+      int shift = (index - SUB_COUNT) / SUB_COUNT;
+      int sub = (index - SUB_COUNT) % SUB_COUNT;
+      return static_cast<int64_t>(SUB_COUNT + sub) << shift;
+    }
+
+  private:
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+    uint64_t count{0};
+    double sum{0.0};
+    int64_t max{0};
+  };
+
+  //! Results of one worker, or of all workers once merged.
+  struct Aggregate
+  {
+    std::array<Histogram, metrics.size()> histograms;
+    uint64_t files{0};
+    uint64_t invalid_files{0};
+    uint64_t bytes{0};
+    uint64_t days{0};
+
+    void merge(const Aggregate &other)
+    {
+      for (std::size_t i = 0; i < histograms.size(); i++)
+        {
+          histograms[i].merge(other.histograms[i]);
+        }
+      files += other.files;
+      invalid_files += other.invalid_files;
+      bytes += other.bytes;
+      days += other.days;
+    }
+  };
+
+  //! A file that is not mapped yet, or a shard of a mapped file.
+  struct Task
+  {
+    const std::filesystem::path *file{nullptr};
+    std::shared_ptr<const ip::mapped_region> region;
+    std::size_t begin{0};
+    std::size_t end{0};
+  };
+
+  class Aggregator
+  {
+  public:
+    Aggregator(const std::vector<std::filesystem::path> &files, unsigned int thread_count)
+      : queues(thread_count)
+      , results(thread_count)
+      , pending(files.size())
+      , queued(files.size())
+    {
+      for (std::size_t i = 0; i < files.size(); i++)
+        {
+          queues[i % thread_count].tasks.push_back(Task{&files[i]});
+        }
+    }
+
+    Aggregate run()
+    {
+      std::vector<std::thread> threads;
+      for (std::size_t i = 0; i < queues.size(); i++)
+        {
+          threads.emplace_back([this, i] { work(i); });
+        }
+      for (auto &t: threads)
+        {
+          t.join();
+        }
+
+      Aggregate total;
+      for (const auto &r: results)
+        {
+          total.merge(r);
+        }
+      return total;
+    }
+
+  private:
+    struct Queue
+    {
+      std::mutex lock;
+      std::deque<Task> tasks;
+    };
+
+    void work(std::size_t self)
+    {
+      Task task;
+      while (true)
+        {
+          if (!take(self, task))
+            {
+              // Tasks in progress may still queue the shards of a file.
+              std::unique_lock lock(idle_lock);
+              work_available.wait(lock, [this] { return queued.load() > 0 || pending.load() == 0; });
+              if (pending.load() == 0)
+                {
+                  return;
+                }
+              continue;
+            }
+          if (task.region)
+            {
+              parse(self, task);
+            }
+          else
+            {
+              map(self, task);
+            }
+          if (--pending == 0)
+            {
+              std::scoped_lock lock(idle_lock);
+              work_available.notify_all();
+            }
+        }
+    }
+
+    bool take(std::size_t self, Task &task)
+    {
+      {
+        std::scoped_lock lock(queues[self].lock);
+        if (!queues[self].tasks.empty())
+          {
+            task = std::move(queues[self].tasks.front());
+            queues[self].tasks.pop_front();
+            queued--;
+            return true;
+          }
+      }
+
+      for (std::size_t i = 1; i < queues.size(); i++)
+        {
+          Queue &victim = queues[(self + i) % queues.size()];
+          std::scoped_lock lock(victim.lock);
+          if (!victim.tasks.empty())
+            {
+              task = std::move(victim.tasks.back());
+              victim.tasks.pop_back();
+              queued--;
+              return true;
+            }
+        }
+      return false;
+    }
+
+    //! Maps a file and parses its first shard.
+    /*!
+     *  Only the first shard has the header, so the other shards are queued for any worker to take
+     *  once the header is known to be valid.
+     */
+    void map(std::size_t self, Task &task)
+    {
+      Aggregate &result = results[self];
+      std::error_code ec;
+      auto size = std::filesystem::file_size(*task.file, ec);
+      if (ec || size == 0)
+        {
+          result.invalid_files++;
+          return;
+        }
+
+      try
+        {
+          ip::file_mapping mapping(task.file->c_str(), ip::read_only);
+          task.region = std::make_shared<const ip::mapped_region>(mapping, ip::read_only);
+        }
+      catch (ip::interprocess_exception &)
+        {
+          result.invalid_files++;
+          return;
+        }
+
+      std::string_view text(static_cast<const char *>(task.region->get_address()), task.region->get_size());
+      if (!StatisticsReader(text).is_valid())
+        {
+          result.invalid_files++;
+          return;
+        }
+      result.files++;
+      result.bytes += text.size();
+
+      std::vector<Task> shards;
+      std::size_t begin = 0;
+      while (begin < text.size())
+        {
+          std::size_t end = text.size();
+          if (text.size() - begin > SHARD_SIZE)
+            {
+              std::size_t pos = text.find("\nD ", begin + SHARD_SIZE);
+              end = pos == std::string_view::npos ? text.size() : pos + 1;
+            }
+          shards.push_back(Task{task.file, task.region, begin, end});
+          begin = end;
+        }
+
+      if (shards.size() > 1)
+        {
+          pending += shards.size() - 1;
+          {
+            std::scoped_lock lock(queues[self].lock);
+            queues[self].tasks.insert(queues[self].tasks.end(), shards.begin() + 1, shards.end());
+            queued += shards.size() - 1;
+          }
+          std::scoped_lock lock(idle_lock);
+          work_available.notify_all();
+        }
+      parse(self, shards.front());
+    }
+
+    void parse(std::size_t self, const Task &task)
+    {
+      Aggregate &result = results[self];
+      std::string_view text(static_cast<const char *>(task.region->get_address()), task.region->get_size());
+
+      StatisticsReader reader(text.substr(task.begin, task.end - task.begin), task.begin == 0);
+      if (!reader.is_valid())
+        {
+          result.invalid_files++;
+          return;
+        }
+
+      DailyStats day{};
+      while (reader.next(day))
+        {
+          for (std::size_t i = 0; i < metrics.size(); i++)
+            {
+              result.histograms[i].add(metrics[i].value(day));
+            }
+          result.days++;
+        }
+    }
+
+  private:
+    std::vector<Queue> queues;
+    std::vector<Aggregate> results;
+    //! Tasks that are queued or in progress.
+    std::atomic<std::size_t> pending;
+    //! Tasks that are queued.
+    std::atomic<std::size_t> queued;
+    std::mutex idle_lock;
+    std::condition_variable work_available;
+  };
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  unsigned int thread_count = std::max(1U, std::thread::hardware_concurrency());
+  std::vector<std::string> inputs;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "Show this help");
+  options.add_options()("threads,j", po::value<unsigned int>(&thread_count), "Number of worker threads");
+  options.add_options()("input", po::value<std::vector<std::string>>(&inputs), "Directories of historystats files, or files");
+
+  po::positional_options_description positional;
+  positional.add("input", -1);
+
+  try
+    {
+      po::variables_map vm;
+      po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+      po::notify(vm);
+
+      if (vm.count("help") > 0 || inputs.empty())
+        {
+          std::cout << "Usage: workrave-stats-aggregate [options] DIR|FILE...\n" << options;
+          return vm.count("help") > 0 ? 0 : 1;
+        }
+    }
+  catch (po::error &e)
+    {
+      std::cerr << "workrave-stats-aggregate: " << e.what() << "\n";
+      return 1;
+    }
+  thread_count = std::max(1U, thread_count);
+
+  std::vector<std::filesystem::path> files;
+  for (const auto &input: inputs)
+    {
+      std::error_code ec;
+      if (std::filesystem::is_directory(input, ec))
+        {
+          for (const auto &entry: std::filesystem::directory_iterator(input, ec))
+            {
+              if (entry.is_regular_file(ec))
+                {
+                  files.push_back(entry.path());
+                }
+            }
+        }
+      else
+        {
+          files.emplace_back(input);
+        }
+      if (ec)
+        {
+          std::cerr << "workrave-stats-aggregate: cannot read " << input << ": " << ec.message() << "\n";
+          return 1;
+        }
+    }
+
+  auto start = std::chrono::steady_clock::now();
+  Aggregate total = Aggregator(files, thread_count).run();
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  printf("%-22s %12s %12s %12s %12s %12s\n", "metric", "mean", "p50", "p90", "p99", "max");
+  for (std::size_t i = 0; i < metrics.size(); i++)
+    {
+      const Histogram &h = total.histograms[i];
+      printf("%-22s %12.1f %12lld %12lld %12lld %12lld\n",
+             metrics[i].name,
+             h.mean(),
+             static_cast<long long>(h.percentile(50)),
+             static_cast<long long>(h.percentile(90)),
+             static_cast<long long>(h.percentile(99)),
+             static_cast<long long>(h.maximum()));
+    }
+
+  double mb = static_cast<double>(total.bytes) / (1024.0 * 1024.0);
+  printf("\n%llu files (%llu invalid), %llu days, %.1f MB, %u threads\n",
+         static_cast<unsigned long long>(total.files),
+         static_cast<unsigned long long>(total.invalid_files),
+         static_cast<unsigned long long>(total.days),
+         mb,
+         thread_count);
+  printf("%.3f s, %.0f files/s, %.1f MB/s\n",
+         elapsed,
+         elapsed > 0 ? static_cast<double>(total.files) / elapsed : 0.0,
+         elapsed > 0 ? mb / elapsed : 0.0);
+
+  return total.invalid_files > 0 ? 2 : 0;
+}
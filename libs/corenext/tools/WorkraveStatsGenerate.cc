@@ -0,0 +1,189 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Generates a directory of synthetic historystats files, for benchmarking workrave-stats-aggregate.
+//
+// Usage: workrave-stats-generate [--files N] [--days D] [--seed S] DIR
+//
+// Every file represents one workstation with its own typing and break habits. Weekends are skipped.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+
+namespace
+{
+  //! Break habits of one workstation.
+  struct Habits
+  {
+    double activity;
+    double keystroke_rate;
+    double compliance;
+  };
+
+  int64_t draw(std::mt19937 &rng, double mean)
+  {
+    std::poisson_distribution<int64_t> d(std::max(mean, 0.0));
+    return d(rng);
+  }
+
+  void write_day(FILE *f, const struct tm &date, const Habits &habits, std::mt19937 &rng)
+  {
+    std::normal_distribution<double> noise(1.0, 0.25);
+    double factor = std::max(0.0, noise(rng));
+
+    int64_t active_time = static_cast<int64_t>(habits.activity * factor * 3600);
+    int start_hour = 7 + static_cast<int>(rng() % 3);
+    int stop_hour = std::min(23, start_hour + 1 + static_cast<int>(active_time / 3600) + 1);
+
+    fprintf(f, "D %d %d %d %d %d %d %d %d %d %d\n", date.tm_mday, date.tm_mon, date.tm_year, start_hour, static_cast<int>(rng() % 60),
+            date.tm_mday, date.tm_mon, date.tm_year, stop_hour, static_cast<int>(rng() % 60));
+
+    // Expected number of prompts per hour of activity for micro breaks, rest breaks and the daily limit.
+    const double prompts_per_hour[] = {10.0, 1.1, 0.1};
+    for (int b = 0; b < 3; b++)
+      {
+        int64_t prompted = draw(rng, prompts_per_hour[b] * static_cast<double>(active_time) / 3600.0);
+        std::binomial_distribution<int64_t> taken_d(prompted, habits.compliance);
+        int64_t taken = taken_d(rng);
+        int64_t natural = draw(rng, static_cast<double>(taken) * 0.3);
+        std::binomial_distribution<int64_t> skipped_d(prompted - taken, 0.4);
+        int64_t skipped = skipped_d(rng);
+        int64_t postponed = prompted - taken - skipped;
+        int64_t unique = std::max<int64_t>(0, prompted - draw(rng, static_cast<double>(postponed) * 0.5));
+        int64_t overdue = draw(rng, static_cast<double>(postponed) * 120.0);
+
+        fprintf(f, "B %d 7 %lld %lld %lld %lld %lld %lld %lld \n", b, static_cast<long long>(prompted), static_cast<long long>(taken),
+                static_cast<long long>(natural), static_cast<long long>(skipped), static_cast<long long>(postponed),
+                static_cast<long long>(unique), static_cast<long long>(overdue));
+      }
+
+    int64_t keystrokes = draw(rng, habits.keystroke_rate * static_cast<double>(active_time));
+    int64_t mouse = draw(rng, static_cast<double>(active_time) * 40.0);
+    int64_t click_mouse = draw(rng, static_cast<double>(mouse) * 0.2);
+    int64_t movement_time = draw(rng, static_cast<double>(active_time) * 0.3);
+    int64_t clicks = draw(rng, static_cast<double>(active_time) * 0.15);
+    fprintf(f, "m 6 %lld %lld %lld %lld %lld %lld \n", static_cast<long long>(active_time), static_cast<long long>(mouse),
+            static_cast<long long>(click_mouse), static_cast<long long>(movement_time), static_cast<long long>(clicks),
+            static_cast<long long>(keystrokes));
+  }
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+  int file_count = 1000;
+  int day_count = 365;
+  unsigned int seed = 1;
+  std::string dir;
+
+  po::options_description options("Options");
+  options.add_options()("help,h", "Show this help");
+  options.add_options()("files,n", po::value<int>(&file_count)->default_value(file_count), "Number of workstations");
+  options.add_options()("days,d", po::value<int>(&day_count)->default_value(day_count), "Number of calendar days per workstation");
+  options.add_options()("seed,s", po::value<unsigned int>(&seed)->default_value(seed), "Random seed");
+  options.add_options()("dir", po::value<std::string>(&dir), "Output directory");
+
+  po::positional_options_description positional;
+  positional.add("dir", 1);
+
+  try
+    {
+      po::variables_map vm;
+      po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+      po::notify(vm);
+
+      if (vm.count("help") > 0 || dir.empty())
+        {
+          std::cout << "Usage: workrave-stats-generate [options] DIR\n" << options;
+          return vm.count("help") > 0 ? 0 : 1;
+        }
+    }
+  catch (po::error &e)
+    {
+      std::cerr << "workrave-stats-generate: " << e.what() << "\n";
+      return 1;
+    }
+
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  if (ec)
+    {
+      std::cerr << "workrave-stats-generate: cannot create " << dir << ": " << ec.message() << "\n";
+      return 1;
+    }
+
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> activity(2.0, 7.0);
+  std::uniform_real_distribution<double> keystroke_rate(0.5, 3.0);
+  std::uniform_real_distribution<double> compliance(0.1, 0.95);
+
+  for (int i = 0; i < file_count; i++)
+    {
+      char name[64];
+      snprintf(name, sizeof(name), "host-%05d.historystats", i);
+      std::filesystem::path path = std::filesystem::path(dir) / name;
+
+      FILE *f = fopen(path.string().c_str(), "w");
+      if (f == nullptr)
+        {
+          std::cerr << "workrave-stats-generate: cannot write " << path.string() << "\n";
+          return 1;
+        }
+
+      Habits habits{activity(rng), keystroke_rate(rng), compliance(rng)};
+      fprintf(f, "WorkRaveStats 4\n");
+
+      struct tm date{};
+      date.tm_year = 124;
+      date.tm_mon = 0;
+      date.tm_mday = 1;
+      date.tm_hour = 12;
+      for (int d = 0; d < day_count; d++)
+        {
+          time_t t = mktime(&date);
+          struct tm day = *localtime(&t);
+          if (day.tm_wday != 0 && day.tm_wday != 6)
+            {
+              write_day(f, day, habits, rng);
+            }
+          date.tm_mday++;
+        }
+
+      if (fclose(f) != 0)
+        {
+          std::cerr << "workrave-stats-generate: cannot write " << path.string() << "\n";
+          return 1;
+        }
+    }
+
+  return 0;
+}
@@ -27,6 +27,9 @@ import jinja2
 from optparse import OptionParser
 from xml.dom.minidom import parse
 
+# Types that g_variant_new can take directly as a varargs value.
+BASIC_VARIANT_TYPES = ('int', 'uint8', 'int16', 'uint16', 'int32', 'uint32', 'int64', 'uint64', 'bool', 'double', 'string')
+
 class NodeBase(object):
     def sig(self):
         return "undefined"
@@ -51,6 +54,20 @@ class ArgNode(NodeBase):
     def sig(self):
         return self.interface_node.get_type(self.type).sig()
 
+    def variant_format(self):
+        if self.type in BASIC_VARIANT_TYPES:
+            return self.sig()
+        return '@' + self.sig()
+
+    def variant_value(self, expr):
+        if self.type == 'string':
+            return expr + '.c_str()'
+        elif self.type == 'bool':
+            return '(gboolean) ' + expr
+        elif self.type in BASIC_VARIANT_TYPES:
+            return expr
+        return 'put_%s(&%s)' % (self.type, expr)
+
 class TypeNode(NodeBase):
     name = "undefined"
     qname = "undefined"
@@ -223,6 +240,7 @@ class InterfaceNode(NodeBase):
 
         self.methods = []
         self.signals = []
+        self.properties = []
         self.imports = []
 
     def handle(self, node):
@@ -245,6 +263,10 @@ class InterfaceNode(NodeBase):
                     p = SignalNode(self)
                     p.handle(child)
                     self.signals.append(p)
+                elif child.nodeName == 'property':
+                    p = PropertyNode(self)
+                    p.handle(child)
+                    self.properties.append(p)
                 elif child.nodeName == 'import':
                     p = ImportNode(self)
                     p.handle(child)
@@ -327,6 +349,9 @@ class MethodNode(NodeBase):
 
         return '(' + method_sig + ')'
 
+    def variant_format_of_type(self, type):
+        return '(' + ''.join([p.variant_format() for p in self.params if p.direction == type]) + ')'
+
     def return_type(self):
         ret = 'void'
         for p in self.params:
@@ -389,6 +414,9 @@ class SignalNode(NodeBase):
 
         return '(' + method_sig + ')'
 
+    def variant_format(self):
+        return '(' + ''.join([p.variant_format() for p in self.params]) + ')'
+
     def return_type(self):
         ret = 'void'
         for p in self.params:
@@ -404,6 +432,29 @@ class SignalNode(NodeBase):
         return ret
 
 
+class PropertyNode(NodeBase):
+    def __init__(self, interface_node):
+        NodeBase.__init__(self)
+        self.interface_node = interface_node
+
+    def handle(self, node):
+        self.name = node.getAttribute('name')
+        self.csymbol = node.getAttribute('csymbol')
+        self.qname = self.name.replace('.','_')
+        self.type = node.getAttribute('type')
+        self.access = node.getAttribute('access') or 'read'
+
+        if self.access != 'read':
+            print('Property ' + self.name + ': only read access is supported')
+            sys.exit(1)
+
+    def symbol(self):
+        return self.csymbol
+
+    def sig(self):
+        return self.interface_node.get_type(self.type).sig()
+
+
 class StructNode(TypeNode):
     def __init__(self, top_node):
         TypeNode.__init__(self)
@@ -438,6 +489,9 @@ class StructNode(TypeNode):
 
         return '(' + struct_sig + ')'
 
+    def variant_format(self):
+        return '(' + ''.join([f.variant_format() for f in self.fields]) + ')'
+
 
 class SequenceNode(TypeNode):
     def __init__(self, top_node):
@@ -478,7 +532,7 @@ class DictionaryNode(TypeNode):
         self.top_node.types[self.name] = self
 
     def sig(self):
-        return 'e{' + \
+        return 'a{' + \
                self.top_node.get_type(self.key_type).sig() + \
                self.top_node.get_type(self.value_type).sig() + '}'
 
@@ -44,12 +44,13 @@ namespace workrave
       explicit DBusBindingGio(IDBus::Ptr dbus);
       ~DBusBindingGio() override = default;
 
-      virtual const char *get_interface_introspect() = 0;
-      virtual void call(const std::string &method,
+      virtual const GDBusInterfaceInfo *get_interface_info() = 0;
+      virtual void call(const char *method,
                         void *object,
                         GDBusMethodInvocation *invocation,
                         const std::string &sender,
                         GVariant *inargs) = 0;
+      virtual GVariant *get_property(const std::string &property_name, void *object) = 0;
 
     protected:
       IDBus::Ptr dbus;
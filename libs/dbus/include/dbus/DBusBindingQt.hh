@@ -51,6 +51,8 @@ namespace workrave
 
       virtual const char *get_interface_introspect() = 0;
       virtual bool call(void *object, const QDBusMessage &message, const QDBusConnection &connection) = 0;
+      virtual QVariant get_property(void *object, const std::string &property_name) = 0;
+      virtual QVariantMap get_all_properties(void *object) = 0;
 
     protected:
       IDBus::Ptr dbus;
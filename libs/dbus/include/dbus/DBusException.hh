@@ -31,6 +31,7 @@ namespace workrave
     extern const char *DBUS_ERROR_NOT_SUPPORTED;
     extern const char *DBUS_ERROR_INVALID_ARGS;
     extern const char *DBUS_ERROR_UNKNOWN_METHOD;
+    extern const char *DBUS_ERROR_UNKNOWN_PROPERTY;
 
     class DBusException : public workrave::utils::Exception
     {
@@ -48,6 +49,7 @@ namespace workrave
     using object_info = boost::error_info<struct tag_oject_info, std::string>;
     using interface_info = boost::error_info<struct tag_interface_info, std::string>;
     using method_info = boost::error_info<struct tag_method_info, std::string>;
+    using property_info = boost::error_info<struct tag_property_info, std::string>;
     using argument_info = boost::error_info<struct tag_argument_info, std::string>;
     using actual_type_info = boost::error_info<struct tag_type_info, std::string>;
     using expected_type_info = boost::error_info<struct tag_expected_type_info, std::string>;
@@ -116,6 +118,10 @@ namespace workrave
           {
             ret += " method=" + *msg;
           }
+        if (const std::string *msg = boost::get_error_info<property_info>(*this))
+          {
+            ret += " property=" + *msg;
+          }
         if (const std::string *msg = boost::get_error_info<argument_info>(*this))
           {
             ret += " argument=" + *msg;
@@ -29,5 +29,6 @@ namespace workrave
     const char *DBUS_ERROR_NOT_SUPPORTED = "org.freedesktop.DBus.Error.NotSupported";
     const char *DBUS_ERROR_INVALID_ARGS = "org.freedesktop.DBus.Error.InvalidArgs";
     const char *DBUS_ERROR_UNKNOWN_METHOD = "org.freedesktop.DBus.Error.UnknownMethod";
+    const char *DBUS_ERROR_UNKNOWN_PROPERTY = "org.freedesktop.DBus.Error.UnknownProperty";
   } // namespace dbus
 } // namespace workrave
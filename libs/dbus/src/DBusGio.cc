@@ -57,11 +57,6 @@ DBusGio::~DBusGio()
             {
               g_dbus_connection_unregister_object(connection, interface.second.registration_id);
             }
-
-          if (interface.second.introspection_data != nullptr)
-            {
-              g_dbus_node_info_unref(interface.second.introspection_data);
-            }
         }
     }
 }
@@ -116,25 +111,27 @@ DBusGio::update_object_registration(InterfaceData &data)
       g_dbus_connection_unregister_object(connection, data.registration_id);
     }
 
-  string introspection_xml = get_introspect(data.object_path, data.interface_name);
-  TRACE_MSG("Intro: {}", introspection_xml);
-
-  GError *error = nullptr;
-  data.introspection_data = g_dbus_node_info_new_for_xml(introspection_xml.c_str(), &error);
-
-  if (error != nullptr)
+  auto *binding = dynamic_cast<DBusBindingGio *>(find_binding(data.interface_name));
+  if (binding == nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
-      g_error_free(error);
+      TRACE_MSG("No such interface");
+      return;
     }
 
+  // The interface info is generated by dbusgen as static data, so no XML is parsed here.
+  GError *error = nullptr;
   data.registration_id = g_dbus_connection_register_object(connection,
                                                            data.object_path.c_str(),
-                                                           data.introspection_data->interfaces[0],
+                                                           const_cast<GDBusInterfaceInfo *>(binding->get_interface_info()),
                                                            &interface_vtable,
                                                            this,
                                                            nullptr,
-                                                           nullptr);
+                                                           &error);
+  if (error != nullptr)
+    {
+      TRACE_MSG("Error: {}", error->message);
+      g_error_free(error);
+    }
 }
 
 void
@@ -188,11 +185,6 @@ DBusGio::disconnect(const std::string &object_path, const std::string &interface
           g_dbus_connection_unregister_object(connection, interfaces[interface_name].registration_id);
         }
 
-      if (interfaces[interface_name].introspection_data != nullptr)
-        {
-          g_dbus_node_info_unref(interfaces[interface_name].introspection_data);
-        }
-
       interfaces.erase(interface_name);
     }
 }
@@ -368,39 +360,6 @@ DBusGio::unwatch(const std::string &name)
   watched.erase(name);
 }
 
-string
-DBusGio::get_introspect(const string &object_path, const string &interface_name)
-{
-  TRACE_ENTRY_PAR(object_path);
-  string str;
-
-  str +=
-    "<!DOCTYPE node PUBLIC '-//freedesktop//DTD D-BUS Object Introspection 1.0//EN' 'http://www.freedesktop.org/standards/dbus/1.0/introspect.dtd'>\n";
-  str += "<node name='" + object_path + "'>\n";
-
-  auto object_it = objects.find(object_path);
-  if (object_it != objects.end())
-    {
-      auto interface_it = object_it->second.interfaces.find(interface_name);
-      if (interface_it != object_it->second.interfaces.end())
-        {
-          auto *binding = dynamic_cast<DBusBindingGio *>(find_binding(interface_it->first));
-          if (binding == nullptr)
-            {
-              throw DBusRemoteException() << message_info("Unknown interface") << error_code_info(DBUS_ERROR_FAILED)
-                                          << interface_info(interface_name);
-            }
-
-          const char *interface_introspect = binding->get_interface_introspect();
-          str += string(interface_introspect);
-        }
-    }
-
-  str += "</node>\n";
-  TRACE_VAR(str);
-  return str;
-}
-
 void
 DBusGio::on_method_call(GDBusConnection *connection,
                         const gchar *sender,
@@ -451,11 +410,31 @@ DBusGio::on_get_property(GDBusConnection *connection,
 {
   (void)connection;
   (void)sender;
-  (void)object_path;
-  (void)interface_name;
-  (void)property_name;
-  (void)error;
-  (void)user_data;
+
+  try
+    {
+      auto *self = (DBusGio *)user_data;
+
+      void *object = self->find_object(object_path, interface_name);
+      if (object == nullptr)
+        {
+          throw DBusRemoteException() << message_info("No such object") << error_code_info(DBUS_ERROR_FAILED) << object_info(object_path)
+                                      << interface_info(interface_name);
+        }
+
+      auto *binding = dynamic_cast<DBusBindingGio *>(self->find_binding(interface_name));
+      if (binding == nullptr)
+        {
+          throw DBusRemoteException() << message_info("No such interface") << error_code_info(DBUS_ERROR_FAILED) << object_info(object_path)
+                                      << interface_info(interface_name);
+        }
+
+      return binding->get_property(property_name, object);
+    }
+  catch (DBusRemoteException &e)
+    {
+      g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "%s", e.diag().c_str());
+    }
 
   return nullptr;
 }
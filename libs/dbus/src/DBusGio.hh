@@ -81,7 +81,6 @@ namespace workrave
 
         std::string object_path;
         std::string interface_name;
-        GDBusNodeInfo *introspection_data{nullptr};
         guint registration_id{0};
         void *object{nullptr};
       };
@@ -116,7 +115,6 @@ namespace workrave
       void *find_object(const std::string &path, const std::string &interface_name) const;
       void send() const;
 
-      std::string get_introspect(const std::string &path, const std::string &interface_name);
       void update_object_registration(InterfaceData &data);
 
       static void on_bus_name_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
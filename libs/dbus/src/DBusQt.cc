@@ -129,6 +129,11 @@ DBusQt::handleMessage(const QDBusMessage &message, const QDBusConnection &connec
 
   try
     {
+      if (interface_name == "org.freedesktop.DBus.Properties")
+        {
+          return handle_properties(message, connection);
+        }
+
       void *cobject = find_object(path, interface_name);
       if (cobject != nullptr)
         {
@@ -148,6 +153,43 @@ DBusQt::handleMessage(const QDBusMessage &message, const QDBusConnection &connec
   return success;
 }
 
+bool
+DBusQt::handle_properties(const QDBusMessage &message, const QDBusConnection &connection)
+{
+  string path = message.path().toStdString();
+  string member = message.member().toStdString();
+  QList<QVariant> args = message.arguments();
+
+  if (args.isEmpty())
+    {
+      return false;
+    }
+
+  string interface_name = args.at(0).toString().toStdString();
+
+  void *cobject = find_object(path, interface_name);
+  DBusBindingQt *binding = dynamic_cast<DBusBindingQt *>(find_binding(interface_name));
+  if (cobject == nullptr || binding == nullptr)
+    {
+      return false;
+    }
+
+  if (member == "Get" && args.size() == 2)
+    {
+      QVariant value = binding->get_property(cobject, args.at(1).toString().toStdString());
+      connection.send(message.createReply(QVariant::fromValue(QDBusVariant(value))));
+      return true;
+    }
+
+  if (member == "GetAll" && args.size() == 1)
+    {
+      connection.send(message.createReply(binding->get_all_properties(cobject)));
+      return true;
+    }
+
+  return false;
+}
+
 void
 DBusQt::on_service_owner_changed(const QString &name, const QString &oldowner, const QString &newowner)
 {
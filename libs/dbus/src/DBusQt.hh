@@ -69,6 +69,9 @@ namespace workrave
       void on_service_registered(const QString &name);
       void on_service_unregistered(const QString &name);
 
+    private:
+      bool handle_properties(const QDBusMessage &message, const QDBusConnection &connection);
+
     private:
       struct WatchData
       {
@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Measures the cost of the generated Gio bindings: registering objects on
+// the session bus, and calling a method compared with a Peer.Ping round-trip
+// that gio answers without entering the bindings.
+//
+// Usage: workrave-libs-dbus-benchmark-gio [objects] [calls]
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <gio/gio.h>
+
+#include "DBusGio.hh"
+#include "DBusGioBenchmark.hh"
+
+#define WORKRAVE_BENCHMARK_PATH "/org/workrave/Benchmark"
+#define WORKRAVE_BENCHMARK_INTERFACE "org.workrave.BenchmarkInterface"
+
+static double
+elapsed_us(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! Calls a method count times from a private connection and returns the average round-trip.
+static double
+time_calls(GDBusConnection *client, const char *name, const char *interface, const char *method, GVariant *args, int count)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < count; i++)
+    {
+      GError *error = nullptr;
+      GVariant *result = g_dbus_connection_call_sync(client,
+                                                     name,
+                                                     WORKRAVE_BENCHMARK_PATH "/0",
+                                                     interface,
+                                                     method,
+                                                     args,
+                                                     nullptr,
+                                                     G_DBUS_CALL_FLAGS_NONE,
+                                                     -1,
+                                                     nullptr,
+                                                     &error);
+      if (result == nullptr)
+        {
+          printf("%s.%s failed: %s\n", interface, method, error->message);
+          g_error_free(error);
+          return 0;
+        }
+      g_variant_unref(result);
+    }
+  return elapsed_us(start) / count;
+}
+
+int
+main(int argc, char **argv)
+{
+  int objects = argc > 1 ? static_cast<int>(std::strtol(argv[1], nullptr, 10)) : 500;
+  int calls = argc > 2 ? static_cast<int>(std::strtol(argv[2], nullptr, 10)) : 10000;
+
+  GError *error = nullptr;
+  gchar *address = g_dbus_address_get_for_bus_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+  if (address == nullptr)
+    {
+      printf("No session bus: %s\n", error->message);
+      g_error_free(error);
+      return 0;
+    }
+
+  auto dbus = std::make_shared<workrave::dbus::DBusGio>();
+  dbus->init();
+  if (dbus->get_connection() == nullptr)
+    {
+      printf("Cannot connect to the session bus\n");
+      g_free(address);
+      return 0;
+    }
+
+  extern void init_DBusBenchmarkGio(workrave::dbus::IDBus::Ptr dbus);
+  init_DBusBenchmarkGio(dbus);
+
+  DBusBenchmarkServer server;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < objects; i++)
+    {
+      std::string path = WORKRAVE_BENCHMARK_PATH "/" + std::to_string(i);
+      dbus->register_object_path(path);
+      dbus->connect(path, WORKRAVE_BENCHMARK_INTERFACE, &server);
+    }
+  double registration = elapsed_us(start);
+  printf("registration %6d objects %10.1f us/object\n", objects, registration / objects);
+
+  std::string name = g_dbus_connection_get_unique_name(dbus->get_connection());
+  GMainLoop *loop = g_main_loop_new(nullptr, FALSE);
+
+  std::thread client_thread([&]() {
+    GError *client_error = nullptr;
+    GDBusConnection *client = g_dbus_connection_new_for_address_sync(
+      address,
+      static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+      nullptr,
+      nullptr,
+      &client_error);
+
+    if (client != nullptr)
+      {
+        GVariant *args = g_variant_ref_sink(g_variant_new("(i)", 21));
+        double ping = time_calls(client, name.c_str(), "org.freedesktop.DBus.Peer", "Ping", nullptr, calls);
+        double call = time_calls(client, name.c_str(), WORKRAVE_BENCHMARK_INTERFACE, "ReturnInt", args, calls);
+        double sample = time_calls(client, name.c_str(), WORKRAVE_BENCHMARK_INTERFACE, "ReturnSample", nullptr, calls);
+        printf("Peer.Ping    %6d calls   %10.1f us/call\n", calls, ping);
+        printf("ReturnInt    %6d calls   %10.1f us/call %8.1f us in bindings\n", calls, call, call - ping);
+        printf("ReturnSample %6d calls   %10.1f us/call %8.1f us in bindings\n", calls, sample, sample - ping);
+        g_variant_unref(args);
+        g_object_unref(client);
+      }
+    else
+      {
+        printf("No client connection: %s\n", client_error->message);
+        g_error_free(client_error);
+      }
+    g_main_loop_quit(loop);
+  });
+
+  g_main_loop_run(loop);
+  client_thread.join();
+
+  for (int i = 0; i < objects; i++)
+    {
+      dbus->disconnect(WORKRAVE_BENCHMARK_PATH "/" + std::to_string(i), WORKRAVE_BENCHMARK_INTERFACE);
+    }
+
+  g_main_loop_unref(loop);
+  g_free(address);
+  return 0;
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef DBUSGIOBENCHMARK_HH
+#define DBUSGIOBENCHMARK_HH
+
+#include <cstdint>
+#include <string>
+
+class DBusBenchmarkServer
+{
+public:
+  struct Sample
+  {
+    int32_t id{0};
+    std::string name;
+    bool active{false};
+    int64_t value{0};
+  };
+
+  int32_t return_int(int32_t i_int)
+  {
+    return 2 * i_int;
+  }
+
+  Sample return_sample()
+  {
+    return Sample{1, "micro_pause", true, 180};
+  }
+};
+
+#endif // DBUSGIOBENCHMARK_HH
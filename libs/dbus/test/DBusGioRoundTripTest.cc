@@ -0,0 +1,342 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Emits the signals of roundtrip.xml through the generated Gio stub on a
+// peer-to-peer connection and decodes them on the other end. Each signal
+// carries every basic type, passed by value, by reference and by pointer.
+// No message bus is needed.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_dbus_gio
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+
+#include <sys/socket.h>
+
+#include <gio/gio.h>
+
+#include "dbus/IDBus.hh"
+#include "dbus/DBusBindingGio.hh"
+#include "DBusRoundTripGio.hh"
+
+#define WORKRAVE_ROUNDTRIP_PATH "/org/workrave/RoundTrip"
+#define WORKRAVE_ROUNDTRIP_INTERFACE "org.workrave.RoundTripInterface"
+
+using namespace workrave::dbus;
+
+//! Minimal IDBus that hands the generated stubs a peer-to-peer connection.
+class PeerDBus
+  : public IDBus
+  , public IDBusPrivateGio
+{
+public:
+  explicit PeerDBus(GDBusConnection *connection)
+    : connection(connection)
+  {
+  }
+
+  void init() override
+  {
+  }
+
+  void register_service(const std::string &service, IDBusWatch *cb) override
+  {
+    (void)service;
+    (void)cb;
+  }
+
+  void register_object_path(const std::string &object_path) override
+  {
+    (void)object_path;
+  }
+
+  void connect(const std::string &path, const std::string &interface_name, void *object) override
+  {
+    (void)path;
+    (void)interface_name;
+    (void)object;
+  }
+
+  void disconnect(const std::string &path, const std::string &interface_name) override
+  {
+    (void)path;
+    (void)interface_name;
+  }
+
+  void register_binding(const std::string &interface_name, DBusBinding *binding) override
+  {
+    bindings[interface_name].reset(binding);
+  }
+
+  DBusBinding *find_binding(const std::string &interface_name) const override
+  {
+    auto it = bindings.find(interface_name);
+    return it != bindings.end() ? it->second.get() : nullptr;
+  }
+
+  bool is_available() const override
+  {
+    return connection != nullptr;
+  }
+
+  bool is_running(const std::string &name) const override
+  {
+    (void)name;
+    return false;
+  }
+
+  void watch(const std::string &name, IDBusWatch *cb) override
+  {
+    (void)name;
+    (void)cb;
+  }
+
+  void unwatch(const std::string &name) override
+  {
+    (void)name;
+  }
+
+  GDBusConnection *get_connection() const override
+  {
+    return connection;
+  }
+
+  //! The stubs hold a reference to this object; dropping them breaks the cycle.
+  std::map<std::string, std::unique_ptr<DBusBinding>> bindings;
+
+private:
+  GDBusConnection *connection{nullptr};
+};
+
+struct Fixture
+{
+  Fixture()
+  {
+    int fds[2];
+    BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    gchar *guid = g_dbus_generate_guid();
+    start_connection(fds[0], guid, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER, &server);
+    start_connection(fds[1], nullptr, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT, &client);
+    g_free(guid);
+
+    BOOST_REQUIRE(wait_for([this]() { return server != nullptr && client != nullptr; }));
+
+    subscription = g_dbus_connection_signal_subscribe(client,
+                                                      nullptr,
+                                                      WORKRAVE_ROUNDTRIP_INTERFACE,
+                                                      nullptr,
+                                                      WORKRAVE_ROUNDTRIP_PATH,
+                                                      nullptr,
+                                                      G_DBUS_SIGNAL_FLAGS_NONE,
+                                                      &Fixture::on_signal,
+                                                      this,
+                                                      nullptr);
+
+    dbus = std::make_shared<PeerDBus>(server);
+    extern void init_DBusRoundTripGio(IDBus::Ptr dbus);
+    init_DBusRoundTripGio(dbus);
+    stub = org_workrave_RoundTripInterface::instance(dbus);
+    BOOST_REQUIRE(stub != nullptr);
+  }
+
+  ~Fixture()
+  {
+    dbus->bindings.clear();
+    g_dbus_connection_signal_unsubscribe(client, subscription);
+    if (received != nullptr)
+      {
+        g_variant_unref(received);
+      }
+    g_object_unref(client);
+    g_object_unref(server);
+  }
+
+  void start_connection(int fd, const gchar *guid, GDBusConnectionFlags flags, GDBusConnection **result)
+  {
+    GSocket *socket = g_socket_new_from_fd(fd, nullptr);
+    BOOST_REQUIRE(socket != nullptr);
+    GSocketConnection *stream = g_socket_connection_factory_create_connection(socket);
+    g_dbus_connection_new(G_IO_STREAM(stream), guid, flags, nullptr, nullptr, &Fixture::on_connection, result);
+    g_object_unref(stream);
+    g_object_unref(socket);
+  }
+
+  static void on_connection(GObject *source, GAsyncResult *res, gpointer user_data)
+  {
+    (void)source;
+    auto **result = static_cast<GDBusConnection **>(user_data);
+    *result = g_dbus_connection_new_finish(res, nullptr);
+  }
+
+  static void on_signal(GDBusConnection *connection,
+                        const gchar *sender,
+                        const gchar *object_path,
+                        const gchar *interface_name,
+                        const gchar *signal_name,
+                        GVariant *parameters,
+                        gpointer user_data)
+  {
+    (void)connection;
+    (void)sender;
+    (void)object_path;
+    (void)interface_name;
+    auto *self = static_cast<Fixture *>(user_data);
+    self->received_name = signal_name;
+    self->received = g_variant_ref(parameters);
+  }
+
+  template<typename Condition>
+  bool wait_for(Condition condition)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition() && std::chrono::steady_clock::now() < deadline)
+      {
+        g_main_context_iteration(nullptr, FALSE);
+      }
+    return condition();
+  }
+
+  void check_received(const std::string &signal_name)
+  {
+    BOOST_REQUIRE(wait_for([this]() { return received != nullptr; }));
+    BOOST_CHECK_EQUAL(received_name, signal_name);
+    BOOST_REQUIRE_EQUAL(std::string(g_variant_get_type_string(received)), "(iynqiuxtsbd)");
+
+    gint32 v_int = 0;
+    guint8 v_uint8 = 0;
+    gint16 v_int16 = 0;
+    guint16 v_uint16 = 0;
+    gint32 v_int32 = 0;
+    guint32 v_uint32 = 0;
+    gint64 v_int64 = 0;
+    guint64 v_uint64 = 0;
+    const gchar *v_string = nullptr;
+    gboolean v_bool = FALSE;
+    gdouble v_double = 0;
+    g_variant_get(received,
+                  "(iynqiuxt&sbd)",
+                  &v_int,
+                  &v_uint8,
+                  &v_int16,
+                  &v_uint16,
+                  &v_int32,
+                  &v_uint32,
+                  &v_int64,
+                  &v_uint64,
+                  &v_string,
+                  &v_bool,
+                  &v_double);
+
+    BOOST_CHECK_EQUAL(v_int, i_int);
+    BOOST_CHECK_EQUAL(v_uint8, i_uint8);
+    BOOST_CHECK_EQUAL(v_int16, i_int16);
+    BOOST_CHECK_EQUAL(v_uint16, i_uint16);
+    BOOST_CHECK_EQUAL(v_int32, i_int32);
+    BOOST_CHECK_EQUAL(v_uint32, i_uint32);
+    BOOST_CHECK_EQUAL(v_int64, i_int64);
+    BOOST_CHECK_EQUAL(v_uint64, i_uint64);
+    BOOST_CHECK_EQUAL(std::string(v_string), i_string);
+    BOOST_CHECK_EQUAL(v_bool != FALSE, i_bool);
+    BOOST_CHECK_EQUAL(v_double, i_double);
+  }
+
+  GDBusConnection *server{nullptr};
+  GDBusConnection *client{nullptr};
+  guint subscription{0};
+  std::shared_ptr<PeerDBus> dbus;
+  org_workrave_RoundTripInterface *stub{nullptr};
+
+  std::string received_name;
+  GVariant *received{nullptr};
+
+  int i_int{std::numeric_limits<int>::min()};
+  uint8_t i_uint8{std::numeric_limits<uint8_t>::max()};
+  int16_t i_int16{std::numeric_limits<int16_t>::min()};
+  uint16_t i_uint16{std::numeric_limits<uint16_t>::max()};
+  int32_t i_int32{std::numeric_limits<int32_t>::min()};
+  uint32_t i_uint32{std::numeric_limits<uint32_t>::max()};
+  int64_t i_int64{std::numeric_limits<int64_t>::min()};
+  uint64_t i_uint64{std::numeric_limits<uint64_t>::max()};
+  std::string i_string{"Workrave \xe2\x9c\x93"};
+  bool i_bool{true};
+  double i_double{-1.25e300};
+};
+
+BOOST_FIXTURE_TEST_SUITE(dbus_gio, Fixture)
+
+BOOST_AUTO_TEST_CASE(test_signal_by_value)
+{
+  stub->Values(WORKRAVE_ROUNDTRIP_PATH,
+               i_int,
+               i_uint8,
+               i_int16,
+               i_uint16,
+               i_int32,
+               i_uint32,
+               i_int64,
+               i_uint64,
+               i_string,
+               i_bool,
+               i_double);
+  check_received("Values");
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_by_ref)
+{
+  stub->ValuesRef(WORKRAVE_ROUNDTRIP_PATH,
+                  i_int,
+                  i_uint8,
+                  i_int16,
+                  i_uint16,
+                  i_int32,
+                  i_uint32,
+                  i_int64,
+                  i_uint64,
+                  i_string,
+                  i_bool,
+                  i_double);
+  check_received("ValuesRef");
+}
+
+BOOST_AUTO_TEST_CASE(test_signal_by_ptr)
+{
+  stub->ValuesPtr(WORKRAVE_ROUNDTRIP_PATH,
+                  &i_int,
+                  &i_uint8,
+                  &i_int16,
+                  &i_uint16,
+                  &i_int32,
+                  &i_uint32,
+                  &i_int64,
+                  &i_uint64,
+                  &i_string,
+                  &i_bool,
+                  &i_double);
+  check_received("ValuesPtr");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
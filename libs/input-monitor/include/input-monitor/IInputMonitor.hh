@@ -18,13 +18,18 @@
 #ifndef WORKRAVE_INPUT_MONITOR_IINPUTMONITOR_HH
 #define WORKRAVE_INPUT_MONITOR_IINPUTMONITOR_HH
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 
+#include "input-monitor/InputEvent.hh"
+
 namespace workrave
 {
   namespace input_monitor
   {
     class IInputMonitorListener;
+    class IInputMonitorBatchListener;
 
     //! Interface that all input monitors must support.
     class IInputMonitor
@@ -43,8 +48,42 @@ namespace workrave
       //! Subscribe for activity monitor.
       virtual void subscribe(IInputMonitorListener *listener) = 0;
 
+      //! Subscribe for activity monitor, limited to the events of interest.
+      /*!
+       *  A listener with a non-zero minimum interval receives at most one
+       *  action, mouse or keyboard notification per interval. Button events
+       *  are never held back, so that listeners can track the button state.
+       */
+      virtual void subscribe(IInputMonitorListener *listener,
+                             workrave::utils::Flags<InputInterest> interest,
+                             std::chrono::milliseconds min_interval) = 0;
+
       //! Unsubscribe for activity monitor.
       virtual void unsubscribe(IInputMonitorListener *listener) = 0;
+
+      //! Subscribe for batched input events.
+      virtual void subscribe(IInputMonitorBatchListener *listener) = 0;
+
+      //! Subscribe for batched input events, with at most one pointer motion event per interval.
+      /*!
+       *  Pointer motion within the interval after the last queued motion event
+       *  is not queued. Wheel, button, keyboard and action events are always
+       *  queued.
+       */
+      virtual void subscribe(IInputMonitorBatchListener *listener, std::chrono::milliseconds motion_interval) = 0;
+
+      //! Unsubscribe for batched input events.
+      virtual void unsubscribe(IInputMonitorBatchListener *listener) = 0;
+
+      //! Delivers all events queued for the listener, returns the number of events.
+      /*!
+       *  Each batch listener has its own single-producer/single-consumer queue,
+       *  so drain() must only be called from one thread per listener.
+       */
+      virtual std::size_t drain(IInputMonitorBatchListener *listener) = 0;
+
+      //! Returns the counters of the event queues and listener notifications.
+      virtual InputEventCounters get_event_counters() const = 0;
     };
   } // namespace input_monitor
 } // namespace workrave
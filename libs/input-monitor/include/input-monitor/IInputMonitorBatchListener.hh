@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_INPUT_MONITOR_IINPUTMONITORBATCHLISTENER_HH
+#define WORKRAVE_INPUT_MONITOR_IINPUTMONITORBATCHLISTENER_HH
+
+#include <span>
+
+#include "input-monitor/InputEvent.hh"
+
+namespace workrave
+{
+  namespace input_monitor
+  {
+    //! Listener for batches of queued events from the input monitor.
+    /*!
+     *  Unlike IInputMonitorListener, a batch listener is not called from the
+     *  input monitor thread. Events are queued and delivered when the listener
+     *  calls IInputMonitor::drain() on its own thread.
+     */
+    class IInputMonitorBatchListener
+    {
+    public:
+      virtual ~IInputMonitorBatchListener() = default;
+
+      //! Reports a batch of input events, oldest first.
+      virtual void input_events_notify(std::span<const InputEvent> events) = 0;
+    };
+  } // namespace input_monitor
+} // namespace workrave
+
+#endif // WORKRAVE_INPUT_MONITOR_IINPUTMONITORBATCHLISTENER_HH
@@ -0,0 +1,118 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_INPUT_MONITOR_INPUTEVENT_HH
+#define WORKRAVE_INPUT_MONITOR_INPUTEVENT_HH
+
+#include <cstdint>
+
+#include "utils/Enum.hh"
+
+namespace workrave
+{
+  namespace input_monitor
+  {
+    enum class InputEventType : uint8_t
+    {
+      Action,
+      Mouse,
+      Button,
+      Keyboard,
+    };
+
+    //! Event types a listener wants to be notified of.
+    enum class InputInterest : uint8_t
+    {
+      Action = 1,
+      Mouse = 2,
+      Button = 4,
+      Keyboard = 8,
+      All = Action | Mouse | Button | Keyboard,
+    };
+
+    //! Returns the interest flag that matches the event type.
+    constexpr InputInterest
+    to_interest(InputEventType type)
+    {
+      return static_cast<InputInterest>(1 << static_cast<int>(type));
+    }
+
+    //! Compact binary representation of a single input event.
+    struct InputEvent
+    {
+      //! Flag for Button events: the button was pressed.
+      static constexpr uint8_t FLAG_PRESS = 0x01;
+
+      //! Flag for Keyboard events: the key press is an auto-repeat.
+      static constexpr uint8_t FLAG_REPEAT = 0x02;
+
+      //! Monotonic time at which the event was received, in microseconds.
+      int64_t time_usec{0};
+      int32_t x{0};
+      int32_t y{0};
+      int16_t wheel{0};
+      InputEventType type{InputEventType::Action};
+      uint8_t flags{0};
+
+      bool is_press() const
+      {
+        return (flags & FLAG_PRESS) != 0;
+      }
+
+      bool is_repeat() const
+      {
+        return (flags & FLAG_REPEAT) != 0;
+      }
+
+      //! Returns true for pure pointer motion, which may be coalesced.
+      bool is_motion() const
+      {
+        return type == InputEventType::Mouse && wheel == 0;
+      }
+    };
+
+    static_assert(sizeof(InputEvent) == 24, "InputEvent must stay compact");
+
+    //! Counters of the batched input event pipeline.
+    struct InputEventCounters
+    {
+      //! Events delivered to the queue(s).
+      uint64_t queued{0};
+
+      //! Events lost because a queue was full.
+      uint64_t dropped{0};
+
+      //! Mouse motion events merged into a later one because a queue was full.
+      uint64_t coalesced{0};
+
+      //! Callbacks made to (non-batched) listeners.
+      uint64_t notified{0};
+
+      //! Events not passed to a listener because of its interest or minimum interval.
+      uint64_t suppressed{0};
+    };
+  } // namespace input_monitor
+} // namespace workrave
+
+template<>
+struct workrave::utils::enum_traits<workrave::input_monitor::InputInterest>
+{
+  static constexpr auto flag = true;
+  static constexpr auto bits = 4;
+};
+
+#endif // WORKRAVE_INPUT_MONITOR_INPUTEVENT_HH
@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef WORKRAVE_INPUT_MONITOR_INPUTEVENTTRACE_HH
+#define WORKRAVE_INPUT_MONITOR_INPUTEVENTTRACE_HH
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "input-monitor/InputEvent.hh"
+#include "input-monitor/IInputMonitorListener.hh"
+
+namespace workrave
+{
+  namespace input_monitor
+  {
+    //! A recorded sequence of input events.
+    /*!
+     *  The binary trace format is a 16 byte header ("WRIT", a 32 bit version
+     *  and a 64 bit event count) followed by the InputEvent records, all in
+     *  host byte order.
+     */
+    class InputEventTrace
+    {
+    public:
+      void add(const InputEvent &event);
+      void clear();
+
+      const std::vector<InputEvent> &get_events() const;
+
+      bool save(const std::filesystem::path &filename) const;
+      bool load(const std::filesystem::path &filename);
+
+    private:
+      std::vector<InputEvent> events;
+    };
+
+    //! Records the events reported by an input monitor to a trace file.
+    /*!
+     *  Events are written in chunks, so that only the events since the last
+     *  flush are kept in memory. The header is updated after each chunk, so
+     *  the file is a valid trace at all times.
+     */
+    class InputEventRecorder : public IInputMonitorListener
+    {
+    public:
+      explicit InputEventRecorder(const std::filesystem::path &filename);
+      ~InputEventRecorder() override;
+
+      void action_notify() override;
+      void mouse_notify(int x, int y, int wheel = 0) override;
+      void button_notify(bool is_press) override;
+      void keyboard_notify(bool repeat) override;
+
+      //! Writes the events that are not in the file yet.
+      bool flush();
+
+    private:
+      void record(InputEventType type, int x = 0, int y = 0, int wheel = 0, uint8_t flags = 0);
+      bool write_pending();
+
+    private:
+      static constexpr std::size_t FLUSH_EVENTS = 4096;
+      static constexpr int64_t FLUSH_INTERVAL_USEC = 10 * 1000 * 1000;
+
+      std::mutex lock;
+      std::ofstream file;
+      std::vector<InputEvent> pending;
+      uint64_t written{0};
+      int64_t last_flush_usec{0};
+    };
+  } // namespace input_monitor
+} // namespace workrave
+
+#endif // WORKRAVE_INPUT_MONITOR_INPUTEVENTTRACE_HH
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "InputEventQueue.hh"
+
+#include <algorithm>
+#include <bit>
+
+using namespace workrave::input_monitor;
+
+InputEventQueue::InputEventQueue(std::size_t capacity)
+  : events(std::bit_ceil(std::max<std::size_t>(capacity, 2)))
+  , mask(events.size() - 1)
+{
+}
+
+bool
+InputEventQueue::push(const InputEvent &event)
+{
+  uint64_t h = head.load(std::memory_order_relaxed);
+  uint64_t t = tail.load(std::memory_order_acquire);
+
+  if (has_pending && !publish_pending(h, t))
+    {
+      if (event.is_motion())
+        {
+          pending = event;
+          coalesced.fetch_add(1, std::memory_order_relaxed);
+        }
+      else
+        {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+      return false;
+    }
+
+  if (h - t > mask)
+    {
+      if (event.is_motion())
+        {
+          pending = event;
+          has_pending = true;
+        }
+      else
+        {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+      return false;
+    }
+
+  events[h & mask] = event;
+  head.store(h + 1, std::memory_order_release);
+  queued.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool
+InputEventQueue::publish_pending(uint64_t &h, uint64_t t)
+{
+  if (h - t > mask)
+    {
+      return false;
+    }
+
+  events[h & mask] = pending;
+  h++;
+  head.store(h, std::memory_order_release);
+  queued.fetch_add(1, std::memory_order_relaxed);
+  has_pending = false;
+  return true;
+}
+
+std::size_t
+InputEventQueue::drain(IInputMonitorBatchListener *listener)
+{
+  uint64_t t = tail.load(std::memory_order_relaxed);
+  uint64_t h = head.load(std::memory_order_acquire);
+
+  auto count = static_cast<std::size_t>(h - t);
+  if (count == 0)
+    {
+      return 0;
+    }
+
+  std::size_t start = t & mask;
+  std::size_t first = std::min(count, events.size() - start);
+
+  listener->input_events_notify({events.data() + start, first});
+  if (count > first)
+    {
+      listener->input_events_notify({events.data(), count - first});
+    }
+
+  tail.store(h, std::memory_order_release);
+  return count;
+}
+
+std::size_t
+InputEventQueue::capacity() const
+{
+  return events.size();
+}
+
+InputEventCounters
+InputEventQueue::get_counters() const
+{
+  InputEventCounters counters;
+  counters.queued = queued.load(std::memory_order_relaxed);
+  counters.dropped = dropped.load(std::memory_order_relaxed);
+  counters.coalesced = coalesced.load(std::memory_order_relaxed);
+  return counters;
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef INPUTEVENTQUEUE_HH
+#define INPUTEVENTQUEUE_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "input-monitor/InputEvent.hh"
+#include "input-monitor/IInputMonitorBatchListener.hh"
+
+//! Lock-free single-producer/single-consumer ring of input events.
+/*!
+ *  The input monitor thread pushes events, the listener drains them in
+ *  batches. When the ring is full, pointer motion is coalesced into a single
+ *  pending event that is published with the next push; other events are
+ *  dropped.
+ */
+class InputEventQueue
+{
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+  //! Creates a queue. The capacity is rounded up to a power of two.
+  explicit InputEventQueue(std::size_t capacity = DEFAULT_CAPACITY);
+
+  //! Queues an event. Must only be called by the producer.
+  bool push(const workrave::input_monitor::InputEvent &event);
+
+  //! Delivers all queued events to the listener. Must only be called by the consumer.
+  std::size_t drain(workrave::input_monitor::IInputMonitorBatchListener *listener);
+
+  std::size_t capacity() const;
+  workrave::input_monitor::InputEventCounters get_counters() const;
+
+private:
+  bool publish_pending(uint64_t &head, uint64_t tail);
+
+private:
+  std::vector<workrave::input_monitor::InputEvent> events;
+  uint64_t mask;
+
+  //! Write position, owned by the producer.
+  alignas(64) std::atomic<uint64_t> head{0};
+
+  //! Read position, owned by the consumer.
+  alignas(64) std::atomic<uint64_t> tail{0};
+
+  //! Motion event that did not fit in the ring, owned by the producer.
+  alignas(64) workrave::input_monitor::InputEvent pending;
+  bool has_pending{false};
+
+  std::atomic<uint64_t> queued{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<uint64_t> coalesced{0};
+};
+
+#endif // INPUTEVENTQUEUE_HH
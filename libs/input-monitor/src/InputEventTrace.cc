@@ -0,0 +1,186 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "input-monitor/InputEventTrace.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+#include "utils/TimeSource.hh"
+
+using namespace workrave::input_monitor;
+
+namespace
+{
+  constexpr std::array<char, 4> TRACE_MAGIC = {'W', 'R', 'I', 'T'};
+  constexpr uint32_t TRACE_VERSION = 1;
+
+  struct TraceHeader
+  {
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint64_t count;
+  };
+
+  static_assert(sizeof(TraceHeader) == 16);
+
+  constexpr std::streamoff TRACE_COUNT_OFFSET = offsetof(TraceHeader, count);
+} // namespace
+
+void
+InputEventTrace::add(const InputEvent &event)
+{
+  events.push_back(event);
+}
+
+void
+InputEventTrace::clear()
+{
+  events.clear();
+}
+
+const std::vector<InputEvent> &
+InputEventTrace::get_events() const
+{
+  return events;
+}
+
+bool
+InputEventTrace::save(const std::filesystem::path &filename) const
+{
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+  TraceHeader header{TRACE_MAGIC, TRACE_VERSION, events.size()};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(InputEvent)));
+
+  return file.good();
+}
+
+bool
+InputEventTrace::load(const std::filesystem::path &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+
+  TraceHeader header{};
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!file.good() || header.magic != TRACE_MAGIC || header.version != TRACE_VERSION)
+    {
+      return false;
+    }
+
+  std::vector<InputEvent> loaded(header.count);
+  file.read(reinterpret_cast<char *>(loaded.data()), static_cast<std::streamsize>(loaded.size() * sizeof(InputEvent)));
+  if (!file.good())
+    {
+      return false;
+    }
+
+  events = std::move(loaded);
+  return true;
+}
+
+InputEventRecorder::InputEventRecorder(const std::filesystem::path &filename)
+  : file(filename, std::ios::binary | std::ios::trunc)
+  , last_flush_usec(workrave::utils::TimeSource::get_monotonic_time_usec())
+{
+  TraceHeader header{TRACE_MAGIC, TRACE_VERSION, 0};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  pending.reserve(FLUSH_EVENTS);
+}
+
+InputEventRecorder::~InputEventRecorder()
+{
+  flush();
+}
+
+void
+InputEventRecorder::action_notify()
+{
+  record(InputEventType::Action);
+}
+
+void
+InputEventRecorder::mouse_notify(int x, int y, int wheel)
+{
+  record(InputEventType::Mouse, x, y, wheel);
+}
+
+void
+InputEventRecorder::button_notify(bool is_press)
+{
+  record(InputEventType::Button, 0, 0, 0, is_press ? InputEvent::FLAG_PRESS : 0);
+}
+
+void
+InputEventRecorder::keyboard_notify(bool repeat)
+{
+  record(InputEventType::Keyboard, 0, 0, 0, repeat ? InputEvent::FLAG_REPEAT : 0);
+}
+
+bool
+InputEventRecorder::flush()
+{
+  std::scoped_lock sl(lock);
+  return write_pending();
+}
+
+//! Appends the pending events and updates the event count in the header.
+bool
+InputEventRecorder::write_pending()
+{
+  last_flush_usec = workrave::utils::TimeSource::get_monotonic_time_usec();
+  if (pending.empty())
+    {
+      return file.good();
+    }
+
+  file.write(reinterpret_cast<const char *>(pending.data()), static_cast<std::streamsize>(pending.size() * sizeof(InputEvent)));
+  written += pending.size();
+  pending.clear();
+
+  file.seekp(TRACE_COUNT_OFFSET);
+  file.write(reinterpret_cast<const char *>(&written), sizeof(written));
+  file.seekp(0, std::ios::end);
+  file.flush();
+  return file.good();
+}
+
+void
+InputEventRecorder::record(InputEventType type, int x, int y, int wheel, uint8_t flags)
+{
+  InputEvent event;
+  event.time_usec = workrave::utils::TimeSource::get_monotonic_time_usec();
+  event.x = x;
+  event.y = y;
+  event.wheel = static_cast<int16_t>(wheel);
+  event.type = type;
+  event.flags = flags;
+
+  std::scoped_lock sl(lock);
+  pending.push_back(event);
+  if (pending.size() >= FLUSH_EVENTS || event.time_usec - last_flush_usec >= FLUSH_INTERVAL_USEC)
+    {
+      write_pending();
+    }
+}
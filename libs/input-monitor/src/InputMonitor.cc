@@ -21,52 +21,220 @@
 
 #include "InputMonitor.hh"
 
+#include "utils/TimeSource.hh"
+
 using namespace workrave::input_monitor;
+using namespace workrave::utils;
 
 void
 InputMonitor::subscribe(IInputMonitorListener *listener)
 {
-  listeners.push_back(listener);
+  subscribe(listener, InputInterest::All, std::chrono::milliseconds(0));
+}
+
+void
+InputMonitor::subscribe(IInputMonitorListener *listener, Flags<InputInterest> interest, std::chrono::milliseconds min_interval)
+{
+  Subscription subscription;
+  subscription.listener = listener;
+  subscription.interest = interest;
+  subscription.min_interval_usec = std::chrono::duration_cast<std::chrono::microseconds>(min_interval).count();
+  listeners.push_back(subscription);
+
+  debounced = debounced || subscription.min_interval_usec > 0;
 }
 
 void
 InputMonitor::unsubscribe(IInputMonitorListener *listener)
 {
-  listeners.remove(listener);
+  listeners.remove_if([listener](const auto &s) { return s.listener == listener; });
 }
 
 void
-InputMonitor::fire_action()
+InputMonitor::subscribe(IInputMonitorBatchListener *listener)
+{
+  subscribe(listener, std::chrono::milliseconds(0));
+}
+
+void
+InputMonitor::subscribe(IInputMonitorBatchListener *listener, std::chrono::milliseconds motion_interval)
+{
+  BatchSubscription subscription;
+  subscription.listener = listener;
+  subscription.queue = std::make_unique<InputEventQueue>();
+  subscription.motion_interval_usec = std::chrono::duration_cast<std::chrono::microseconds>(motion_interval).count();
+  batch_listeners.push_back(std::move(subscription));
+}
+
+void
+InputMonitor::unsubscribe(IInputMonitorBatchListener *listener)
+{
+  batch_listeners.remove_if([listener](const auto &s) { return s.listener == listener; });
+}
+
+std::size_t
+InputMonitor::drain(IInputMonitorBatchListener *listener)
 {
-  for (auto &l: listeners)
+  for (auto &s: batch_listeners)
     {
-      l->action_notify();
+      if (s.listener == listener)
+        {
+          return s.queue->drain(listener);
+        }
     }
+  return 0;
+}
+
+InputEventCounters
+InputMonitor::get_event_counters() const
+{
+  InputEventCounters total;
+  for (const auto &s: batch_listeners)
+    {
+      InputEventCounters counters = s.queue->get_counters();
+      total.queued += counters.queued;
+      total.dropped += counters.dropped;
+      total.coalesced += counters.coalesced;
+    }
+  total.notified = notified.load(std::memory_order_relaxed);
+  total.suppressed = suppressed.load(std::memory_order_relaxed);
+  return total;
+}
+
+bool
+InputMonitor::is_due(const Subscription &subscription, InputEventType type, int64_t now) const
+{
+  if (!subscription.interest.is_set(to_interest(type)))
+    {
+      return false;
+    }
+
+  // Button events are never held back, listeners may track the button state.
+  return subscription.min_interval_usec == 0 || type == InputEventType::Button
+         || now >= subscription.last_notify_usec + subscription.min_interval_usec;
+}
+
+bool
+InputMonitor::is_motion_due(const BatchSubscription &subscription, int64_t now)
+{
+  return subscription.motion_interval_usec == 0 || now >= subscription.last_motion_usec + subscription.motion_interval_usec;
+}
+
+bool
+InputMonitor::wants_event(InputEventType type) const
+{
+  int64_t now = debounced || !batch_listeners.empty() ? TimeSource::get_monotonic_time_usec() : 0;
+  for (const auto &s: batch_listeners)
+    {
+      if (type != InputEventType::Mouse || is_motion_due(s, now))
+        {
+          return true;
+        }
+    }
+
+  for (const auto &s: listeners)
+    {
+      if (is_due(s, type, now))
+        {
+          return true;
+        }
+    }
+  return false;
 }
 
 void
-InputMonitor::fire_mouse(int x, int y, int wheel)
+InputMonitor::queue_event(const InputEvent &event)
 {
-  for (auto &l: listeners)
+  for (auto &s: batch_listeners)
     {
-      l->mouse_notify(x, y, wheel);
+      if (event.is_motion())
+        {
+          if (!is_motion_due(s, event.time_usec))
+            {
+              continue;
+            }
+          s.last_motion_usec = event.time_usec;
+        }
+      s.queue->push(event);
     }
 }
 
+void
+InputMonitor::fire_action()
+{
+  fire_event(InputEventType::Action);
+}
+
+void
+InputMonitor::fire_mouse(int x, int y, int wheel)
+{
+  fire_event(InputEventType::Mouse, x, y, wheel);
+}
+
 void
 InputMonitor::fire_button(bool is_press)
 {
-  for (auto &l: listeners)
+  fire_event(InputEventType::Button, 0, 0, 0, is_press ? InputEvent::FLAG_PRESS : 0);
+}
+
+void
+InputMonitor::fire_keyboard(bool repeat)
+{
+  fire_event(InputEventType::Keyboard, 0, 0, 0, repeat ? InputEvent::FLAG_REPEAT : 0);
+}
+
+void
+InputMonitor::fire_event(InputEventType type, int x, int y, int wheel, uint8_t flags)
+{
+  InputEvent event;
+  // The timestamp is only needed for batching and debouncing.
+  if (debounced || !batch_listeners.empty())
     {
-      l->button_notify(is_press);
+      event.time_usec = TimeSource::get_monotonic_time_usec();
     }
+  event.x = x;
+  event.y = y;
+  event.wheel = static_cast<int16_t>(wheel);
+  event.type = type;
+  event.flags = flags;
+
+  fire_event(event);
 }
 
+//! Reports a complete event, including its timestamp, to all listeners.
 void
-InputMonitor::fire_keyboard(bool repeat)
+InputMonitor::fire_event(const InputEvent &event)
 {
-  for (auto &l: listeners)
+  for (auto &s: listeners)
+    {
+      if (!is_due(s, event.type, event.time_usec))
+        {
+          suppressed.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+
+      s.last_notify_usec = event.time_usec;
+      notified.fetch_add(1, std::memory_order_relaxed);
+
+      switch (event.type)
+        {
+        case InputEventType::Action:
+          s.listener->action_notify();
+          break;
+        case InputEventType::Mouse:
+          s.listener->mouse_notify(event.x, event.y, event.wheel);
+          break;
+        case InputEventType::Button:
+          s.listener->button_notify(event.is_press());
+          break;
+        case InputEventType::Keyboard:
+          s.listener->keyboard_notify(event.is_repeat());
+          break;
+        }
+    }
+
+  if (!batch_listeners.empty())
     {
-      l->keyboard_notify(repeat);
+      queue_event(event);
     }
 }
@@ -18,26 +18,80 @@
 #ifndef INPUTMONITOR_HH
 #define INPUTMONITOR_HH
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <list>
+#include <memory>
+#include <utility>
 
 #include "input-monitor/IInputMonitor.hh"
 #include "input-monitor/IInputMonitorListener.hh"
+#include "input-monitor/IInputMonitorBatchListener.hh"
+
+#include "InputEventQueue.hh"
 
 //!  Base for activity monitors.
 class InputMonitor : public workrave::input_monitor::IInputMonitor
 {
 public:
   void subscribe(workrave::input_monitor::IInputMonitorListener *listener) override;
+  void subscribe(workrave::input_monitor::IInputMonitorListener *listener,
+                 workrave::utils::Flags<workrave::input_monitor::InputInterest> interest,
+                 std::chrono::milliseconds min_interval) override;
   void unsubscribe(workrave::input_monitor::IInputMonitorListener *listener) override;
+  void subscribe(workrave::input_monitor::IInputMonitorBatchListener *listener) override;
+  void subscribe(workrave::input_monitor::IInputMonitorBatchListener *listener, std::chrono::milliseconds motion_interval) override;
+  void unsubscribe(workrave::input_monitor::IInputMonitorBatchListener *listener) override;
+  std::size_t drain(workrave::input_monitor::IInputMonitorBatchListener *listener) override;
+  workrave::input_monitor::InputEventCounters get_event_counters() const override;
 
 protected:
   void fire_action();
   void fire_mouse(int x, int y, int wheel = 0);
   void fire_button(bool is_press);
   void fire_keyboard(bool repeat);
+  void fire_event(const workrave::input_monitor::InputEvent &event);
+
+  //! Returns whether an event of the given type would currently reach any listener.
+  /*!
+   *  Backends use this to skip expensive work, such as querying the pointer
+   *  position, for events that would be suppressed anyway.
+   */
+  bool wants_event(workrave::input_monitor::InputEventType type) const;
+
+private:
+  struct Subscription
+  {
+    workrave::input_monitor::IInputMonitorListener *listener{nullptr};
+    workrave::utils::Flags<workrave::input_monitor::InputInterest> interest;
+    int64_t min_interval_usec{0};
+    int64_t last_notify_usec{std::numeric_limits<int64_t>::min()};
+  };
+
+  struct BatchSubscription
+  {
+    workrave::input_monitor::IInputMonitorBatchListener *listener{nullptr};
+    std::unique_ptr<InputEventQueue> queue;
+    int64_t motion_interval_usec{0};
+    int64_t last_motion_usec{std::numeric_limits<int64_t>::min()};
+  };
+
+  void fire_event(workrave::input_monitor::InputEventType type, int x = 0, int y = 0, int wheel = 0, uint8_t flags = 0);
+  void queue_event(const workrave::input_monitor::InputEvent &event);
+  bool is_due(const Subscription &subscription, workrave::input_monitor::InputEventType type, int64_t now) const;
+  static bool is_motion_due(const BatchSubscription &subscription, int64_t now);
 
 private:
-  std::list<workrave::input_monitor::IInputMonitorListener *> listeners;
+  std::list<Subscription> listeners;
+  std::list<BatchSubscription> batch_listeners;
+
+  //! Whether any listener has a minimum notification interval.
+  std::atomic<bool> debounced{false};
+
+  std::atomic<uint64_t> notified{0};
+  std::atomic<uint64_t> suppressed{0};
 };
 
 #endif // INPUTMONITOR_HH
@@ -21,34 +21,11 @@
 
 #include "config/IConfigurator.hh"
 
+#include "ReplayInputMonitor.hh"
+
 using namespace workrave::input_monitor;
 using namespace workrave::config;
 
-class InputMonitorStub : public IInputMonitor
-{
-public:
-  ~InputMonitorStub() override = default;
-
-  bool init() override
-  {
-    return true;
-  }
-
-  void terminate() override
-  {
-  }
-
-  void subscribe(IInputMonitorListener *listener) override
-  {
-    (void)listener;
-  }
-
-  void unsubscribe(IInputMonitorListener *listener) override
-  {
-    (void)listener;
-  }
-};
-
 void
 InputMonitorFactory::init(IConfigurator::Ptr config, const char *display)
 {
@@ -60,5 +37,16 @@ IInputMonitor::Ptr
 InputMonitorFactory::create_monitor(MonitorCapability capability)
 {
   (void)capability;
-  return IInputMonitor::Ptr(new InputMonitorStub());
+
+  // Users that are alive at the same time share one monitor, so that replayed events reach all
+  // of them. Once all users are gone, the next one gets a fresh monitor without stale listeners.
+  static std::weak_ptr<IInputMonitor> shared_monitor;
+
+  IInputMonitor::Ptr monitor = shared_monitor.lock();
+  if (!monitor)
+    {
+      monitor = std::make_shared<ReplayInputMonitor>();
+      shared_monitor = monitor;
+    }
+  return monitor;
 }
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "ReplayInputMonitor.hh"
+
+#include <chrono>
+#include <thread>
+
+using namespace workrave::input_monitor;
+
+bool
+ReplayInputMonitor::init()
+{
+  return true;
+}
+
+void
+ReplayInputMonitor::terminate()
+{
+}
+
+void
+ReplayInputMonitor::replay(std::span<const InputEvent> events, bool realtime)
+{
+  if (events.empty())
+    {
+      return;
+    }
+
+  auto start = std::chrono::steady_clock::now();
+  int64_t first_time = events.front().time_usec;
+
+  for (const auto &event: events)
+    {
+      if (realtime)
+        {
+          std::this_thread::sleep_until(start + std::chrono::microseconds(event.time_usec - first_time));
+        }
+      fire_event(event);
+    }
+}
@@ -0,0 +1,40 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef REPLAYINPUTMONITOR_HH
+#define REPLAYINPUTMONITOR_HH
+
+#include <span>
+
+#include "InputMonitor.hh"
+
+//! Input monitor that reports previously recorded events.
+class ReplayInputMonitor : public InputMonitor
+{
+public:
+  bool init() override;
+  void terminate() override;
+
+  //! Reports the events to all listeners.
+  /*!
+   *  If realtime is true, the recorded delays between the events are kept,
+   *  otherwise the events are reported as fast as possible.
+   */
+  void replay(std::span<const workrave::input_monitor::InputEvent> events, bool realtime = false);
+};
+
+#endif // REPLAYINPUTMONITOR_HH
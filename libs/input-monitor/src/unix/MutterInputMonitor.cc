@@ -23,30 +23,54 @@
 
 #include <memory>
 #include <chrono>
+#include <utility>
 
 #include "debug.hh"
 #include "utils/Diagnostics.hh"
 
 using namespace std;
+using namespace workrave::input_monitor;
+
+MutterInputMonitor::MutterInputMonitor(FallbackFactory create_fallback)
+  : create_fallback(std::move(create_fallback))
+{
+}
+
+MutterInputMonitor::MutterInputMonitor(GDBusConnection *peer)
+  : peer(G_DBUS_CONNECTION(g_object_ref(peer)))
+{
+}
 
 MutterInputMonitor::~MutterInputMonitor()
 {
+  if (monitor_thread && monitor_thread->joinable())
+    {
+      terminate();
+    }
+
   if (watch_id != 0)
     {
       g_bus_unwatch_name(watch_id);
     }
+  if (cancellable != nullptr)
+    {
+      g_cancellable_cancel(cancellable);
+      g_object_unref(cancellable);
+    }
   if (idle_proxy != nullptr)
     {
+      g_signal_handlers_disconnect_by_data(idle_proxy, this);
       g_object_unref(idle_proxy);
     }
   if (session_proxy != nullptr)
     {
+      g_signal_handlers_disconnect_by_data(session_proxy, this);
       g_object_unref(session_proxy);
     }
-
-  if (monitor_thread)
+  if (peer != nullptr)
     {
-      monitor_thread->join();
+      g_signal_handlers_disconnect_by_data(peer, this);
+      g_object_unref(peer);
     }
 }
 
@@ -54,85 +78,218 @@ bool
 MutterInputMonitor::init()
 {
   TRACE_ENTRY();
-  bool result = init_idle_monitor();
+  cancellable = g_cancellable_new();
 
-  if (result)
+  // The monitor starts degraded and upgrades once the watches are registered.
+  if (peer != nullptr)
     {
-      init_inhibitors();
+      // Without a bus daemon there is no name to watch: the idle monitor is there while the connection is open.
+      g_signal_connect(peer, "closed", G_CALLBACK(on_peer_closed), this);
+      service_seen = true;
+      init_idle_monitor();
+    }
+  else
+    {
+      // Setup continues in on_bus_name_appeared(), or falls back in on_bus_name_vanished().
       init_service_monitor();
+      init_inhibitors();
     }
 
-  return result;
+  monitor_thread = std::make_shared<std::thread>([this] { run(); });
+  return true;
+}
+
+bool
+MutterInputMonitor::is_ready() const
+{
+  return ready;
 }
 
 bool
+MutterInputMonitor::is_falling_back() const
+{
+  return falling_back;
+}
+
+void
+MutterInputMonitor::start_fallback()
+{
+  TRACE_ENTRY();
+  if (fallback || !create_fallback)
+    {
+      return;
+    }
+
+  fallback = create_fallback();
+  if (fallback)
+    {
+      Diagnostics::instance().log("mutter: not running, using fallback monitor");
+      fallback->subscribe(static_cast<IInputMonitorListener *>(this));
+      falling_back = true;
+    }
+}
+
+void
+MutterInputMonitor::stop_fallback()
+{
+  TRACE_ENTRY();
+  if (fallback)
+    {
+      Diagnostics::instance().log("mutter: stopping fallback monitor");
+      falling_back = false;
+      fallback->unsubscribe(static_cast<IInputMonitorListener *>(this));
+      fallback->terminate();
+      fallback.reset();
+    }
+}
+
+void
+MutterInputMonitor::action_notify()
+{
+  fire_action();
+}
+
+void
+MutterInputMonitor::mouse_notify(int x, int y, int wheel)
+{
+  fire_mouse(x, y, wheel);
+}
+
+void
+MutterInputMonitor::button_notify(bool is_press)
+{
+  fire_button(is_press);
+}
+
+void
+MutterInputMonitor::keyboard_notify(bool repeat)
+{
+  fire_keyboard(repeat);
+}
+
+void
 MutterInputMonitor::init_idle_monitor()
 {
   TRACE_ENTRY();
-  GError *error = nullptr;
-  bool result = true;
-
-  idle_proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-                                             G_DBUS_PROXY_FLAGS_NONE,
-                                             nullptr,
-                                             "org.gnome.Mutter.IdleMonitor",
-                                             "/org/gnome/Mutter/IdleMonitor/Core",
-                                             "org.gnome.Mutter.IdleMonitor",
-                                             nullptr,
-                                             &error);
-  if (error == nullptr)
+  if (peer != nullptr)
     {
-      g_signal_connect(idle_proxy, "g-signal", G_CALLBACK(on_idle_monitor_signal), this);
+      g_dbus_proxy_new(peer,
+                       G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                       nullptr,
+                       nullptr,
+                       "/org/gnome/Mutter/IdleMonitor/Core",
+                       "org.gnome.Mutter.IdleMonitor",
+                       cancellable,
+                       on_idle_proxy_ready,
+                       this);
+      return;
+    }
 
-      result = register_active_watch();
-      if (result)
-        {
-          result = register_idle_watch();
-          if (!result)
-            {
-              unregister_active_watch();
-            }
-        }
+  g_dbus_proxy_new_for_bus(G_BUS_TYPE_SESSION,
+                           G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES,
+                           nullptr,
+                           "org.gnome.Mutter.IdleMonitor",
+                           "/org/gnome/Mutter/IdleMonitor/Core",
+                           "org.gnome.Mutter.IdleMonitor",
+                           cancellable,
+                           on_idle_proxy_ready,
+                           this);
+}
 
-      if (result)
+void
+MutterInputMonitor::on_idle_proxy_ready(GObject *object, GAsyncResult *res, gpointer user_data)
+{
+  TRACE_ENTRY();
+  (void)object;
+  GError *error = nullptr;
+  GDBusProxy *proxy = g_dbus_proxy_new_finish(res, &error);
+  if (error != nullptr)
+    {
+      // On cancellation the monitor may already be gone.
+      if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
         {
-          monitor_thread = std::make_shared<std::thread>([this] { run(); });
+          TRACE_MSG("Error: {}", error->message);
+          Diagnostics::instance().log(std::string("mutter: no idle monitor: ") + error->message);
         }
+      g_error_free(error);
+      return;
     }
-  else
+
+  auto *self = (MutterInputMonitor *)user_data;
+  if (self->idle_proxy != nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
-      g_error_free(error);
-      result = false;
+      // The name appeared more than once while connecting.
+      g_object_unref(proxy);
+      return;
     }
 
-  return result;
+  g_signal_connect(proxy, "g-signal", G_CALLBACK(on_idle_monitor_signal), self);
+  {
+    std::scoped_lock lock(self->mutex);
+    self->idle_proxy = proxy;
+  }
+  self->register_watches_async();
+}
+
+GDBusProxy *
+MutterInputMonitor::get_idle_proxy()
+{
+  std::scoped_lock lock(mutex);
+  return idle_proxy != nullptr ? G_DBUS_PROXY(g_object_ref(idle_proxy)) : nullptr;
 }
 
 void
 MutterInputMonitor::init_inhibitors()
 {
   TRACE_ENTRY();
-  session_proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-                                                G_DBUS_PROXY_FLAGS_NONE,
-                                                nullptr,
-                                                "org.gnome.SessionManager",
-                                                "/org/gnome/SessionManager",
-                                                "org.gnome.SessionManager",
-                                                nullptr,
-                                                nullptr);
-  if (session_proxy != nullptr)
+  g_dbus_proxy_new_for_bus(G_BUS_TYPE_SESSION,
+                           G_DBUS_PROXY_FLAGS_NONE,
+                           nullptr,
+                           "org.gnome.SessionManager",
+                           "/org/gnome/SessionManager",
+                           "org.gnome.SessionManager",
+                           cancellable,
+                           on_session_proxy_ready,
+                           this);
+}
+
+void
+MutterInputMonitor::on_session_proxy_ready(GObject *object, GAsyncResult *res, gpointer user_data)
+{
+  TRACE_ENTRY();
+  (void)object;
+  GError *error = nullptr;
+  GDBusProxy *proxy = g_dbus_proxy_new_for_bus_finish(res, &error);
+  if (error != nullptr)
     {
-      g_signal_connect(session_proxy, "g-properties-changed", G_CALLBACK(on_session_manager_property_changed), this);
+      if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+          TRACE_MSG("Error: {}", error->message);
+        }
+      g_error_free(error);
+      return;
+    }
+
+  auto *self = (MutterInputMonitor *)user_data;
+  self->session_proxy = proxy;
+  g_signal_connect(proxy, "g-properties-changed", G_CALLBACK(on_session_manager_property_changed), self);
 
-      GVariant *v = g_dbus_proxy_get_cached_property(session_proxy, "InhibitedActions");
-      inhibited = (g_variant_get_uint32(v) & GSM_INHIBITOR_FLAG_IDLE) != 0;
-      trace_inhibited = inhibited;
-      TRACE_MSG("Inhibited: {} {}", g_variant_get_uint32(v), inhibited);
+  GVariant *v = g_dbus_proxy_get_cached_property(proxy, "InhibitedActions");
+  if (v != nullptr)
+    {
+      self->set_inhibited(v);
       g_variant_unref(v);
     }
 }
 
+void
+MutterInputMonitor::set_inhibited(GVariant *inhibited_actions)
+{
+  inhibited = (g_variant_get_uint32(inhibited_actions) & GSM_INHIBITOR_FLAG_IDLE) != 0;
+  trace_inhibited = inhibited;
+  TRACE_MSG("Inhibited: {} {}", g_variant_get_uint32(inhibited_actions), inhibited);
+}
+
 void
 MutterInputMonitor::on_bus_name_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data)
 {
@@ -141,16 +298,48 @@ MutterInputMonitor::on_bus_name_appeared(GDBusConnection *connection, const gcha
   (void)name;
   (void)name_owner;
   auto *self = (MutterInputMonitor *)user_data;
-  if (self->watch_active != 0u)
+  self->service_seen = true;
+
+  if (self->idle_proxy == nullptr)
     {
-      self->register_active_watch();
+      self->init_idle_monitor();
     }
-  if (self->watch_idle != 0u)
+  else
     {
-      self->register_idle_watch();
+      // Mutter was restarted and lost all watches.
+      self->register_watches_async();
     }
 }
 
+void
+MutterInputMonitor::on_bus_name_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data)
+{
+  TRACE_ENTRY_PAR(name);
+  (void)connection;
+  (void)name;
+  auto *self = (MutterInputMonitor *)user_data;
+
+  self->ready = false;
+  self->trace_ready = false;
+  self->watch_active = 0;
+  self->watch_idle = 0;
+
+  if (!self->service_seen)
+    {
+      // Mutter is not running at all, e.g. on another desktop.
+      self->start_fallback();
+    }
+}
+
+void
+MutterInputMonitor::on_peer_closed(GDBusConnection *connection, gboolean remote_peer_vanished, GError *error, gpointer user_data)
+{
+  TRACE_ENTRY();
+  (void)remote_peer_vanished;
+  (void)error;
+  on_bus_name_vanished(connection, "org.gnome.Mutter.IdleMonitor", user_data);
+}
+
 void
 MutterInputMonitor::init_service_monitor()
 {
@@ -159,31 +348,57 @@ MutterInputMonitor::init_service_monitor()
                               "org.gnome.Mutter.IdleMonitor",
                               G_BUS_NAME_WATCHER_FLAGS_NONE,
                               on_bus_name_appeared,
-                              nullptr,
+                              on_bus_name_vanished,
                               this,
                               nullptr);
 }
 
-bool
-MutterInputMonitor::register_active_watch()
+void
+MutterInputMonitor::register_watches_async()
 {
   TRACE_ENTRY();
-  GError *error = nullptr;
-  GVariant *reply = g_dbus_proxy_call_sync(idle_proxy, "AddUserActiveWatch", nullptr, G_DBUS_CALL_FLAGS_NONE, 10000, nullptr, &error);
+  ready = false;
+  trace_ready = false;
+  watch_active = 0;
+  watch_idle = 0;
 
-  if (error == nullptr)
-    {
-      guint watch = 0;
-      g_variant_get(reply, "(u)", &watch);
-      watch_active = active;
-      g_variant_unref(reply);
-    }
-  else
+  g_dbus_proxy_call(idle_proxy,
+                    "AddIdleWatch",
+                    g_variant_new("(t)", 500),
+                    G_DBUS_CALL_FLAGS_NONE,
+                    -1,
+                    cancellable,
+                    on_register_idle_watch_reply,
+                    this);
+  register_active_watch_async();
+}
+
+void
+MutterInputMonitor::on_register_idle_watch_reply(GObject *object, GAsyncResult *res, gpointer user_data)
+{
+  TRACE_ENTRY();
+  GError *error = nullptr;
+  GVariant *params = g_dbus_proxy_call_finish(G_DBUS_PROXY(object), res, &error);
+  if (error != nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
+      if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+          TRACE_MSG("Error: {}", error->message);
+        }
       g_error_free(error);
+      return;
     }
-  return error == nullptr;
+
+  auto *self = (MutterInputMonitor *)user_data;
+  guint watch = 0;
+  g_variant_get(params, "(u)", &watch);
+  g_variant_unref(params);
+
+  self->watch_idle = watch;
+  self->ready = true;
+  self->trace_ready = true;
+  Diagnostics::instance().log("mutter: watches registered");
+  self->stop_fallback();
 }
 
 void
@@ -194,8 +409,8 @@ MutterInputMonitor::register_active_watch_async()
                     "AddUserActiveWatch",
                     nullptr,
                     G_DBUS_CALL_FLAGS_NONE,
-                    10000,
-                    nullptr,
+                    -1,
+                    cancellable,
                     on_register_active_watch_reply,
                     this);
 }
@@ -205,51 +420,24 @@ MutterInputMonitor::on_register_active_watch_reply(GObject *object, GAsyncResult
 {
   TRACE_ENTRY();
   GError *error = nullptr;
-  GDBusProxy *proxy = G_DBUS_PROXY(object);
-  auto *self = (MutterInputMonitor *)user_data;
-
-  GVariant *params = g_dbus_proxy_call_finish(proxy, res, &error);
-  if (error)
+  GVariant *params = g_dbus_proxy_call_finish(G_DBUS_PROXY(object), res, &error);
+  if (error != nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
-      g_clear_error(&error);
+      if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+          TRACE_MSG("Error: {}", error->message);
+        }
+      g_error_free(error);
       return;
     }
 
+  auto *self = (MutterInputMonitor *)user_data;
   guint watch = 0;
   g_variant_get(params, "(u)", &watch);
   self->watch_active = watch;
   g_variant_unref(params);
 }
 
-bool
-MutterInputMonitor::unregister_active_watch()
-{
-  TRACE_ENTRY();
-  GError *error = nullptr;
-  if (watch_active != 0u)
-    {
-      GVariant *result = g_dbus_proxy_call_sync(idle_proxy,
-                                                "RemoveWatch",
-                                                g_variant_new("(u)", watch_active.get()),
-                                                G_DBUS_CALL_FLAGS_NONE,
-                                                10000,
-                                                nullptr,
-                                                &error);
-      if (error == nullptr)
-        {
-          g_variant_unref(result);
-          watch_active = 0;
-        }
-      else
-        {
-          TRACE_MSG("Error: {}", error->message);
-          g_error_free(error);
-        }
-    }
-  return error == nullptr;
-}
-
 void
 MutterInputMonitor::unregister_active_watch_async()
 {
@@ -260,8 +448,8 @@ MutterInputMonitor::unregister_active_watch_async()
                         "RemoveWatch",
                         g_variant_new("(u)", watch_active.get()),
                         G_DBUS_CALL_FLAGS_NONE,
-                        10000,
-                        nullptr,
+                        -1,
+                        cancellable,
                         on_unregister_active_watch_reply,
                         this);
     }
@@ -272,82 +460,64 @@ MutterInputMonitor::on_unregister_active_watch_reply(GObject *object, GAsyncResu
 {
   TRACE_ENTRY();
   GError *error = nullptr;
-  GDBusProxy *proxy = G_DBUS_PROXY(object);
-  auto *self = (MutterInputMonitor *)user_data;
-
-  g_dbus_proxy_call_finish(proxy, res, &error);
-  if (error)
+  GVariant *params = g_dbus_proxy_call_finish(G_DBUS_PROXY(object), res, &error);
+  if (error != nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
-      g_clear_error(&error);
+      if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        {
+          TRACE_MSG("Error: {}", error->message);
+        }
+      g_error_free(error);
       return;
     }
+
+  auto *self = (MutterInputMonitor *)user_data;
   self->watch_active = 0;
+  g_variant_unref(params);
 }
 
-bool
-MutterInputMonitor::register_idle_watch()
+//! Removes the watches without waiting for Mutter to reply.
+void
+MutterInputMonitor::unregister_watches()
 {
   TRACE_ENTRY();
-  GError *error = nullptr;
-  GVariant *reply =
-    g_dbus_proxy_call_sync(idle_proxy, "AddIdleWatch", g_variant_new("(t)", 500), G_DBUS_CALL_FLAGS_NONE, 10000, nullptr, &error);
-
-  if (error == nullptr)
-    {
-      guint watch = 0;
-      g_variant_get(reply, "(u)", &watch);
-      watch_idle = watch;
-      g_variant_unref(reply);
-    }
-  else
+  if (idle_proxy == nullptr)
     {
-      TRACE_MSG("Error: {}", error->message);
-      g_error_free(error);
+      return;
     }
-  return error == nullptr;
-}
 
-bool
-MutterInputMonitor::unregister_idle_watch()
-{
-  TRACE_ENTRY();
-  GError *error = nullptr;
-  if (watch_idle != 0u)
+  for (guint watch: {watch_idle.get(), watch_active.get()})
     {
-      GVariant *result = g_dbus_proxy_call_sync(idle_proxy,
-                                                "RemoveWatch",
-                                                g_variant_new("(u)", watch_idle.get()),
-                                                G_DBUS_CALL_FLAGS_NONE,
-                                                10000,
-                                                nullptr,
-                                                &error);
-      if (error == nullptr)
+      if (watch != 0u)
         {
-          g_variant_unref(result);
-          watch_idle = 0;
-        }
-      else
-        {
-          TRACE_MSG("Error: {}", error->message);
-          g_error_free(error);
+          g_dbus_proxy_call(idle_proxy, "RemoveWatch", g_variant_new("(u)", watch), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr, nullptr);
         }
     }
-  return error == nullptr;
+  watch_idle = 0;
+  watch_active = 0;
+  ready = false;
+  trace_ready = false;
 }
 
 void
 MutterInputMonitor::terminate()
 {
-  unregister_idle_watch();
-  unregister_active_watch();
+  if (cancellable != nullptr)
+    {
+      g_cancellable_cancel(cancellable);
+    }
+  unregister_watches();
+  stop_fallback();
 
   mutex.lock();
   abort = true;
   cond.notify_all();
   mutex.unlock();
 
-  monitor_thread->join();
+  if (monitor_thread && monitor_thread->joinable())
+    {
+      monitor_thread->join();
+    }
 }
 
 void
@@ -399,9 +569,7 @@ MutterInputMonitor::on_session_manager_property_changed(GDBusProxy *session, GVa
   GVariant *v = g_variant_lookup_value(changed, "InhibitedActions", G_VARIANT_TYPE_UINT32);
   if (v != nullptr)
     {
-      self->inhibited = g_variant_get_uint32(v) & GSM_INHIBITOR_FLAG_IDLE;
-      self->trace_inhibited = self->inhibited;
-      TRACE_MSG("Inhibited: {}", g_variant_get_uint32(v));
+      self->set_inhibited(v);
       g_variant_unref(v);
     }
 }
@@ -410,39 +578,50 @@ void
 MutterInputMonitor::run()
 {
   TRACE_ENTRY();
-  {
-    std::unique_lock lock(mutex);
-    while (!abort)
-      {
-        bool local_active = active;
-
-        if (inhibited)
-          {
-            GError *error = nullptr;
-            guint64 idletime;
-            GVariant *reply = g_dbus_proxy_call_sync(idle_proxy, "GetIdletime", nullptr, G_DBUS_CALL_FLAGS_NONE, 10000, nullptr, &error);
-            if (error == nullptr)
-              {
-
-                g_variant_get(reply, "(t)", &idletime);
-                g_variant_unref(reply);
-                Diagnostics::instance().log("mutter: " + std::to_string(idletime));
-                local_active = idletime < 1000;
-              }
-            else
-              {
-                TRACE_MSG("Error: {}", error->message);
-                g_error_free(error);
-              }
-          }
-
-        if (local_active)
-          {
-            /* Notify the activity monitor */
-            fire_action();
-          }
-
-        cond.wait_for(lock, std::chrono::milliseconds(1000));
-      }
-  }
+  std::unique_lock lock(mutex);
+  while (!abort)
+    {
+      lock.unlock();
+
+      bool local_active = active;
+
+      // Poll the idle time while the watches are not (yet) registered, or
+      // when idle is inhibited. Skip the D-Bus round trip if no listener
+      // wants activity now.
+      if ((!ready || inhibited) && wants_event(InputEventType::Action))
+        {
+          GDBusProxy *proxy = get_idle_proxy();
+          if (proxy != nullptr)
+            {
+              GError *error = nullptr;
+              GVariant *reply = g_dbus_proxy_call_sync(proxy, "GetIdletime", nullptr, G_DBUS_CALL_FLAGS_NONE, DBUS_TIMEOUT_MS, nullptr, &error);
+              if (error == nullptr)
+                {
+                  guint64 idletime = 0;
+                  g_variant_get(reply, "(t)", &idletime);
+                  g_variant_unref(reply);
+                  Diagnostics::instance().log("mutter: " + std::to_string(idletime));
+                  local_active = idletime < 1000;
+                }
+              else
+                {
+                  TRACE_MSG("Error: {}", error->message);
+                  g_error_free(error);
+                }
+              g_object_unref(proxy);
+            }
+        }
+
+      if (local_active)
+        {
+          /* Notify the activity monitor */
+          fire_action();
+        }
+
+      lock.lock();
+      if (!abort)
+        {
+          cond.wait_for(lock, std::chrono::milliseconds(1000));
+        }
+    }
 }
@@ -18,57 +18,102 @@
 #ifndef MUTTERINPUTMONITOR_HH
 #define MUTTERINPUTMONITOR_HH
 
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <functional>
 #include <condition_variable>
 
 #include "InputMonitor.hh"
+#include "input-monitor/IInputMonitorListener.hh"
 #include "utils/Diagnostics.hh"
 
 #include <gio/gio.h>
 #include <atomic>
 
-class MutterInputMonitor : public InputMonitor
+//! Input monitor that uses the idle monitor of Mutter (GNOME Shell).
+/*!
+ *  All D-Bus setup is asynchronous. Until the idle and active watches are
+ *  registered, the monitor runs degraded and polls the idle time instead.
+ *  If Mutter is not running at startup, the monitor forwards the events of
+ *  a fallback monitor until Mutter appears.
+ */
+class MutterInputMonitor
+  : public InputMonitor
+  , public workrave::input_monitor::IInputMonitorListener
 {
 public:
+  //! Creates and initializes the monitor to use while Mutter is not running.
+  using FallbackFactory = std::function<workrave::input_monitor::IInputMonitor::Ptr()>;
+
   MutterInputMonitor() = default;
+  explicit MutterInputMonitor(FallbackFactory create_fallback);
+
+  //! Talks to an idle monitor on a peer-to-peer connection instead of the session bus.
+  explicit MutterInputMonitor(GDBusConnection *peer);
+
   ~MutterInputMonitor() override;
 
   bool init() override;
   void terminate() override;
 
+  //! Returns true once the watches are registered with Mutter.
+  bool is_ready() const;
+
+  //! Returns whether the events of a fallback monitor are forwarded.
+  bool is_falling_back() const;
+
+  // IInputMonitorListener, for the fallback monitor.
+  void action_notify() override;
+  void mouse_notify(int x, int y, int wheel) override;
+  void button_notify(bool is_press) override;
+  void keyboard_notify(bool repeat) override;
+
 private:
   static void on_idle_monitor_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVariant *parameters, gpointer user_data);
   static void on_session_manager_property_changed(GDBusProxy *session, GVariant *changed, char **invalidated, gpointer user_data);
 
+  static void on_idle_proxy_ready(GObject *source_object, GAsyncResult *res, gpointer user_data);
+  static void on_session_proxy_ready(GObject *source_object, GAsyncResult *res, gpointer user_data);
   static void on_register_active_watch_reply(GObject *source_object, GAsyncResult *res, gpointer user_data);
+  static void on_register_idle_watch_reply(GObject *source_object, GAsyncResult *res, gpointer user_data);
   static void on_unregister_active_watch_reply(GObject *source_object, GAsyncResult *res, gpointer user_data);
 
   static void on_bus_name_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
+  static void on_bus_name_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data);
+  static void on_peer_closed(GDBusConnection *connection, gboolean remote_peer_vanished, GError *error, gpointer user_data);
 
   virtual void run();
 
-  bool register_active_watch();
-  bool unregister_active_watch();
+  void register_watches_async();
   void register_active_watch_async();
   void unregister_active_watch_async();
-  bool register_idle_watch();
-  bool unregister_idle_watch();
+  void unregister_watches();
+  void set_inhibited(GVariant *inhibited_actions);
+  GDBusProxy *get_idle_proxy();
 
-  bool init_idle_monitor();
+  void init_idle_monitor();
   void init_inhibitors();
   void init_service_monitor();
+  void start_fallback();
+  void stop_fallback();
 
 private:
   static const int GSM_INHIBITOR_FLAG_IDLE = 8;
 
+  //! Timeout of D-Bus calls on the monitor thread.
+  static const int DBUS_TIMEOUT_MS = 1000;
+
   GDBusProxy *idle_proxy = nullptr;
   GDBusProxy *session_proxy = nullptr;
+  GCancellable *cancellable = nullptr;
   std::atomic<bool> active{false};
   std::atomic<bool> inhibited{false};
+  std::atomic<bool> ready{false};
   TracedField<bool> trace_active{"monitor.mutter.active", false};
   TracedField<bool> trace_inhibited{"monitor.inhibited", false};
+  TracedField<bool> trace_ready{"monitor.mutter.ready", false};
   TracedField<guint> watch_active{"monitor.mutter.watch_active", 0};
   TracedField<guint> watch_idle{"monitor.mutter.watch_idle", 0};
 
@@ -77,6 +122,12 @@ private:
   std::mutex mutex;
   std::condition_variable cond;
   guint watch_id{0};
+
+  GDBusConnection *peer{nullptr};
+  bool service_seen{false};
+  FallbackFactory create_fallback;
+  workrave::input_monitor::IInputMonitor::Ptr fallback;
+  std::atomic<bool> falling_back{false};
 };
 
 #endif // MUTTERINPUTMONITOR_HH
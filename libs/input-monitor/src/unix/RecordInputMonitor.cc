@@ -43,6 +43,7 @@
 #include <chrono>
 
 using namespace std;
+using namespace workrave::input_monitor;
 
 int RecordInputMonitor::xi_event_base = 0;
 
@@ -75,7 +76,7 @@ RecordInputMonitor::RecordInputMonitor(const char *display_name)
 RecordInputMonitor::~RecordInputMonitor()
 {
   TRACE_ENTRY();
-  if (monitor_thread != nullptr)
+  if (monitor_thread != nullptr && monitor_thread->joinable())
     {
       monitor_thread->join();
     }
@@ -154,6 +155,11 @@ RecordInputMonitor::handle_xrecord_motion_event(XRecordInterceptData *data)
   TRACE_ENTRY();
   auto *event = (xEvent *)data->data;
 
+  if (!wants_event(InputEventType::Mouse))
+    {
+      return;
+    }
+
   if (event != nullptr)
     {
       int x = event->u.keyButtonPointer.rootX;
@@ -215,7 +221,7 @@ RecordInputMonitor::handle_xrecord_device_motion_event(XRecordInterceptData *dat
   auto *event = (deviceKeyButtonPointer *)data->data;
   static Time last_time = 0;
 
-  if (event->time != last_time)
+  if (event->time != last_time && wants_event(InputEventType::Mouse))
     {
       last_time = event->time;
       int x = event->root_x;
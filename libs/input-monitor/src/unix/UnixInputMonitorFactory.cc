@@ -33,6 +33,9 @@
 #include "X11InputMonitor.hh"
 #include "XScreenSaverMonitor.hh"
 #include "MutterInputMonitor.hh"
+#if defined(HAVE_XI2)
+#  include "XI2InputMonitor.hh"
+#endif
 
 using namespace std;
 using namespace workrave;
@@ -53,6 +56,31 @@ UnixInputMonitorFactory::init(const char *display)
   this->display = display;
 }
 
+//! Creates, but does not initialize, the monitor of the given method other than mutter.
+IInputMonitor::Ptr
+UnixInputMonitorFactory::create_monitor_for_method(const std::string &monitor_method, IConfigurator::Ptr config, const char *display)
+{
+  if (monitor_method == "record")
+    {
+      return IInputMonitor::Ptr(new RecordInputMonitor(display));
+    }
+  if (monitor_method == "screensaver")
+    {
+      return IInputMonitor::Ptr(new XScreenSaverMonitor(config));
+    }
+  if (monitor_method == "x11events")
+    {
+      return IInputMonitor::Ptr(new X11InputMonitor(display));
+    }
+#if defined(HAVE_XI2)
+  if (monitor_method == "xi2")
+    {
+      return IInputMonitor::Ptr(new XI2InputMonitor(config, display));
+    }
+#endif
+  return nullptr;
+}
+
 //! Retrieves the input activity monitor
 IInputMonitor::Ptr
 UnixInputMonitorFactory::create_monitor(MonitorCapability capability)
@@ -93,24 +121,28 @@ UnixInputMonitorFactory::create_monitor(MonitorCapability capability)
           monitor_method = *loop;
           TRACE_MSG("Test {}", monitor_method);
 
-          if (monitor_method == "record")
-            {
-              monitor = IInputMonitor::Ptr(new RecordInputMonitor(display));
-            }
-          else if (monitor_method == "screensaver")
-            {
-              monitor = IInputMonitor::Ptr(new XScreenSaverMonitor());
-            }
-          else if (monitor_method == "x11events")
+          if (monitor_method == "mutter")
             {
-              monitor = IInputMonitor::Ptr(new X11InputMonitor(display));
+              // Whether Mutter runs is only known asynchronously, so it falls back to the other monitors by itself.
+              auto create_fallback = [config = config, display = display, available_monitors]() -> IInputMonitor::Ptr {
+                for (const auto &method: available_monitors)
+                  {
+                    IInputMonitor::Ptr fallback = method != "mutter" ? create_monitor_for_method(method, config, display) : nullptr;
+                    if (fallback && fallback->init())
+                      {
+                        return fallback;
+                      }
+                  }
+                return nullptr;
+              };
+              monitor = IInputMonitor::Ptr(new MutterInputMonitor(create_fallback));
             }
-          else if (monitor_method == "mutter")
+          else
             {
-              monitor = IInputMonitor::Ptr(new MutterInputMonitor());
+              monitor = create_monitor_for_method(monitor_method, config, display);
             }
 
-          initialized = monitor->init();
+          initialized = monitor && monitor->init();
 
           if (initialized)
             {
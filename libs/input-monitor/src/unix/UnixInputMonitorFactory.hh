@@ -31,6 +31,10 @@ public:
   workrave::input_monitor::IInputMonitor::Ptr create_monitor(workrave::input_monitor::MonitorCapability capability) override;
 
 private:
+  static workrave::input_monitor::IInputMonitor::Ptr create_monitor_for_method(const std::string &monitor_method,
+                                                                               workrave::config::IConfigurator::Ptr config,
+                                                                               const char *display);
+
   bool error_reported;
   TracedField<std::string> actual_monitor_method;
   workrave::input_monitor::IInputMonitor::Ptr monitor;
@@ -42,6 +42,7 @@
 #endif
 
 using namespace std;
+using namespace workrave::input_monitor;
 
 #if !defined(HAVE_APP_GTK)
 static int (*old_handler)(Display *dpy, XErrorEvent *error);
@@ -188,18 +189,21 @@ X11InputMonitor::run()
           error_trap_exit();
         }
 
-      // timeout
-      Window root, child;
-      int root_x, root_y, win_x, win_y;
-      unsigned mask;
+      // timeout, skip the round trip if no listener wants the position now.
+      if (wants_event(InputEventType::Mouse))
+        {
+          Window root, child;
+          int root_x, root_y, win_x, win_y;
+          unsigned mask;
 
-      error_trap_enter();
+          error_trap_enter();
 
-      XQueryPointer(x11_display, root_window, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask);
+          XQueryPointer(x11_display, root_window, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask);
 
-      error_trap_exit();
+          error_trap_exit();
 
-      fire_mouse(root_x, root_y);
+          fire_mouse(root_x, root_y);
+        }
     }
 }
 
@@ -0,0 +1,282 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "XI2InputMonitor.hh"
+
+#include <algorithm>
+#include <poll.h>
+#include <unistd.h>
+
+#include <X11/extensions/XInput2.h>
+
+#include "debug.hh"
+#include "utils/TimeSource.hh"
+
+using namespace workrave::config;
+using namespace workrave::input_monitor;
+using namespace workrave::utils;
+
+XI2InputMonitor::XI2InputMonitor(IConfigurator::Ptr config, const char *display_name)
+  : config(config)
+  , x11_display_name(display_name)
+{
+}
+
+XI2InputMonitor::~XI2InputMonitor()
+{
+  TRACE_ENTRY();
+  if (monitor_thread != nullptr)
+    {
+      terminate();
+    }
+
+  if (x11_display != nullptr)
+    {
+      XCloseDisplay(x11_display);
+    }
+
+  for (int fd: wakeup_pipe)
+    {
+      if (fd != -1)
+        {
+          close(fd);
+        }
+    }
+}
+
+bool
+XI2InputMonitor::init()
+{
+  TRACE_ENTRY();
+  int rate = 0;
+  config->get_value_with_default("advanced/xi2-motion-rate", rate, 100);
+  motion_interval = rate > 0 ? 1000000 / rate : 0;
+
+  bool ok = init_xi2();
+  if (ok)
+    {
+      monitor_thread = std::make_shared<std::thread>([this] { run(); });
+    }
+  return ok;
+}
+
+void
+XI2InputMonitor::terminate()
+{
+  TRACE_ENTRY();
+  abort = true;
+
+  if (wakeup_pipe[1] != -1)
+    {
+      char c = 0;
+      [[maybe_unused]] auto r = write(wakeup_pipe[1], &c, 1);
+    }
+
+  if (monitor_thread != nullptr)
+    {
+      monitor_thread->join();
+      monitor_thread.reset();
+    }
+}
+
+bool
+XI2InputMonitor::init_xi2()
+{
+  TRACE_ENTRY();
+  x11_display = XOpenDisplay(x11_display_name);
+  if (x11_display == nullptr)
+    {
+      return false;
+    }
+
+  int event_base = 0;
+  int error_base = 0;
+  int major = 2;
+  int minor = 2;
+
+  bool ok = XQueryExtension(x11_display, "XInputExtension", &xi_opcode, &event_base, &error_base)
+            && XIQueryVersion(x11_display, &major, &minor) == Success && major >= 2;
+
+  if (ok)
+    {
+      TRACE_MSG("Using XI {}.{}", major, minor);
+      root_window = DefaultRootWindow(x11_display);
+
+      unsigned char mask_bits[XIMaskLen(XI_LASTEVENT)] = {0};
+      XISetMask(mask_bits, XI_RawKeyPress);
+      XISetMask(mask_bits, XI_RawButtonPress);
+      XISetMask(mask_bits, XI_RawButtonRelease);
+      XISetMask(mask_bits, XI_RawMotion);
+
+      XIEventMask mask;
+      mask.deviceid = XIAllMasterDevices;
+      mask.mask_len = sizeof(mask_bits);
+      mask.mask = mask_bits;
+
+      ok = XISelectEvents(x11_display, root_window, &mask, 1) == Success;
+      XSync(x11_display, False);
+    }
+
+  if (ok)
+    {
+      ok = pipe(wakeup_pipe) == 0;
+    }
+
+  if (!ok)
+    {
+      XCloseDisplay(x11_display);
+      x11_display = nullptr;
+    }
+
+  TRACE_MSG("ok = {}", ok);
+  return ok;
+}
+
+void
+XI2InputMonitor::run()
+{
+  TRACE_ENTRY();
+  struct pollfd fds[2];
+  fds[0].fd = ConnectionNumber(x11_display);
+  fds[0].events = POLLIN;
+  fds[1].fd = wakeup_pipe[0];
+  fds[1].events = POLLIN;
+
+  while (!abort)
+    {
+      process_events();
+
+      int timeout = -1;
+      if (motion_pending)
+        {
+          int64_t remaining = last_motion_time + motion_interval - TimeSource::get_monotonic_time_usec();
+          timeout = static_cast<int>(std::max<int64_t>(0, (remaining + 999) / 1000));
+        }
+
+      if (!abort && XPending(x11_display) == 0)
+        {
+          poll(fds, 2, timeout);
+        }
+
+      if (motion_pending)
+        {
+          flush_motion(TimeSource::get_monotonic_time_usec());
+        }
+    }
+}
+
+void
+XI2InputMonitor::process_events()
+{
+  while (XPending(x11_display) > 0)
+    {
+      XEvent event;
+      XNextEvent(x11_display, &event);
+
+      XGenericEventCookie *cookie = &event.xcookie;
+      if (cookie->type == GenericEvent && cookie->extension == xi_opcode && XGetEventData(x11_display, cookie))
+        {
+          handle_raw_event(cookie);
+          XFreeEventData(x11_display, cookie);
+        }
+    }
+}
+
+void
+XI2InputMonitor::handle_raw_event(XGenericEventCookie *cookie)
+{
+  auto *raw = static_cast<XIRawEvent *>(cookie->data);
+
+  switch (cookie->evtype)
+    {
+    case XI_RawKeyPress:
+      // XIKeyRepeat is only set on device events, never on raw events.
+      fire_keyboard(false);
+      break;
+
+    case XI_RawButtonPress:
+    case XI_RawButtonRelease:
+      // Buttons 4-7 are the (emulated) scroll wheel.
+      if (raw->detail >= 4 && raw->detail <= 7)
+        {
+          if (cookie->evtype == XI_RawButtonPress)
+            {
+              fire_pointer((raw->detail == 4 || raw->detail == 6) ? 1 : -1);
+            }
+        }
+      else
+        {
+          fire_button(cookie->evtype == XI_RawButtonPress);
+        }
+      break;
+
+    case XI_RawMotion:
+      handle_motion(TimeSource::get_monotonic_time_usec());
+      break;
+
+    default:
+      break;
+    }
+}
+
+void
+XI2InputMonitor::handle_motion(int64_t now)
+{
+  motion_pending = true;
+  flush_motion(now);
+}
+
+void
+XI2InputMonitor::flush_motion(int64_t now)
+{
+  if (motion_pending && now >= last_motion_time + motion_interval)
+    {
+      motion_pending = false;
+      last_motion_time = now;
+      fire_pointer(0);
+    }
+}
+
+void
+XI2InputMonitor::fire_pointer(int wheel)
+{
+  if (!wants_event(InputEventType::Mouse))
+    {
+      return;
+    }
+
+  Window root = 0;
+  Window child = 0;
+  int root_x = -1;
+  int root_y = -1;
+  int win_x = 0;
+  int win_y = 0;
+  unsigned int mask = 0;
+
+  if (XQueryPointer(x11_display, root_window, &root, &child, &root_x, &root_y, &win_x, &win_y, &mask))
+    {
+      fire_mouse(root_x, root_y, wheel);
+    }
+  else
+    {
+      fire_action();
+    }
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef XI2INPUTMONITOR_HH
+#define XI2INPUTMONITOR_HH
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <X11/X.h>
+#include <X11/Xlib.h>
+
+#include "InputMonitor.hh"
+#include "config/IConfigurator.hh"
+
+//! Activity monitor using XInput2 raw events on the root window.
+/*!
+ *  Raw events are delivered for all devices without a second connection or
+ *  the XRecord extension. Pointer motion is coalesced to at most
+ *  'advanced/xi2-motion-rate' reports per second; the pointer position is
+ *  only queried for reported motion.
+ */
+class XI2InputMonitor : public InputMonitor
+{
+public:
+  //! Constructor.
+  XI2InputMonitor(workrave::config::IConfigurator::Ptr config, const char *display_name);
+
+  //! Destructor.
+  ~XI2InputMonitor() override;
+
+  //! Initialize
+  bool init() override;
+
+  //! Terminate the monitor.
+  void terminate() override;
+
+private:
+  //! The monitor's execution thread.
+  void run();
+
+  //! Initialize XInput2 and select the raw events.
+  bool init_xi2();
+
+  void process_events();
+  void handle_raw_event(XGenericEventCookie *cookie);
+  void handle_motion(int64_t now);
+  void flush_motion(int64_t now);
+  void fire_pointer(int wheel);
+
+private:
+  workrave::config::IConfigurator::Ptr config;
+
+  //! The X11 display name.
+  const char *x11_display_name;
+
+  //! The X11 display handle.
+  Display *x11_display{nullptr};
+
+  //! The X11 root window handle.
+  Window root_window{0};
+
+  //! Major opcode of the XInputExtension.
+  int xi_opcode{0};
+
+  //! Minimum time between two reported motion events, in microseconds.
+  int64_t motion_interval{0};
+
+  //! Time of the last reported motion event.
+  int64_t last_motion_time{0};
+
+  //! Whether motion was received that has not been reported yet.
+  bool motion_pending{false};
+
+  //! Pipe used to wake up the monitor thread on termination.
+  int wakeup_pipe[2]{-1, -1};
+
+  //! Abort the main loop
+  std::atomic<bool> abort{false};
+
+  //! The activity monitor thread.
+  std::shared_ptr<std::thread> monitor_thread;
+};
+
+#endif // XI2INPUTMONITOR_HH
@@ -25,23 +25,54 @@
 #  include <gdk/gdkx.h>
 #endif
 
+#include <algorithm>
 #include <memory>
 #include <chrono>
 
+#include <poll.h>
+#include <unistd.h>
+
 #include "XScreenSaverMonitor.hh"
 
 #include "input-monitor/IInputMonitorListener.hh"
+#include "utils/Diagnostics.hh"
 #include "utils/Platform.hh"
 
 using namespace std;
+using namespace workrave::config;
 using namespace workrave::utils;
 
+XScreenSaverMonitor::XScreenSaverMonitor(IConfigurator::Ptr config)
+  : config(config)
+{
+}
+
 XScreenSaverMonitor::~XScreenSaverMonitor()
 {
   TRACE_ENTRY();
-  if (monitor_thread)
+  if (monitor_thread && monitor_thread->joinable())
     {
-      monitor_thread->join();
+      terminate();
+    }
+
+  Diagnostics::instance().unregister_topic("monitor.screensaver.wakeups");
+
+  if (screen_saver_info != nullptr)
+    {
+      XFree(screen_saver_info);
+    }
+
+  if (xdisplay != nullptr)
+    {
+      XCloseDisplay(xdisplay);
+    }
+
+  for (int fd: wakeup_pipe)
+    {
+      if (fd != -1)
+        {
+          close(fd);
+        }
     }
 }
 
@@ -49,27 +80,49 @@ bool
 XScreenSaverMonitor::init()
 {
   TRACE_ENTRY();
-  int event_base;
   int error_base;
 
-  xdisplay = static_cast<Display *>(Platform::get_default_display());
-  root = reinterpret_cast<Drawable>(Platform::get_default_root_window());
+  config->get_value_with_default("monitor/idle", idle_threshold, 5000);
+
+  // The monitor thread reads events, so it needs its own connection.
+  auto *default_display = static_cast<Display *>(Platform::get_default_display());
+  if (default_display != nullptr)
+    {
+      xdisplay = XOpenDisplay(DisplayString(default_display));
+    }
 
   Bool has_extension = False;
   if (xdisplay != nullptr)
     {
       TRACE_MSG("xdisplay ok");
-      has_extension = XScreenSaverQueryExtension(xdisplay, &event_base, &error_base);
+      root = DefaultRootWindow(xdisplay);
+      has_extension = XScreenSaverQueryExtension(xdisplay, &event_base, &error_base) && pipe(wakeup_pipe) == 0;
     }
 
   if (has_extension)
     {
+      int major = 0;
+      int minor = 0;
+      if (XScreenSaverQueryVersion(xdisplay, &major, &minor) && (major > 1 || (major == 1 && minor >= 1)))
+        {
+          XScreenSaverSelectInput(xdisplay, root, ScreenSaverNotifyMask);
+          has_notify = true;
+        }
+
+      Diagnostics::instance().register_topic("monitor.screensaver.wakeups", [this]() {
+        Diagnostics::instance().report("monitor.screensaver.wakeups", get_wakeup_count());
+      });
 
       screen_saver_info = XScreenSaverAllocInfo();
       monitor_thread = std::make_shared<std::thread>([this] { run(); });
     }
+  else if (xdisplay != nullptr)
+    {
+      XCloseDisplay(xdisplay);
+      xdisplay = nullptr;
+    }
 
-  TRACE_VAR(has_extension);
+  TRACE_VAR(has_extension, has_notify);
   return has_extension;
 }
 
@@ -77,32 +130,105 @@ void
 XScreenSaverMonitor::terminate()
 {
   TRACE_ENTRY();
-  mutex.lock();
   abort = true;
-  cond.notify_all();
-  mutex.unlock();
 
-  monitor_thread->join();
+  if (wakeup_pipe[1] != -1)
+    {
+      char c = 0;
+      [[maybe_unused]] auto r = write(wakeup_pipe[1], &c, 1);
+    }
+
+  if (monitor_thread && monitor_thread->joinable())
+    {
+      monitor_thread->join();
+    }
+}
+
+int64_t
+XScreenSaverMonitor::get_wakeup_count() const
+{
+  return wakeup_count;
 }
 
 void
 XScreenSaverMonitor::run()
 {
   TRACE_ENTRY();
-  {
-    std::unique_lock lock(mutex);
-    while (!abort)
-      {
-        XScreenSaverQueryInfo(xdisplay, root, screen_saver_info);
-
-        if (screen_saver_info->idle < 1000)
-          {
-            TRACE_MSG("action");
-            /* Notify the activity monitor */
-            fire_action();
-          }
-
-        cond.wait_for(lock, std::chrono::milliseconds(1000));
-      }
-  }
+  struct pollfd fds[2];
+  fds[0].fd = ConnectionNumber(xdisplay);
+  fds[0].events = POLLIN;
+  fds[1].fd = wakeup_pipe[0];
+  fds[1].events = POLLIN;
+
+  while (!abort)
+    {
+      wakeup_count++;
+      process_events();
+
+      int timeout = -1;
+      if (!screen_saver_active)
+        {
+          XScreenSaverQueryInfo(xdisplay, root, screen_saver_info);
+
+          if (screen_saver_info->idle < 1000)
+            {
+              TRACE_MSG("action");
+              /* Notify the activity monitor */
+              fire_action();
+            }
+
+          if (has_notify && screen_saver_info->state == ScreenSaverOn)
+            {
+              screen_saver_active = true;
+            }
+          else
+            {
+              timeout = get_poll_interval(screen_saver_info->idle);
+            }
+        }
+
+      if (!abort && XPending(xdisplay) == 0)
+        {
+          poll(fds, 2, timeout);
+        }
+    }
+}
+
+void
+XScreenSaverMonitor::process_events()
+{
+  TRACE_ENTRY();
+  while (XPending(xdisplay) > 0)
+    {
+      XEvent event;
+      XNextEvent(xdisplay, &event);
+
+      if (event.type == event_base + ScreenSaverNotify)
+        {
+          auto *notify = reinterpret_cast<XScreenSaverNotifyEvent *>(&event);
+          TRACE_MSG("screensaver state {}", notify->state);
+
+          screen_saver_active = notify->state == ScreenSaverOn;
+          if (notify->state == ScreenSaverOff)
+            {
+              fire_action();
+            }
+        }
+    }
+}
+
+//! Returns the time until the next poll in milliseconds.
+int
+XScreenSaverMonitor::get_poll_interval(unsigned long idle) const
+{
+  // Input before the idle threshold passes continues the current activity
+  // period, so it must be noticed quickly.
+  if (idle < static_cast<unsigned long>(idle_threshold))
+    {
+      return MIN_POLL_INTERVAL;
+    }
+
+  // The user is idle. The interval only determines how quickly returning
+  // activity is noticed, so it grows with the idle time.
+  return static_cast<int>(std::clamp<unsigned long>(idle / 4, MIN_POLL_INTERVAL, MAX_POLL_INTERVAL));
 }
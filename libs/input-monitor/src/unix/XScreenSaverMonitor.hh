@@ -18,37 +18,72 @@
 #ifndef XSCREENSAVERMONITOR_HH
 #define XSCREENSAVERMONITOR_HH
 
+#include <atomic>
+#include <memory>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/extensions/scrnsaver.h>
 
 #include "InputMonitor.hh"
+#include "config/IConfigurator.hh"
 
+//! Activity monitor that polls the idle time of the XScreenSaver extension.
+/*!
+ *  The poll interval adapts to the reported idle time: polls are dense while
+ *  the user is active or within the idle threshold of the activity monitor,
+ *  and become sparse once the user is clearly idle. While the screen saver
+ *  is active, the monitor waits for a ScreenSaverNotify event instead.
+ */
 class XScreenSaverMonitor : public InputMonitor
 {
 public:
-  XScreenSaverMonitor() = default;
+  explicit XScreenSaverMonitor(workrave::config::IConfigurator::Ptr config);
   ~XScreenSaverMonitor() override;
 
   bool init() override;
   void terminate() override;
 
+  //! Returns the number of times the monitor thread woke up.
+  int64_t get_wakeup_count() const;
+
 private:
   virtual void run();
 
+  void process_events();
+  int get_poll_interval(unsigned long idle) const;
+
 private:
-  bool abort{false};
+  //! Poll interval while the user is (almost) active, in milliseconds.
+  static constexpr int MIN_POLL_INTERVAL = 1000;
+
+  //! Maximum poll interval while the user is idle, in milliseconds.
+  static constexpr int MAX_POLL_INTERVAL = 10000;
+
+  workrave::config::IConfigurator::Ptr config;
+  std::atomic<bool> abort{false};
   std::shared_ptr<std::thread> monitor_thread;
   XScreenSaverInfo *screen_saver_info{nullptr};
   Display *xdisplay{nullptr};
   Drawable root;
 
-  std::mutex mutex;
-  std::condition_variable cond;
+  //! Event base of the MIT-SCREEN-SAVER extension.
+  int event_base{0};
+
+  //! Idle threshold of the activity monitor, in milliseconds.
+  int idle_threshold{5000};
+
+  //! Whether the server sends ScreenSaverNotify events.
+  bool has_notify{false};
+
+  //! Whether the screen saver is active.
+  bool screen_saver_active{false};
+
+  //! Pipe used to wake up the monitor thread on termination.
+  int wakeup_pipe[2]{-1, -1};
+
+  std::atomic<int64_t> wakeup_count{0};
 };
 
 #endif // XSCREENSAVERMONITOR_HH
@@ -0,0 +1,454 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+// Tests the asynchronous setup of the Mutter input monitor against a mock
+// org.gnome.Mutter.IdleMonitor service. Most tests talk to the mock over a
+// peer-to-peer connection. The tests of the name handling need a private
+// session bus and are skipped when dbus-daemon is not installed.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#define BOOST_TEST_MODULE workrave_mutter_input_monitor
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <gio/gio.h>
+
+#include "input-monitor/IInputMonitorListener.hh"
+
+#include "InputMonitor.hh"
+#include "MutterInputMonitor.hh"
+
+using namespace workrave::input_monitor;
+
+static const char *idle_monitor_xml =
+  "<node>"
+  "  <interface name='org.gnome.Mutter.IdleMonitor'>"
+  "    <method name='GetIdletime'><arg type='t' name='idletime' direction='out'/></method>"
+  "    <method name='AddIdleWatch'>"
+  "      <arg type='t' name='interval' direction='in'/><arg type='u' name='id' direction='out'/>"
+  "    </method>"
+  "    <method name='AddUserActiveWatch'><arg type='u' name='id' direction='out'/></method>"
+  "    <method name='RemoveWatch'><arg type='u' name='id' direction='in'/></method>"
+  "    <signal name='WatchFired'><arg type='u' name='id'/></signal>"
+  "  </interface>"
+  "</node>";
+
+//! Runs the main context until the condition holds or the timeout expires.
+static bool
+wait_for(const std::function<bool()> &condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000))
+{
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!condition())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+        {
+          return false;
+        }
+      g_main_context_iteration(nullptr, FALSE);
+      g_usleep(1000);
+    }
+  return true;
+}
+
+//! Minimal org.gnome.Mutter.IdleMonitor implementation.
+class MockIdleMonitor
+{
+public:
+  explicit MockIdleMonitor(const gchar *address)
+    : MockIdleMonitor(g_dbus_connection_new_for_address_sync(
+      address,
+      static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT | G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+      nullptr,
+      nullptr,
+      nullptr))
+  {
+  }
+
+  //! Serves the idle monitor on the given connection, and takes ownership of it.
+  explicit MockIdleMonitor(GDBusConnection *connection)
+    : connection(connection)
+  {
+    BOOST_REQUIRE(connection != nullptr);
+
+    GDBusNodeInfo *info = g_dbus_node_info_new_for_xml(idle_monitor_xml, nullptr);
+    static const GDBusInterfaceVTable vtable = {on_method_call, nullptr, nullptr, {}};
+    registration_id =
+      g_dbus_connection_register_object(connection, "/org/gnome/Mutter/IdleMonitor/Core", info->interfaces[0], &vtable, this, nullptr, nullptr);
+    g_dbus_node_info_unref(info);
+  }
+
+  ~MockIdleMonitor()
+  {
+    for (auto *invocation: held)
+      {
+        g_dbus_method_invocation_return_dbus_error(invocation, "org.gnome.Mutter.Error", "Shutting down");
+      }
+    unown();
+    g_dbus_connection_unregister_object(connection, registration_id);
+    g_object_unref(connection);
+  }
+
+  void own()
+  {
+    owned = false;
+    owner_id = g_bus_own_name_on_connection(connection,
+                                            "org.gnome.Mutter.IdleMonitor",
+                                            G_BUS_NAME_OWNER_FLAGS_NONE,
+                                            on_name_acquired,
+                                            nullptr,
+                                            this,
+                                            nullptr);
+    BOOST_REQUIRE(wait_for([this] { return owned; }));
+  }
+
+  void unown()
+  {
+    if (owner_id != 0)
+      {
+        g_bus_unown_name(owner_id);
+        owner_id = 0;
+      }
+  }
+
+  void fire_watch(guint id)
+  {
+    g_dbus_connection_emit_signal(connection,
+                                  nullptr,
+                                  "/org/gnome/Mutter/IdleMonitor/Core",
+                                  "org.gnome.Mutter.IdleMonitor",
+                                  "WatchFired",
+                                  g_variant_new("(u)", id),
+                                  nullptr);
+  }
+
+  //! Do not reply to watch registrations, as a busy gnome-shell would.
+  bool hold_watch_replies{false};
+  guint64 idletime{60000};
+  int idle_watch_requests{0};
+  std::set<guint> idle_watches;
+  std::set<guint> active_watches;
+
+private:
+  static void on_name_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data)
+  {
+    (void)connection;
+    (void)name;
+    static_cast<MockIdleMonitor *>(user_data)->owned = true;
+  }
+
+  static void on_method_call(GDBusConnection *connection,
+                             const gchar *sender,
+                             const gchar *object_path,
+                             const gchar *interface_name,
+                             const gchar *method_name,
+                             GVariant *parameters,
+                             GDBusMethodInvocation *invocation,
+                             gpointer user_data)
+  {
+    (void)connection;
+    (void)sender;
+    (void)object_path;
+    (void)interface_name;
+    auto *self = static_cast<MockIdleMonitor *>(user_data);
+
+    if (g_strcmp0(method_name, "GetIdletime") == 0)
+      {
+        g_dbus_method_invocation_return_value(invocation, g_variant_new("(t)", self->idletime));
+      }
+    else if (g_strcmp0(method_name, "AddIdleWatch") == 0 || g_strcmp0(method_name, "AddUserActiveWatch") == 0)
+      {
+        bool idle = g_strcmp0(method_name, "AddIdleWatch") == 0;
+        if (idle)
+          {
+            self->idle_watch_requests++;
+          }
+
+        if (self->hold_watch_replies)
+          {
+            self->held.push_back(invocation);
+            return;
+          }
+
+        guint id = self->next_watch++;
+        (idle ? self->idle_watches : self->active_watches).insert(id);
+        g_dbus_method_invocation_return_value(invocation, g_variant_new("(u)", id));
+      }
+    else if (g_strcmp0(method_name, "RemoveWatch") == 0)
+      {
+        guint id = 0;
+        g_variant_get(parameters, "(u)", &id);
+        self->idle_watches.erase(id);
+        self->active_watches.erase(id);
+        g_dbus_method_invocation_return_value(invocation, nullptr);
+      }
+  }
+
+  GDBusConnection *connection{nullptr};
+  guint registration_id{0};
+  guint owner_id{0};
+  guint next_watch{1};
+  bool owned{false};
+  std::vector<GDBusMethodInvocation *> held;
+};
+
+class CountingListener : public IInputMonitorListener
+{
+public:
+  void action_notify() override
+  {
+    actions++;
+  }
+
+  void mouse_notify(int x, int y, int wheel) override
+  {
+    (void)x;
+    (void)y;
+    (void)wheel;
+  }
+
+  void button_notify(bool is_press) override
+  {
+    (void)is_press;
+  }
+
+  void keyboard_notify(bool repeat) override
+  {
+    (void)repeat;
+  }
+
+  std::atomic<int> actions{0};
+};
+
+//! Stands in for the monitor that the factory would fall back to.
+class FallbackMonitor : public InputMonitor
+{
+public:
+  bool init() override
+  {
+    return true;
+  }
+
+  void terminate() override
+  {
+    terminated = true;
+  }
+
+  void fire()
+  {
+    fire_action();
+  }
+
+  std::atomic<bool> terminated{false};
+};
+
+//! Connects the monitor to the mock over a socket pair, without a bus daemon.
+struct PeerFixture
+{
+  PeerFixture()
+  {
+    int fds[2];
+    BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+    gchar *guid = g_dbus_generate_guid();
+    connect(fds[0], guid, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER, &server);
+    connect(fds[1], nullptr, G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT, &client);
+    g_free(guid);
+
+    BOOST_REQUIRE(wait_for([this] { return server != nullptr && client != nullptr; }));
+    mock = std::make_unique<MockIdleMonitor>(server);
+  }
+
+  ~PeerFixture()
+  {
+    mock.reset();
+    wait_for([] { return !g_main_context_pending(nullptr); });
+    g_object_unref(client);
+  }
+
+  static void connect(int fd, const gchar *guid, GDBusConnectionFlags flags, GDBusConnection **result)
+  {
+    GSocket *socket = g_socket_new_from_fd(fd, nullptr);
+    BOOST_REQUIRE(socket != nullptr);
+    GSocketConnection *stream = g_socket_connection_factory_create_connection(socket);
+    g_dbus_connection_new(G_IO_STREAM(stream), guid, flags, nullptr, nullptr, &PeerFixture::on_connection, result);
+    g_object_unref(stream);
+    g_object_unref(socket);
+  }
+
+  static void on_connection(GObject *source, GAsyncResult *res, gpointer user_data)
+  {
+    (void)source;
+    auto **result = static_cast<GDBusConnection **>(user_data);
+    *result = g_dbus_connection_new_finish(res, nullptr);
+  }
+
+  GDBusConnection *server{nullptr};
+  GDBusConnection *client{nullptr};
+  std::unique_ptr<MockIdleMonitor> mock;
+};
+
+//! Runs a private session bus.
+struct BusFixture
+{
+  BusFixture()
+  {
+    bus = g_test_dbus_new(G_TEST_DBUS_NONE);
+    g_test_dbus_up(bus);
+  }
+
+  ~BusFixture()
+  {
+    // Let cancelled calls complete so that the shared connection is released.
+    wait_for([] { return !g_main_context_pending(nullptr); });
+    g_test_dbus_down(bus);
+    g_object_unref(bus);
+  }
+
+  GTestDBus *bus{nullptr};
+};
+
+static boost::test_tools::assertion_result
+has_dbus_daemon(boost::unit_test::test_unit_id)
+{
+  gchar *path = g_find_program_in_path("dbus-daemon");
+  bool found = path != nullptr;
+  g_free(path);
+  return found;
+}
+
+BOOST_FIXTURE_TEST_SUITE(mutter_input_monitor, PeerFixture)
+
+BOOST_AUTO_TEST_CASE(test_starts_degraded_and_upgrades)
+{
+  MutterInputMonitor monitor(client);
+
+  // The mock only replies from the main loop, so a synchronous call in
+  // init() would not return before its timeout.
+  auto start = std::chrono::steady_clock::now();
+  BOOST_REQUIRE(monitor.init());
+  BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+  BOOST_CHECK(!monitor.is_ready());
+
+  BOOST_REQUIRE(wait_for([&] { return monitor.is_ready(); }));
+  BOOST_CHECK_EQUAL(mock->idle_watches.size(), 1);
+  BOOST_CHECK(wait_for([&] { return mock->active_watches.size() == 1; }));
+
+  monitor.terminate();
+  BOOST_CHECK(wait_for([&] { return mock->idle_watches.empty() && mock->active_watches.empty(); }));
+}
+
+BOOST_AUTO_TEST_CASE(test_watch_fired_reports_activity)
+{
+  MutterInputMonitor monitor(client);
+  CountingListener listener;
+  monitor.subscribe(&listener);
+
+  BOOST_REQUIRE(monitor.init());
+  BOOST_REQUIRE(wait_for([&] { return monitor.is_ready() && mock->active_watches.size() == 1; }));
+  BOOST_CHECK_EQUAL(listener.actions, 0);
+
+  mock->fire_watch(*mock->active_watches.begin());
+  BOOST_CHECK(wait_for([&] { return listener.actions > 0; }));
+
+  // The one-shot active watch is removed once it fired.
+  BOOST_CHECK(wait_for([&] { return mock->active_watches.empty(); }));
+
+  monitor.terminate();
+}
+
+BOOST_AUTO_TEST_CASE(test_degraded_polls_idletime)
+{
+  mock->hold_watch_replies = true;
+  mock->idletime = 0;
+
+  MutterInputMonitor monitor(client);
+  CountingListener listener;
+  monitor.subscribe(&listener);
+
+  BOOST_REQUIRE(monitor.init());
+  BOOST_CHECK(wait_for([&] { return listener.actions > 0; }));
+  BOOST_CHECK(!monitor.is_ready());
+
+  monitor.terminate();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(mutter_input_monitor_bus, BusFixture, *boost::unit_test::precondition(has_dbus_daemon))
+
+BOOST_AUTO_TEST_CASE(test_no_service_falls_back)
+{
+  auto fallback = std::make_shared<FallbackMonitor>();
+
+  {
+    MutterInputMonitor monitor([fallback]() { return fallback; });
+    CountingListener listener;
+    monitor.subscribe(&listener);
+
+    // Whether Mutter runs is not known yet, so init() succeeds.
+    BOOST_REQUIRE(monitor.init());
+    BOOST_REQUIRE(wait_for([&] { return monitor.is_falling_back(); }));
+
+    fallback->fire();
+    BOOST_CHECK_EQUAL(listener.actions, 1);
+
+    // Mutter takes over once it appears.
+    MockIdleMonitor mock(g_test_dbus_get_bus_address(bus));
+    mock.own();
+    BOOST_REQUIRE(wait_for([&] { return monitor.is_ready(); }));
+    BOOST_CHECK(!monitor.is_falling_back());
+    BOOST_CHECK(fallback->terminated);
+
+    monitor.terminate();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_reregisters_after_restart)
+{
+  MockIdleMonitor mock(g_test_dbus_get_bus_address(bus));
+  mock.own();
+
+  {
+    MutterInputMonitor monitor;
+    BOOST_REQUIRE(monitor.init());
+    BOOST_REQUIRE(wait_for([&] { return monitor.is_ready(); }));
+    BOOST_CHECK_EQUAL(mock.idle_watch_requests, 1);
+
+    mock.unown();
+    BOOST_REQUIRE(wait_for([&] { return !monitor.is_ready(); }));
+
+    mock.own();
+    BOOST_REQUIRE(wait_for([&] { return monitor.is_ready(); }));
+    BOOST_CHECK_EQUAL(mock.idle_watch_requests, 2);
+
+    monitor.terminate();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+// Copyright (C) 2024 Rob Caelers <robc@krandor.nl>
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// Compares the CPU cost of the XInput2 and XRecord input monitors.
+//
+// Synthetic events are injected with XTest. The CPU time used by the process
+// without any monitor is measured first and subtracted from the cost of each
+// monitor.
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XTest.h>
+
+#include "config/ConfiguratorFactory.hh"
+#include "input-monitor/IInputMonitorListener.hh"
+
+#include "RecordInputMonitor.hh"
+#include "XI2InputMonitor.hh"
+
+using namespace workrave::config;
+using namespace workrave::input_monitor;
+
+static constexpr int NUM_EVENTS = 10000;
+
+class CountingListener : public IInputMonitorListener
+{
+public:
+  void action_notify() override
+  {
+    count++;
+  }
+
+  void mouse_notify(int x, int y, int wheel) override
+  {
+    (void)x;
+    (void)y;
+    (void)wheel;
+    count++;
+  }
+
+  void button_notify(bool is_press) override
+  {
+    (void)is_press;
+    count++;
+  }
+
+  void keyboard_notify(bool repeat) override
+  {
+    (void)repeat;
+    count++;
+  }
+
+  std::atomic<int64_t> count{0};
+};
+
+static double
+get_cpu_time_ms()
+{
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1000000.0;
+}
+
+static void
+inject_events(Display *display)
+{
+  KeyCode key = XKeysymToKeycode(display, XK_Shift_L);
+  for (int i = 0; i < NUM_EVENTS; i++)
+    {
+      if (i % 2 == 0)
+        {
+          XTestFakeMotionEvent(display, -1, i % 1000, (i / 1000) * 10, CurrentTime);
+        }
+      else
+        {
+          XTestFakeKeyEvent(display, key, True, CurrentTime);
+          XTestFakeKeyEvent(display, key, False, CurrentTime);
+        }
+      if (i % 100 == 0)
+        {
+          XSync(display, False);
+        }
+    }
+  XSync(display, False);
+}
+
+//! Waits until the listener did not receive notifications for a while.
+static void
+wait_until_settled(CountingListener *listener)
+{
+  int64_t last = -1;
+  while (listener->count != last)
+    {
+      last = listener->count;
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+}
+
+//! Returns the CPU time (ms) used for injecting and processing the events.
+static double
+measure(Display *display, CountingListener *listener)
+{
+  double start = get_cpu_time_ms();
+  inject_events(display);
+  if (listener != nullptr)
+    {
+      wait_until_settled(listener);
+    }
+  return get_cpu_time_ms() - start;
+}
+
+static void
+run_monitor(Display *display, const char *name, double baseline, const std::function<InputMonitor *()> &create)
+{
+  std::unique_ptr<InputMonitor> monitor(create());
+  CountingListener listener;
+  monitor->subscribe(&listener);
+
+  if (!monitor->init())
+    {
+      printf("%-8s unavailable\n", name);
+      return;
+    }
+
+  double cpu = measure(display, &listener) - baseline;
+  printf("%-8s %8.2f ms CPU per %d events, %lld notifications\n", name, cpu, NUM_EVENTS, static_cast<long long>(listener.count));
+
+  monitor->terminate();
+  monitor->unsubscribe(&listener);
+}
+
+int
+main(int argc, char **argv)
+{
+  const char *display_name = argc > 1 ? argv[1] : nullptr;
+
+  Display *display = XOpenDisplay(display_name);
+  if (display == nullptr)
+    {
+      fprintf(stderr, "Cannot open display\n");
+      return 1;
+    }
+
+  IConfigurator::Ptr config = ConfiguratorFactory::create(ConfigFileFormat::Ini);
+
+  double baseline = measure(display, nullptr);
+  printf("%-8s %8.2f ms CPU per %d events\n", "baseline", baseline, NUM_EVENTS);
+
+  run_monitor(display, "xi2", baseline, [&] { return new XI2InputMonitor(config, display_name); });
+  run_monitor(display, "record", baseline, [&] { return new RecordInputMonitor(display_name); });
+
+  XCloseDisplay(display);
+  return 0;
+}
@@ -19,6 +19,7 @@
 #  include "config.h"
 #endif
 
+#include <algorithm>
 #include <filesystem>
 #include <initializer_list>
 #include <spdlog/common.h>
@@ -56,6 +57,7 @@
 #include "utils/Logging.hh"
 #include "utils/Paths.hh"
 #include "utils/Platform.hh"
+#include "utils/TimeSource.hh"
 
 #if defined(HAVE_DBUS)
 #  include "GenericDBusApplet.hh"
@@ -116,6 +118,9 @@ Application::main()
 #endif
 
   connect(toolkit->signal_timer(), this, [this] { on_timer(); });
+#if defined(HAVE_CORE_NEXT)
+  connect(core->signal_wakeup(), this, [this] { toolkit->wakeup_timer(); });
+#endif
   connect(toolkit->signal_session_idle_changed(), this, [this](auto idle) { on_idle_changed(idle); });
   connect(toolkit->signal_main_window_closed(), this, [this] { on_main_window_closed(); });
   connect(toolkit->signal_status_icon_activated(), this, [this] { on_status_icon_activate(); });
@@ -580,8 +585,39 @@ Application::on_timer()
           muted = false;
         }
     }
+
+#if defined(HAVE_CORE_NEXT)
+  // Sleep until the core needs the next heartbeat; signal_wakeup() cuts it short.
+  // The timer views still count down idle time every second until a break resets.
+  int64_t delay = core->get_next_heartbeat_time() - TimeSource::get_monotonic_time_sec_sync();
+  if (!break_windows.empty() || !prelude_windows.empty() || is_idle_progress_shown())
+    {
+      delay = 1;
+    }
+  toolkit->schedule_timer(std::chrono::seconds(std::max<int64_t>(delay, 1)));
+#else
+  toolkit->schedule_timer(std::chrono::seconds(1));
+#endif
 }
 
+#if defined(HAVE_CORE_NEXT)
+//! Returns whether a break is idle but not yet reset, so its view shows the reset progress.
+bool
+Application::is_idle_progress_shown() const
+{
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      IBreak::Ptr b = core->get_break(BreakId(i));
+      if (b->is_enabled() && !b->is_running() && b->is_auto_reset_enabled() && b->get_elapsed_time() > 0
+          && b->get_elapsed_idle_time() < b->get_auto_reset())
+        {
+          return true;
+        }
+    }
+  return false;
+}
+#endif
+
 void
 Application::on_main_window_closed()
 {
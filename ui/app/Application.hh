@@ -96,6 +96,7 @@ private:
 
 #if defined(HAVE_CORE_NEXT)
   void on_break_event(workrave::BreakId break_id, workrave::BreakEvent event);
+  bool is_idle_progress_shown() const;
 #endif
 
 private:
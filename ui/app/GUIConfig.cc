@@ -113,124 +113,153 @@ GUIConfig::expand(const string &key, workrave::BreakId id) -> string
   return str;
 }
 
+template<typename H, typename... Args>
+auto
+GUIConfig::per_break(const string &key, const Args &...args) -> std::array<H, workrave::BREAK_ID_SIZEOF>
+{
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::array<H, workrave::BREAK_ID_SIZEOF>{H(expand(key, static_cast<workrave::BreakId>(I)), args...)...};
+  }(std::make_index_sequence<workrave::BREAK_ID_SIZEOF>());
+}
+
 auto
 GUIConfig::break_auto_natural(workrave::BreakId break_id) -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, expand(CFG_KEY_BREAK_AUTO_NATURAL, break_id));
+  static const auto handles = per_break<SettingHandle<bool>>(CFG_KEY_BREAK_AUTO_NATURAL);
+  return handles[break_id](config);
 }
 
 auto
 GUIConfig::break_ignorable(workrave::BreakId break_id) -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, expand(CFG_KEY_BREAK_IGNORABLE, break_id), true);
+  static const auto handles = per_break<SettingHandle<bool>>(CFG_KEY_BREAK_IGNORABLE, true);
+  return handles[break_id](config);
 }
 
 auto
 GUIConfig::break_skippable(workrave::BreakId break_id) -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, expand(CFG_KEY_BREAK_SKIPPABLE, break_id), true);
+  static const auto handles = per_break<SettingHandle<bool>>(CFG_KEY_BREAK_SKIPPABLE, true);
+  return handles[break_id](config);
 }
 
 auto
 GUIConfig::break_enable_shutdown(workrave::BreakId break_id) -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, expand(CFG_KEY_BREAK_ENABLE_SHUTDOWN, break_id), true);
+  static const auto handles = per_break<SettingHandle<bool>>(CFG_KEY_BREAK_ENABLE_SHUTDOWN, true);
+  return handles[break_id](config);
 }
 
 auto
 GUIConfig::break_exercises(workrave::BreakId break_id) -> Setting<int> &
 {
-  return SettingCache::get<int>(config, expand(CFG_KEY_BREAK_EXERCISES, break_id), 0);
+  static const auto handles = per_break<SettingHandle<int>>(CFG_KEY_BREAK_EXERCISES, 0);
+  return handles[break_id](config);
 }
 
 auto
 GUIConfig::block_mode() -> Setting<int, BlockMode> &
 {
-  return SettingCache::get<int, BlockMode>(config, CFG_KEY_BLOCK_MODE, BlockMode::Input);
+  static const SettingHandle<int, BlockMode> handle(CFG_KEY_BLOCK_MODE, BlockMode::Input);
+  return handle(config);
 }
 
 auto
 GUIConfig::focus_mode() -> Setting<int, FocusMode> &
 {
-  return SettingCache::get<int, FocusMode>(config, CFG_KEY_FOCUS_MODE, FocusMode::Off);
+  static const SettingHandle<int, FocusMode> handle(CFG_KEY_FOCUS_MODE, FocusMode::Off);
+  return handle(config);
 }
 
 auto
 GUIConfig::locale() -> Setting<std::string> &
 {
-  return SettingCache::get<std::string>(config, CFG_KEY_LOCALE, std::string());
+  static const SettingHandle<std::string> handle(CFG_KEY_LOCALE, std::string());
+  return handle(config);
 }
 
 auto
 GUIConfig::trayicon_enabled() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_TRAYICON_ENABLED, true);
+  static const SettingHandle<bool> handle(CFG_KEY_TRAYICON_ENABLED, true);
+  return handle(config);
 }
 
 auto
 GUIConfig::closewarn_enabled() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_CLOSEWARN_ENABLED);
+  static const SettingHandle<bool> handle(CFG_KEY_CLOSEWARN_ENABLED);
+  return handle(config);
 }
 
 auto
 GUIConfig::autostart_enabled() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_AUTOSTART);
+  static const SettingHandle<bool> handle(CFG_KEY_AUTOSTART);
+  return handle(config);
 }
 
 auto
 GUIConfig::icon_theme() -> Setting<std::string> &
 {
-  return SettingCache::get<std::string>(config, CFG_KEY_ICONTHEME, std::string());
+  static const SettingHandle<std::string> handle(CFG_KEY_ICONTHEME, std::string());
+  return handle(config);
 }
 
 auto
 GUIConfig::theme_dark() -> workrave::config::Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_THEME_DARK, false);
+  static const SettingHandle<bool> handle(CFG_KEY_THEME_DARK, false);
+  return handle(config);
 }
 
 auto
 GUIConfig::theme_name() -> workrave::config::Setting<std::string> &
 {
-  return SettingCache::get<std::string>(config, CFG_KEY_THEME_NAME, std::string());
+  static const SettingHandle<std::string> handle(CFG_KEY_THEME_NAME, std::string());
+  return handle(config);
 }
 
 auto
 GUIConfig::key_main_window() -> workrave::config::SettingGroup &
 {
-  return SettingCache::group(config, CFG_KEY_MAIN_WINDOW);
+  static const SettingGroupHandle handle(CFG_KEY_MAIN_WINDOW);
+  return handle(config);
 }
 
 auto
 GUIConfig::main_window_always_on_top() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_MAIN_WINDOW_ALWAYS_ON_TOP, false);
+  static const SettingHandle<bool> handle(CFG_KEY_MAIN_WINDOW_ALWAYS_ON_TOP, false);
+  return handle(config);
 }
 
 auto
 GUIConfig::main_window_start_in_tray() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_MAIN_WINDOW_START_IN_TRAY, false);
+  static const SettingHandle<bool> handle(CFG_KEY_MAIN_WINDOW_START_IN_TRAY, false);
+  return handle(config);
 }
 
 auto
 GUIConfig::main_window_x() -> Setting<int> &
 {
-  return SettingCache::get<int>(config, CFG_KEY_MAIN_WINDOW_X, 256);
+  static const SettingHandle<int> handle(CFG_KEY_MAIN_WINDOW_X, 256);
+  return handle(config);
 }
 
 auto
 GUIConfig::main_window_y() -> Setting<int> &
 {
-  return SettingCache::get<int>(config, CFG_KEY_MAIN_WINDOW_Y, 256);
+  static const SettingHandle<int> handle(CFG_KEY_MAIN_WINDOW_Y, 256);
+  return handle(config);
 }
 
 auto
 GUIConfig::main_window_head() -> Setting<int> &
 {
-  return SettingCache::get<int>(config, CFG_KEY_MAIN_WINDOW_HEAD, 0);
+  static const SettingHandle<int> handle(CFG_KEY_MAIN_WINDOW_HEAD, 0);
+  return handle(config);
 }
 
 auto
@@ -277,11 +306,13 @@ GUIConfig::timerbox_enabled(const std::string &box) -> Setting<bool> &
 auto
 GUIConfig::applet_fallback_enabled() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_APPLET_FALLBACK_ENABLED, false);
+  static const SettingHandle<bool> handle(CFG_KEY_APPLET_FALLBACK_ENABLED, false);
+  return handle(config);
 }
 
 auto
 GUIConfig::applet_icon_enabled() -> Setting<bool> &
 {
-  return SettingCache::get<bool>(config, CFG_KEY_APPLET_ICON_ENABLED, true);
+  static const SettingHandle<bool> handle(CFG_KEY_APPLET_ICON_ENABLED, true);
+  return handle(config);
 }
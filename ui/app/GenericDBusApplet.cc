@@ -28,6 +28,7 @@
 #include "ui/GUIConfig.hh"
 #include "ui/Text.hh"
 #include "config/IConfigurator.hh"
+#include "utils/TimeSource.hh"
 
 #include "dbus/IDBus.hh"
 #include "dbus/DBusException.hh"
@@ -37,6 +38,10 @@
 #define WORKRAVE_APPLET_SERVICE_IFACE "org.workrave.AppletInterface"
 #define WORKRAVE_APPLET_SERVICE_OBJ "/org/workrave/Workrave/UI"
 
+// Applets consider Workrave gone when no timer update arrives for a while,
+// so an empty TimersChanged is sent after this many seconds without changes.
+static constexpr int KEEPALIVE_INTERVAL = 3;
+
 GenericDBusApplet::GenericDBusApplet(std::shared_ptr<IApplication> app)
   : app(app)
   , toolkit(app->get_toolkit())
@@ -49,6 +54,7 @@ GenericDBusApplet::GenericDBusApplet(std::shared_ptr<IApplication> app)
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
       data[i].bar_text = "";
+      data[i].slot = 0;
       data[i].bar_primary_color = 0;
       data[i].bar_primary_val = 0;
       data[i].bar_primary_max = 0;
@@ -91,9 +97,40 @@ void
 GenericDBusApplet::update_view()
 {
   TRACE_ENTRY();
+  if (active_bus_names.empty())
+    {
+      synced = false;
+      return;
+    }
+
+  TimerChanges changes;
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      if (!synced || data[i] != last_sent[i])
+        {
+          changes.push_back(TimerChange{static_cast<uint32_t>(i), data[i]});
+          last_sent[i] = data[i];
+        }
+    }
+  synced = true;
+
+  // The heartbeat may sleep longer than the applets wait, so keep a timer armed for the keep-alive.
+  toolkit->schedule_timer(std::chrono::seconds(KEEPALIVE_INTERVAL));
+
+  int64_t now = workrave::utils::TimeSource::get_monotonic_time_sec_sync();
+  if (changes.empty() && now - last_update_time < KEEPALIVE_INTERVAL)
+    {
+      return;
+    }
+  last_update_time = now;
+
   org_workrave_AppletInterface *iface = org_workrave_AppletInterface::instance(dbus);
   assert(iface != nullptr);
-  iface->TimersUpdated(WORKRAVE_APPLET_SERVICE_OBJ, data[BREAK_ID_MICRO_BREAK], data[BREAK_ID_REST_BREAK], data[BREAK_ID_DAILY_LIMIT]);
+  iface->TimersChanged(WORKRAVE_APPLET_SERVICE_OBJ, changes);
+  if (legacy_applet)
+    {
+      iface->TimersUpdated(WORKRAVE_APPLET_SERVICE_OBJ, data[BREAK_ID_MICRO_BREAK], data[BREAK_ID_REST_BREAK], data[BREAK_ID_DAILY_LIMIT]);
+    }
 }
 
 void
@@ -122,10 +159,13 @@ GenericDBusApplet::init()
 }
 
 void
-GenericDBusApplet::applet_embed(bool enable, const std::string &sender)
+GenericDBusApplet::applet_embed(bool enable, const std::string &sender, const std::string &caller)
 {
-  TRACE_ENTRY_PAR(enable, sender);
+  TRACE_ENTRY_PAR(enable, sender, caller);
   embedded = enable;
+  synced = false;
+  embed_caller = caller;
+  legacy_applet = !delta_clients.contains(caller);
 
   for (const auto &bus_name: active_bus_names)
     {
@@ -160,6 +200,20 @@ GenericDBusApplet::get_tray_icon_enabled(bool &enabled) const
   enabled = GUIConfig::applet_icon_enabled()();
 }
 
+void
+GenericDBusApplet::get_timers(TimerData &micro, TimerData &rest, TimerData &daily, const std::string &caller)
+{
+  delta_clients.insert(caller);
+  if (caller == embed_caller)
+    {
+      legacy_applet = false;
+    }
+
+  micro = data[BREAK_ID_MICRO_BREAK];
+  rest = data[BREAK_ID_REST_BREAK];
+  daily = data[BREAK_ID_DAILY_LIMIT];
+}
+
 void
 GenericDBusApplet::applet_command(int command)
 {
@@ -210,6 +264,7 @@ GenericDBusApplet::bus_name_presence(const std::string &name, bool present)
           TRACE_MSG("Disabling");
           visible = false;
           embedded = false;
+          delta_clients.clear();
           apphold.release();
         }
     }
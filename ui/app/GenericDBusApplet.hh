@@ -51,6 +51,15 @@ public:
     uint32_t bar_primary_color;
     uint32_t bar_primary_val;
     uint32_t bar_primary_max;
+
+    bool operator==(const TimerData &other) const = default;
+  };
+
+  //! Timer data of a single break, as sent in a TimersChanged delta.
+  struct TimerChange
+  {
+    uint32_t id;
+    TimerData data;
   };
 
   struct MenuItem
@@ -90,12 +99,14 @@ public:
   // DBus
   virtual void get_menu(std::list<MenuItem> &out);
   virtual void get_tray_icon_enabled(bool &enabled) const;
+  virtual void get_timers(TimerData &micro, TimerData &rest, TimerData &daily, const std::string &caller);
   virtual void applet_menu_action(const std::string &action);
   virtual void applet_command(int command);
-  virtual void applet_embed(bool enable, const std::string &sender);
+  virtual void applet_embed(bool enable, const std::string &sender, const std::string &caller);
   virtual void button_clicked(int button);
 
   using MenuItems = std::list<MenuItem>;
+  using TimerChanges = std::list<TimerChange>;
 
 private:
   // ITimerBoxView
@@ -127,7 +138,19 @@ private:
   bool visible{false};
   bool embedded{false};
   TimerData data[workrave::BREAK_ID_SIZEOF];
+  TimerData last_sent[workrave::BREAK_ID_SIZEOF];
+  bool synced{false};
+  int64_t last_update_time{0};
   std::set<std::string> active_bus_names;
+
+  //! Connections that called GetTimers, and so merge TimersChanged deltas.
+  std::set<std::string> delta_clients;
+
+  //! Connection that embedded the applet.
+  std::string embed_caller;
+
+  //! Whether the embedded applet predates TimersChanged and still needs TimersUpdated.
+  bool legacy_applet{false};
   workrave::dbus::IDBus::Ptr dbus;
   std::shared_ptr<TimerBoxControl> control;
 };
@@ -18,11 +18,13 @@
 #ifndef WORKRAVE_UI_GUICONFIG_HH
 #define WORKRAVE_UI_GUICONFIG_HH
 
+#include <array>
 #include <iostream>
 
 #include "config/IConfigurator.hh"
 #include "core/ICore.hh"
 #include "config/Setting.hh"
+#include "config/SettingCache.hh"
 
 #include "ui/IApplication.hh"
 
@@ -123,6 +125,11 @@ private:
 
 private:
   static std::string expand(const std::string &str, workrave::BreakId id);
+
+  //! Returns a handle of the setting for each break.
+  template<typename H, typename... Args>
+  static std::array<H, workrave::BREAK_ID_SIZEOF> per_break(const std::string &key, const Args &...args);
+
   static inline std::shared_ptr<IApplication> app;
   static inline std::shared_ptr<workrave::config::IConfigurator> config;
 };
@@ -18,6 +18,7 @@
 #ifndef WORKRAVE_UI_ITOOLKIT_HH
 #define WORKRAVE_UI_ITOOLKIT_HH
 
+#include <chrono>
 #include <memory>
 #include <boost/signals2.hpp>
 
@@ -61,6 +62,11 @@ public:
   virtual IPreludeWindow::Ptr create_prelude_window(int screen_index, workrave::BreakId break_id) = 0;
   virtual void show_window(WindowType type) = 0;
 
+  //! Emits signal_timer() once, no later than delay from now. An earlier pending timer is kept.
+  virtual void schedule_timer(std::chrono::milliseconds delay) = 0;
+  //! Emits signal_timer() as soon as possible. May be called from any thread.
+  virtual void wakeup_timer() = 0;
+
   virtual boost::signals2::signal<void()> &signal_timer() = 0;
   virtual boost::signals2::signal<void()> &signal_main_window_closed() = 0;
   virtual boost::signals2::signal<void(bool)> &signal_session_idle_changed() = 0;
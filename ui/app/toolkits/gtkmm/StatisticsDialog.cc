@@ -55,7 +55,7 @@ StatisticsDialog::StatisticsDialog(std::shared_ptr<IApplication> app)
     }
 
   init_gui();
-  display_calendar_date();
+  load_history();
 }
 
 int
@@ -297,7 +297,7 @@ StatisticsDialog::create_activity_page(Gtk::Widget *tnotebook)
 }
 
 void
-StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
+StatisticsDialog::display_statistics(const IStatistics::DailyStats *stats)
 {
   IStatistics::DailyStats empty{};
   bool is_empty;
@@ -409,40 +409,9 @@ StatisticsDialog::display_week_statistics()
   guint y, m, d;
   calendar->get_date(y, m, d);
 
-  std::tm timeinfo{};
-  std::memset(&timeinfo, 0, sizeof(timeinfo));
-  timeinfo.tm_mday = d;
-  timeinfo.tm_mon = m;
-  timeinfo.tm_year = y - 1900;
-
-  std::time_t t = std::mktime(&timeinfo);
-  std::tm const *time_loc = std::localtime(&t);
-
-  int offset = (time_loc->tm_wday - Locale::get_week_start() + 7) % 7;
-  int64_t total_week = 0;
-  for (int i = 0; i < 7; i++)
-    {
-      std::memset(&timeinfo, 0, sizeof(timeinfo));
-      timeinfo.tm_mday = d - offset + i;
-      timeinfo.tm_mon = m;
-      timeinfo.tm_year = y - 1900;
-      t = std::mktime(&timeinfo);
-      time_loc = std::localtime(&t);
-
-      int idx, next, prev;
-      statistics->get_day_index_by_date(time_loc->tm_year + 1900, time_loc->tm_mon + 1, time_loc->tm_mday, idx, next, prev);
-
-      if (idx >= 0)
-        {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
-            {
-              total_week += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
-            }
-
-          update_usage_real_time |= (idx == 0);
-        }
-    }
+  IStatistics::StatsAggregate week = statistics->get_aggregate(IStatistics::StatsRange::Week, y, m + 1, d, Locale::get_week_start());
+  int64_t total_week = week.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  update_usage_real_time |= week.includes_today;
 
   weekly_usage_time_label->set_text(total_week > 0 ? Text::time_to_string(total_week) : "");
 }
@@ -453,44 +422,9 @@ StatisticsDialog::display_month_statistics()
   guint y, m, d;
   calendar->get_date(y, m, d);
 
-  guint max_mday;
-  if (m == 3 || m == 5 || m == 8 || m == 10)
-    {
-      max_mday = 30;
-    }
-  else if (m == 1)
-    {
-      bool is_leap = (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
-      if (is_leap)
-        {
-          max_mday = 29;
-        }
-      else
-        {
-          max_mday = 28;
-        }
-    }
-  else
-    {
-      max_mday = 31;
-    }
-
-  int64_t total_month = 0;
-  for (guint i = 1; i <= max_mday; i++)
-    {
-      int idx, next, prev;
-      statistics->get_day_index_by_date(y, m + 1, i, idx, next, prev);
-      if (idx >= 0)
-        {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
-            {
-              total_month += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
-            }
-
-          update_usage_real_time |= (idx == 0);
-        }
-    }
+  IStatistics::StatsAggregate month = statistics->get_aggregate(IStatistics::StatsRange::Month, y, m + 1, d, Locale::get_week_start());
+  int64_t total_month = month.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  update_usage_real_time |= month.includes_today;
 
   monthly_usage_time_label->set_text(total_month > 0 ? Text::time_to_string(total_month) : "");
 }
@@ -523,13 +457,19 @@ StatisticsDialog::clear_display_statistics()
 void
 StatisticsDialog::on_calendar_month_changed()
 {
-  display_calendar_date();
+  if (history_loaded)
+    {
+      display_calendar_date();
+    }
 }
 
 void
 StatisticsDialog::on_calendar_day_selected()
 {
-  display_calendar_date();
+  if (history_loaded)
+    {
+      display_calendar_date();
+    }
 }
 
 void
@@ -543,7 +483,11 @@ StatisticsDialog::get_calendar_day_index(int &idx, int &next, int &prev)
 void
 StatisticsDialog::set_calendar_day_index(int idx)
 {
-  IStatistics::DailyStats *stats = statistics->get_day(idx);
+  std::optional<IStatistics::DailyStats> stats = statistics->get_day(idx);
+  if (!stats)
+    {
+      return;
+    }
   calendar->select_month(stats->start.tm_mon, stats->start.tm_year + 1900);
   calendar->select_day(stats->start.tm_mday);
   display_calendar_date();
@@ -554,11 +498,10 @@ StatisticsDialog::display_calendar_date()
 {
   int idx, next, prev;
   get_calendar_day_index(idx, next, prev);
-  IStatistics::DailyStats *stats = nullptr;
   if (idx >= 0)
     {
-      stats = statistics->get_day(idx);
-      display_statistics(stats);
+      std::optional<IStatistics::DailyStats> stats = statistics->get_day(idx);
+      display_statistics(stats ? &*stats : nullptr);
     }
   else
     {
@@ -651,11 +594,52 @@ StatisticsDialog::on_history_delete_all()
   app->get_core()->remove_operation_mode_override(funcname);
 }
 
+//! Shows today while the history is loaded in the background.
+void
+StatisticsDialog::load_history()
+{
+  set_history_sensitive(false);
+  display_statistics(statistics->get_current_day());
+  weekly_usage_time_label->set_text(_("Loading..."));
+  monthly_usage_time_label->set_text(_("Loading..."));
+
+  std::weak_ptr<bool> dialog = alive;
+  statistics->when_history_loaded([this, dialog]() {
+    // Called by the history loader thread.
+    Glib::MainContext::get_default()->invoke([this, dialog]() {
+      if (!dialog.expired())
+        {
+          on_history_loaded();
+        }
+      return false;
+    });
+  });
+}
+
+void
+StatisticsDialog::set_history_sensitive(bool sensitive)
+{
+  calendar->set_sensitive(sensitive);
+  first_btn->set_sensitive(sensitive);
+  last_btn->set_sensitive(sensitive);
+  back_btn->set_sensitive(sensitive);
+  forward_btn->set_sensitive(sensitive);
+  delete_btn->set_sensitive(sensitive);
+}
+
+void
+StatisticsDialog::on_history_loaded()
+{
+  history_loaded = true;
+  set_history_sensitive(true);
+  display_calendar_date();
+}
+
 //! Periodic heartbeat.
 bool
 StatisticsDialog::on_timer()
 {
-  if (update_usage_real_time)
+  if (update_usage_real_time && history_loaded)
     {
       statistics->update();
       display_calendar_date();
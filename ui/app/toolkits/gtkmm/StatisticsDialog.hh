@@ -18,7 +18,10 @@
 #ifndef STATISTICSDIALOG_HH
 #define STATISTICSDIALOG_HH
 
+#include <memory>
+#include <optional>
 #include <sstream>
+#include <vector>
 
 #include "core/IStatistics.hh"
 #include "Hig.hh"
@@ -90,6 +93,12 @@ private:
 
   bool update_usage_real_time{false};
 
+  /** History is loaded and can be browsed. */
+  bool history_loaded{false};
+
+  /** Expires with the dialog, so that a late history callback is ignored. */
+  std::shared_ptr<bool> alive{std::make_shared<bool>(true)};
+
   void on_history_delete_all();
 
   void init_gui();
@@ -108,11 +117,14 @@ private:
   void on_history_goto_last();
   void on_history_goto_first();
   void display_calendar_date();
-  void display_statistics(workrave::IStatistics::DailyStats *stats);
+  void display_statistics(const workrave::IStatistics::DailyStats *stats);
   void clear_display_statistics();
   void display_week_statistics();
   void display_month_statistics();
   bool on_timer();
+  void load_history();
+  void set_history_sensitive(bool sensitive);
+  void on_history_loaded();
 };
 
 #endif // STATISTICSWINDOW_HH
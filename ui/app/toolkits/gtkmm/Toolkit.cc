@@ -76,7 +76,7 @@ Toolkit::init(std::shared_ptr<IApplication> app)
   event_connections.emplace_back(
     status_icon->signal_balloon_activated().connect(sigc::mem_fun(*this, &Toolkit::on_status_icon_balloon_activated)));
 
-  Glib::signal_timeout().connect(sigc::mem_fun(*this, &Toolkit::on_timer), 1000);
+  event_connections.emplace_back(wakeup_dispatcher.connect([this]() { schedule_timer(std::chrono::milliseconds(0)); }));
 
   init_multihead();
   init_gui();
@@ -383,6 +383,26 @@ Toolkit::create_oneshot_timer(int ms, std::function<void()> func)
     }
 }
 
+void
+Toolkit::schedule_timer(std::chrono::milliseconds delay)
+{
+  auto deadline = std::chrono::steady_clock::now() + delay;
+  if (timer_connection.connected() && timer_deadline <= deadline)
+    {
+      return;
+    }
+
+  timer_connection.disconnect();
+  timer_deadline = deadline;
+  timer_connection = Glib::signal_timeout().connect(sigc::mem_fun(*this, &Toolkit::on_timer), static_cast<unsigned int>(delay.count()));
+}
+
+void
+Toolkit::wakeup_timer()
+{
+  wakeup_dispatcher.emit();
+}
+
 void
 Toolkit::show_notification(const std::string &id, const std::string &title, const std::string &balloon, std::function<void()> func)
 {
@@ -493,9 +513,11 @@ Toolkit::init_debug()
 bool
 Toolkit::on_timer()
 {
+  // One-shot; the handlers of timer_signal schedule the next one.
+  timer_connection.disconnect();
   timer_signal();
   main_window->update();
-  return true;
+  return false;
 }
 
 void
@@ -18,9 +18,11 @@
 #ifndef TOOLKIT_HH
 #define TOOLKIT_HH
 
+#include <chrono>
 #include <memory>
 #include <map>
 #include <boost/signals2.hpp>
+#include <glibmm/dispatcher.h>
 
 #include "DebugDialog.hh"
 #include "ExercisesDialog.hh"
@@ -69,6 +71,8 @@ public:
   void create_oneshot_timer(int ms, std::function<void()> func) override;
   void show_notification(const std::string &id, const std::string &title, const std::string &balloon, std::function<void()> func) override;
   void show_tooltip(const std::string &tip) override;
+  void schedule_timer(std::chrono::milliseconds delay) override;
+  void wakeup_timer() override;
 
   boost::signals2::signal<void()> &signal_timer() override;
   boost::signals2::signal<void()> &signal_main_window_closed() override;
@@ -122,6 +126,9 @@ private:
   std::map<std::string, std::function<void()>> notifiers;
 
   std::list<sigc::connection> event_connections;
+  sigc::connection timer_connection;
+  std::chrono::steady_clock::time_point timer_deadline;
+  Glib::Dispatcher wakeup_dispatcher;
   workrave::utils::Trackable tracker;
 
   boost::signals2::signal<void()> timer_signal;
@@ -50,7 +50,7 @@ StatisticsDialog::StatisticsDialog(std::shared_ptr<IApplication> app)
     }
 
   init_gui();
-  display_calendar_date();
+  load_history();
 }
 
 auto
@@ -257,7 +257,7 @@ StatisticsDialog::create_break_page(QBoxLayout *parent)
 }
 
 void
-StatisticsDialog::display_statistics(IStatistics::DailyStats *stats)
+StatisticsDialog::display_statistics(const IStatistics::DailyStats *stats)
 {
   IStatistics::DailyStats empty{};
   bool is_empty{};
@@ -326,49 +326,13 @@ void
 StatisticsDialog::display_week_statistics()
 {
   QDate date = calendar->selectedDate();
-  int y = date.year();
-  int m = date.month() - 1;
-  int d = date.day();
-
-  std::tm timeinfo{};
-  std::memset(&timeinfo, 0, sizeof(timeinfo));
-  timeinfo.tm_mday = d;
-  timeinfo.tm_mon = m;
-  timeinfo.tm_year = y - 1900;
-
-  std::time_t t = std::mktime(&timeinfo);
-  std::tm const *time_loc = std::localtime(&t);
-
   QLocale locale;
   int week_start = locale.firstDayOfWeek() % 7;
 
-  int offset = (time_loc->tm_wday - week_start + 7) % 7;
-  int64_t total_week = 0;
-  for (int i = 0; i < 7; i++)
-    {
-      std::memset(&timeinfo, 0, sizeof(timeinfo));
-      timeinfo.tm_mday = d - offset + i;
-      timeinfo.tm_mon = m;
-      timeinfo.tm_year = y - 1900;
-      t = std::mktime(&timeinfo);
-      time_loc = std::localtime(&t);
-
-      int idx = 0;
-      int next = 0;
-      int prev = 0;
-      statistics->get_day_index_by_date(time_loc->tm_year + 1900, time_loc->tm_mon + 1, time_loc->tm_mday, idx, next, prev);
-
-      if (idx >= 0)
-        {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
-            {
-              total_week += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
-            }
-
-          update_usage_real_time |= (idx == 0);
-        }
-    }
+  IStatistics::StatsAggregate week =
+    statistics->get_aggregate(IStatistics::StatsRange::Week, date.year(), date.month(), date.day(), week_start);
+  int64_t total_week = week.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  update_usage_real_time |= week.includes_today;
 
   weekly_usage_time_label->setText(total_week > 0 ? UiUtil::time_to_string(total_week) : "");
 }
@@ -377,49 +341,13 @@ void
 StatisticsDialog::display_month_statistics()
 {
   QDate date = calendar->selectedDate();
-  int y = date.year();
-  int m = date.month() - 1;
-
-  int max_mday = 0;
-  if (m == 3 || m == 5 || m == 8 || m == 10)
-    {
-      max_mday = 30;
-    }
-  else if (m == 1)
-    {
-      bool is_leap = (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
-      if (is_leap)
-        {
-          max_mday = 29;
-        }
-      else
-        {
-          max_mday = 28;
-        }
-    }
-  else
-    {
-      max_mday = 31;
-    }
+  QLocale locale;
+  int week_start = locale.firstDayOfWeek() % 7;
 
-  int64_t total_month = 0;
-  for (int i = 1; i <= max_mday; i++)
-    {
-      int idx = 0;
-      int next = 0;
-      int prev = 0;
-      statistics->get_day_index_by_date(y, m + 1, i, idx, next, prev);
-      if (idx >= 0)
-        {
-          IStatistics::DailyStats *stats = statistics->get_day(idx);
-          if (stats != nullptr)
-            {
-              total_month += stats->misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
-            }
-
-          update_usage_real_time |= (idx == 0);
-        }
-    }
+  IStatistics::StatsAggregate month =
+    statistics->get_aggregate(IStatistics::StatsRange::Month, date.year(), date.month(), date.day(), week_start);
+  int64_t total_month = month.misc_stats[IStatistics::STATS_VALUE_TOTAL_ACTIVE_TIME];
+  update_usage_real_time |= month.includes_today;
 
   monthly_usage_time_label->setText(total_month > 0 ? UiUtil::time_to_string(total_month) : "");
 }
@@ -451,13 +379,19 @@ StatisticsDialog::clear_display_statistics()
 void
 StatisticsDialog::on_calendar_month_changed(int year, int month)
 {
-  display_calendar_date();
+  if (history_loaded)
+    {
+      display_calendar_date();
+    }
 }
 
 void
 StatisticsDialog::on_calendar_day_selected(const QDate &date)
 {
-  display_calendar_date();
+  if (history_loaded)
+    {
+      display_calendar_date();
+    }
 }
 
 void
@@ -470,7 +404,11 @@ StatisticsDialog::get_calendar_day_index(int &idx, int &next, int &prev)
 void
 StatisticsDialog::set_calendar_day_index(int idx)
 {
-  IStatistics::DailyStats *stats = statistics->get_day(idx);
+  std::optional<IStatistics::DailyStats> stats = statistics->get_day(idx);
+  if (!stats)
+    {
+      return;
+    }
   QDate date = calendar->selectedDate();
   date.setDate(stats->start.tm_year + 1900, stats->start.tm_mon + 1, stats->start.tm_mday);
   calendar->setSelectedDate(date);
@@ -484,11 +422,10 @@ StatisticsDialog::display_calendar_date()
   int next = 0;
   int prev = 0;
   get_calendar_day_index(idx, next, prev);
-  IStatistics::DailyStats *stats = nullptr;
   if (idx >= 0)
     {
-      stats = statistics->get_day(idx);
-      display_statistics(stats);
+      std::optional<IStatistics::DailyStats> stats = statistics->get_day(idx);
+      display_statistics(stats ? &*stats : nullptr);
     }
   else
     {
@@ -597,11 +534,54 @@ StatisticsDialog::on_history_delete_all()
   // app->get_core()->remove_operation_mode_override( funcname );
 }
 
+//! Shows today while the history is loaded in the background.
+void
+StatisticsDialog::load_history()
+{
+  set_history_enabled(false);
+  display_statistics(statistics->get_current_day());
+  weekly_usage_time_label->setText(tr("Loading..."));
+  monthly_usage_time_label->setText(tr("Loading..."));
+
+  std::weak_ptr<bool> dialog = alive;
+  statistics->when_history_loaded([this, dialog]() {
+    // Called by the history loader thread.
+    QMetaObject::invokeMethod(
+      qApp,
+      [this, dialog]() {
+        if (!dialog.expired())
+          {
+            on_history_loaded();
+          }
+      },
+      Qt::QueuedConnection);
+  });
+}
+
+void
+StatisticsDialog::set_history_enabled(bool enabled)
+{
+  calendar->setEnabled(enabled);
+  first_button->setEnabled(enabled);
+  last_button->setEnabled(enabled);
+  back_button->setEnabled(enabled);
+  forward_button->setEnabled(enabled);
+  delete_button->setEnabled(enabled);
+}
+
+void
+StatisticsDialog::on_history_loaded()
+{
+  history_loaded = true;
+  set_history_enabled(true);
+  display_calendar_date();
+}
+
 //! Periodic heartbeat.
 auto
 StatisticsDialog::on_timer() -> bool
 {
-  if (update_usage_real_time)
+  if (update_usage_real_time && history_loaded)
     {
       statistics->update();
       display_calendar_date();
@@ -21,8 +21,10 @@
 #include <QtGui>
 #include <QtWidgets>
 
+#include <optional>
 #include <sstream>
 #include <memory>
+#include <vector>
 
 #include "core/IStatistics.hh"
 #include "ui/IApplication.hh"
@@ -58,6 +60,9 @@ private:
   QPushButton *delete_button{nullptr};
 
   bool update_usage_real_time{false};
+  bool history_loaded{false};
+  //! Expires with the dialog, so that a late history callback is ignored.
+  std::shared_ptr<bool> alive{std::make_shared<bool>(true)};
 
   void on_history_delete_all();
 
@@ -80,11 +85,14 @@ private:
   void on_history_goto_last();
   void on_history_goto_first();
   void display_calendar_date();
-  void display_statistics(workrave::IStatistics::DailyStats *stats);
+  void display_statistics(const workrave::IStatistics::DailyStats *stats);
   void clear_display_statistics();
   void display_week_statistics();
   void display_month_statistics();
   auto on_timer() -> bool;
+  void load_history();
+  void set_history_enabled(bool enabled);
+  void on_history_loaded();
 };
 
 #endif // STATISTICSDIALOG_HH
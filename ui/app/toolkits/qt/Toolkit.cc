@@ -67,7 +67,7 @@ Toolkit::init(std::shared_ptr<IApplication> app)
   // &Toolkit::on_status_icon_balloon_activated)));
 
   connect(heartbeat_timer, SIGNAL(timeout()), this, SLOT(on_timer()));
-  heartbeat_timer->start(1000);
+  heartbeat_timer->setSingleShot(true);
 
   main_window->show();
   main_window->raise();
@@ -279,6 +279,22 @@ Toolkit::create_oneshot_timer(int ms, std::function<void()> func)
   new OneshotTimer(ms, func);
 }
 
+void
+Toolkit::schedule_timer(std::chrono::milliseconds delay)
+{
+  if (heartbeat_timer->isActive() && heartbeat_timer->remainingTime() <= delay.count())
+    {
+      return;
+    }
+  heartbeat_timer->start(static_cast<int>(delay.count()));
+}
+
+void
+Toolkit::wakeup_timer()
+{
+  QMetaObject::invokeMethod(this, [this]() { schedule_timer(std::chrono::milliseconds(0)); }, Qt::QueuedConnection);
+}
+
 void
 Toolkit::show_notification(const std::string &id, const std::string &title, const std::string &balloon, std::function<void()> func)
 {
@@ -18,6 +18,7 @@
 #ifndef TOOLKIT_HH
 #define TOOLKIT_HH
 
+#include <chrono>
 #include <memory>
 #include <map>
 #include <boost/signals2.hpp>
@@ -71,6 +72,8 @@ public:
   void create_oneshot_timer(int ms, std::function<void()> func) override;
   void show_notification(const std::string &id, const std::string &title, const std::string &balloon, std::function<void()> func) override;
   void show_tooltip(const std::string &tip) override;
+  void schedule_timer(std::chrono::milliseconds delay) override;
+  void wakeup_timer() override;
 
   auto signal_timer() -> boost::signals2::signal<void()> & override;
   auto signal_main_window_closed() -> boost::signals2::signal<void()> & override;
@@ -28,10 +28,13 @@ const IndicatorIface = '<node>\
     <method name="GetTrayIconEnabled"> \
         <arg type="b" name="enabled" direction="out" /> \
     </method> \
-    <signal name="TimersUpdated"> \
-        <arg type="(siuuuuuu)" /> \
-        <arg type="(siuuuuuu)" /> \
-        <arg type="(siuuuuuu)" /> \
+    <method name="GetTimers"> \
+        <arg type="(siuuuuuu)" name="micro" direction="out" /> \
+        <arg type="(siuuuuuu)" name="rest" direction="out" /> \
+        <arg type="(siuuuuuu)" name="daily" direction="out" /> \
+    </method> \
+    <signal name="TimersChanged"> \
+        <arg type="a(u(siuuuuuu))" /> \
     </signal> \
     <signal name="MenuUpdated"> \
         <arg type="a(sssuyy)" /> \
@@ -189,6 +192,8 @@ MyApplet.prototype = {
         this._bus_name = 'org.workrave.CinnamonApplet';
         this._bus_id = 0;
         this._menu_entries = {};
+        this._timers = [null, null, null];
+        this._timers_shown = false;
 
         this._area = new St.DrawingArea();
         this._area.set_width(this._width=24);
@@ -200,7 +205,7 @@ MyApplet.prototype = {
         this.actor.connect('destroy', Lang.bind(this, this._onDestroy));
 
         this._ui_proxy = new IndicatorProxy(Gio.DBus.session, 'org.workrave.Workrave', '/org/workrave/Workrave/UI');
-        this._timers_updated_id = this._ui_proxy.connectSignal("TimersUpdated", Lang.bind(this, this._onTimersUpdated));
+        this._timers_changed_id = this._ui_proxy.connectSignal("TimersChanged", Lang.bind(this, this._onTimersChanged));
         this._menu_updated_id = this._ui_proxy.connectSignal("MenuUpdated", Lang.bind(this, this._onMenuUpdated));
         this._menu_item_updated_id = this._ui_proxy.connectSignal("MenuItemUpdated", Lang.bind(this, this._onMenuItemUpdated));
         this._trayicon_updated_id = this._ui_proxy.connectSignal("TrayIconUpdated", Lang.bind(this, this._onTrayIconUpdated));
@@ -237,7 +242,7 @@ MyApplet.prototype = {
     _destroy: function() {
         if (this._ui_proxy != null)
         {
-            this._ui_proxy.disconnectSignal(this._timers_updated_id);
+            this._ui_proxy.disconnectSignal(this._timers_changed_id);
             this._ui_proxy.disconnectSignal(this._menu_updated_id);
             this._ui_proxy.disconnectSignal(this._menu_item_updated_id);
             this._ui_proxy.disconnectSignal(this._trayicon_updated_id);
@@ -259,6 +264,7 @@ MyApplet.prototype = {
             this._ui_proxy.GetMenuRemote(Lang.bind(this, this._onGetMenuReply));
             this._ui_proxy.GetTrayIconEnabledRemote(Lang.bind(this, this._onGetTrayIconEnabledReply));
             this._ui_proxy.EmbedRemote(true, this._bus_name);
+            this._ui_proxy.GetTimersRemote(Lang.bind(this, this._onGetTimersReply));
             this._core_proxy.GetOperationModeRemote(Lang.bind(this, this._onGetOperationModeReply));
             this._timeoutId = Mainloop.timeout_add(5000, Lang.bind(this, this._onTimer));
             this._alive = true;
@@ -285,6 +291,7 @@ MyApplet.prototype = {
             this._timerbox.set_enabled(false);
             this._timerbox.set_force_icon(false);
             this._alive = false;
+            this._timers_shown = false;
             this._updateMenu(null);
             this._area.queue_repaint();
             this._area.set_width(this._width=24);
@@ -314,6 +321,7 @@ MyApplet.prototype = {
         {
             this._timerbox.set_enabled(false);
             this._timerbox.set_force_icon(false);
+            this._timers_shown = false;
             this._area.queue_repaint();
         }
         this._update_count = 0;
@@ -329,7 +337,7 @@ MyApplet.prototype = {
         this._stop();
     },
 
-    _onTimersUpdated : function(emitter, senderName, [microbreak, restbreak, daily]) {
+    _onTimersChanged : function(emitter, senderName, [changes]) {
         if (! this._alive)
         {
             this._start();
@@ -337,6 +345,32 @@ MyApplet.prototype = {
 
         this._update_count++;
 
+        // An empty delta only tells the applet that Workrave is still running.
+        for (let [id, timer] of changes)
+        {
+            this._timers[id] = timer;
+        }
+
+        if (changes.length > 0 || ! this._timers_shown)
+        {
+            this._updateTimers();
+        }
+    },
+
+    _onGetTimersReply : function([microbreak, restbreak, daily], excp) {
+        if (excp == null)
+        {
+            this._timers = [microbreak, restbreak, daily];
+        }
+    },
+
+    _updateTimers : function() {
+        let [microbreak, restbreak, daily] = this._timers;
+        if (microbreak == null || restbreak == null || daily == null)
+        {
+            return;
+        }
+
         this._timerbox.set_slot(0, microbreak[1]);
         this._timerbox.set_slot(1, restbreak[1]);
         this._timerbox.set_slot(2, daily[1]);
@@ -371,6 +405,7 @@ MyApplet.prototype = {
         let width = this._timerbox.get_width();
         this._area.set_width(this._width=width);
         this._area.queue_repaint();
+        this._timers_shown = true;
     },
 
     _onGetMenuReply : function([menuitems], excp) {
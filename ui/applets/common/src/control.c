@@ -50,6 +50,19 @@ enum
 
 static guint signals[LAST_SIGNAL] = {0};
 
+typedef struct _TimerData TimerData;
+struct _TimerData
+{
+  char *bar_text;
+  int slot;
+  int bar_secondary_color;
+  int bar_secondary_val;
+  int bar_secondary_max;
+  int bar_primary_color;
+  int bar_primary_val;
+  int bar_primary_max;
+};
+
 struct _WorkraveTimerboxControlPrivate
 {
   GtkImage *image;
@@ -77,21 +90,11 @@ struct _WorkraveTimerboxControlPrivate
   guint startup_timer;
   guint startup_count;
   guint update_count;
+  gboolean timers_shown;
 
-  WorkraveTimerbox *timerbox;
-};
+  TimerData timers[BREAK_ID_SIZEOF];
 
-typedef struct _TimerData TimerData;
-struct _TimerData
-{
-  char *bar_text;
-  int slot;
-  int bar_secondary_color;
-  int bar_secondary_val;
-  int bar_secondary_max;
-  int bar_primary_color;
-  int bar_primary_val;
-  int bar_primary_max;
+  WorkraveTimerbox *timerbox;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE(WorkraveTimerboxControl, workrave_timerbox_control, G_TYPE_OBJECT);
@@ -109,7 +112,9 @@ static void on_dbus_applet_ready(GObject *object, GAsyncResult *res, gpointer us
 static void on_dbus_core_ready(GObject *object, GAsyncResult *res, gpointer user_data);
 static void on_dbus_control_ready(GObject *object, GAsyncResult *res, gpointer user_data);
 static void on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVariant *parameters, gpointer user_data);
-static void on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters);
+static void on_timers_changed(WorkraveTimerboxControl *self, GVariant *parameters);
+static void workrave_timerbox_control_set_timer(WorkraveTimerboxControl *self, guint32 id, GVariant *timer);
+static void workrave_timerbox_control_update_timers(WorkraveTimerboxControl *self);
 static void on_bus_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data);
 static void on_workrave_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
 static void on_workrave_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data);
@@ -290,6 +295,12 @@ workrave_timerbox_control_init(WorkraveTimerboxControl *self)
   priv->startup_count = 0;
   priv->timerbox = NULL;
   priv->update_count = 0;
+  priv->timers_shown = FALSE;
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      priv->timers[i] = (TimerData){0};
+    }
 
   priv->timerbox = g_object_new(WORKRAVE_TYPE_TIMERBOX, NULL);
 
@@ -348,7 +359,14 @@ workrave_timerbox_control_dispose(GObject *object)
 static void
 workrave_timerbox_control_finalize(GObject *object)
 {
-  // WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(object);
+  WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(object);
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      g_clear_pointer(&priv->timers[i].bar_text, g_free);
+    }
+
   G_OBJECT_CLASS(workrave_timerbox_control_parent_class)->finalize(object);
   return;
 }
@@ -427,6 +445,26 @@ workrave_timerbox_control_start(WorkraveTimerboxControl *self)
         }
     }
 
+  if (error == NULL)
+    {
+      GVariant *result = g_dbus_proxy_call_sync(priv->applet_proxy, "GetTimers", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+
+      if (error != NULL)
+        {
+          g_warning("Could not request timers for %s: %s", WORKRAVE_DBUS_APPLET_NAME, error->message);
+        }
+      else
+        {
+          for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+            {
+              GVariant *timer = g_variant_get_child_value(result, i);
+              workrave_timerbox_control_set_timer(self, i, timer);
+              g_variant_unref(timer);
+            }
+          g_variant_unref(result);
+        }
+    }
+
   if (error == NULL)
     {
       priv->timer = g_timeout_add_seconds(10, on_timer, self);
@@ -465,6 +503,7 @@ workrave_timerbox_control_stop(WorkraveTimerboxControl *self)
         }
 
       priv->alive = FALSE;
+      priv->timers_shown = FALSE;
 
       workrave_timerbox_control_update_show_tray_icon(self);
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
@@ -553,6 +592,7 @@ on_timer(gpointer user_data)
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
       workrave_timerbox_set_force_icon(priv->timerbox, priv->tray_icon_visible_when_not_running);
       workrave_timerbox_update(priv->timerbox, priv->image);
+      priv->timers_shown = FALSE;
     }
   priv->update_count = 0;
 
@@ -652,9 +692,9 @@ on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVaria
   WorkraveTimerboxControl *self = WORKRAVE_TIMERBOX_CONTROL(user_data);
   WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
 
-  if (g_strcmp0(signal_name, "TimersUpdated") == 0)
+  if (g_strcmp0(signal_name, "TimersChanged") == 0)
     {
-      on_update_timers(self, parameters);
+      on_timers_changed(self, parameters);
     }
 
   else if (g_strcmp0(signal_name, "MenuUpdated") == 0)
@@ -685,7 +725,7 @@ on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVaria
 }
 
 static void
-on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters)
+on_timers_changed(WorkraveTimerboxControl *self, GVariant *parameters)
 {
   WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
 
@@ -696,34 +736,56 @@ on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters)
 
   priv->update_count++;
 
-  TimerData td[BREAK_ID_SIZEOF];
-
-  g_variant_get(parameters,
-                "((siuuuuuu)(siuuuuuu)(siuuuuuu))",
-                &td[BREAK_ID_MICRO_BREAK].bar_text,
-                &td[BREAK_ID_MICRO_BREAK].slot,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_color,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_val,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_max,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_color,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_val,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_max,
-                &td[BREAK_ID_REST_BREAK].bar_text,
-                &td[BREAK_ID_REST_BREAK].slot,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_color,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_val,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_max,
-                &td[BREAK_ID_REST_BREAK].bar_primary_color,
-                &td[BREAK_ID_REST_BREAK].bar_primary_val,
-                &td[BREAK_ID_REST_BREAK].bar_primary_max,
-                &td[BREAK_ID_DAILY_LIMIT].bar_text,
-                &td[BREAK_ID_DAILY_LIMIT].slot,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_color,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_val,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_max,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_color,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_val,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_max);
+  // An empty delta only tells the applet that Workrave is still running.
+  gboolean changed = FALSE;
+  GVariantIter *iter = NULL;
+  guint32 id;
+  GVariant *timer;
+
+  g_variant_get(parameters, "(a(u@(siuuuuuu)))", &iter);
+  while (g_variant_iter_loop(iter, "(u@(siuuuuuu))", &id, &timer))
+    {
+      workrave_timerbox_control_set_timer(self, id, timer);
+      changed = TRUE;
+    }
+  g_variant_iter_free(iter);
+
+  if (changed || !priv->timers_shown)
+    {
+      workrave_timerbox_control_update_timers(self);
+    }
+}
+
+static void
+workrave_timerbox_control_set_timer(WorkraveTimerboxControl *self, guint32 id, GVariant *timer)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+
+  if (id >= BREAK_ID_SIZEOF)
+    {
+      return;
+    }
+
+  TimerData *td = &priv->timers[id];
+  g_free(td->bar_text);
+
+  g_variant_get(timer,
+                "(siuuuuuu)",
+                &td->bar_text,
+                &td->slot,
+                &td->bar_secondary_color,
+                &td->bar_secondary_val,
+                &td->bar_secondary_max,
+                &td->bar_primary_color,
+                &td->bar_primary_val,
+                &td->bar_primary_max);
+}
+
+static void
+workrave_timerbox_control_update_timers(WorkraveTimerboxControl *self)
+{
+  WorkraveTimerboxControlPrivate *priv = workrave_timerbox_control_get_instance_private(self);
+  TimerData *td = priv->timers;
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
@@ -744,11 +806,7 @@ on_update_timers(WorkraveTimerboxControl *self, GVariant *parameters)
     }
 
   workrave_timerbox_update(priv->timerbox, priv->image);
-
-  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
-    {
-      g_free(td[i].bar_text);
-    }
+  priv->timers_shown = TRUE;
 }
 
 static void
@@ -32,10 +32,13 @@ const IndicatorIface =
     <method name="GetTrayIconEnabled"> \
         <arg type="b" name="enabled" direction="out" /> \
     </method> \
-    <signal name="TimersUpdated"> \
-        <arg type="(siuuuuuu)" /> \
-        <arg type="(siuuuuuu)" /> \
-        <arg type="(siuuuuuu)" /> \
+    <method name="GetTimers"> \
+        <arg type="(siuuuuuu)" name="micro" direction="out" /> \
+        <arg type="(siuuuuuu)" name="rest" direction="out" /> \
+        <arg type="(siuuuuuu)" name="daily" direction="out" /> \
+    </method> \
+    <signal name="TimersChanged"> \
+        <arg type="a(u(siuuuuuu))" /> \
     </signal> \
     <signal name="MenuUpdated"> \
         <arg type="a(sssuyy)" /> \
@@ -186,6 +189,8 @@ const WorkraveButton = GObject.registerClass(
       this._bus_id = 0;
       this._menu_entries = {};
       this._watchid = 0;
+      this._timers = [null, null, null];
+      this._timers_shown = false;
 
       this._area = new St.DrawingArea({
         style_class: "workrave-area",
@@ -215,9 +220,9 @@ const WorkraveButton = GObject.registerClass(
         "/org/workrave/Workrave/UI",
         Lang.bind(this, this._connectUI)
       );
-      this._timers_updated_id = this._ui_proxy.connectSignal(
-        "TimersUpdated",
-        Lang.bind(this, this._onTimersUpdated)
+      this._timers_changed_id = this._ui_proxy.connectSignal(
+        "TimersChanged",
+        Lang.bind(this, this._onTimersChanged)
       );
       this._menu_updated_id = this._ui_proxy.connectSignal(
         "MenuUpdated",
@@ -280,7 +285,7 @@ const WorkraveButton = GObject.registerClass(
         this._watchid = 0;
       }
       if (this._ui_proxy != null) {
-        this._ui_proxy.disconnectSignal(this._timers_updated_id);
+        this._ui_proxy.disconnectSignal(this._timers_changed_id);
         this._ui_proxy.disconnectSignal(this._menu_updated_id);
         this._ui_proxy.disconnectSignal(this._menu_item_updated_id);
         this._ui_proxy.disconnectSignal(this._trayicon_updated_id);
@@ -305,6 +310,9 @@ const WorkraveButton = GObject.registerClass(
           Lang.bind(this, this._onGetTrayIconEnabledReply)
         );
         this._ui_proxy.EmbedRemote(true, this._bus_name);
+        this._ui_proxy.GetTimersRemote(
+          Lang.bind(this, this._onGetTimersReply)
+        );
         this._core_proxy.GetOperationModeRemote(
           Lang.bind(this, this._onGetOperationModeReply)
         );
@@ -332,6 +340,7 @@ const WorkraveButton = GObject.registerClass(
         this._timerbox.set_enabled(false);
         this._timerbox.set_force_icon(false);
         this._alive = false;
+        this._timers_shown = false;
         this._updateMenu(null);
         this._area.queue_repaint();
         this._area.set_width((this._width = 24));
@@ -350,6 +359,7 @@ const WorkraveButton = GObject.registerClass(
 
       if (this._update_count == 0) {
         this._timerbox.set_enabled(false);
+        this._timers_shown = false;
         this._area.queue_repaint();
       }
       this._update_count = 0;
@@ -365,13 +375,35 @@ const WorkraveButton = GObject.registerClass(
       this._stop();
     }
 
-    _onTimersUpdated(emitter, senderName, [microbreak, restbreak, daily]) {
+    _onTimersChanged(emitter, senderName, [changes]) {
       if (!this._alive) {
         this._start();
       }
 
       this._update_count++;
 
+      // An empty delta only tells the applet that Workrave is still running.
+      for (let [id, timer] of changes) {
+        this._timers[id] = timer;
+      }
+
+      if (changes.length > 0 || !this._timers_shown) {
+        this._updateTimers();
+      }
+    }
+
+    _onGetTimersReply([microbreak, restbreak, daily], excp) {
+      if (excp == null) {
+        this._timers = [microbreak, restbreak, daily];
+      }
+    }
+
+    _updateTimers() {
+      let [microbreak, restbreak, daily] = this._timers;
+      if (microbreak == null || restbreak == null || daily == null) {
+        return;
+      }
+
       this._timerbox.set_slot(0, microbreak[1]);
       this._timerbox.set_slot(1, restbreak[1]);
       this._timerbox.set_slot(2, daily[1]);
@@ -413,6 +445,7 @@ const WorkraveButton = GObject.registerClass(
 
       this._area.set_width((this._width = timerbox_width));
       this._area.queue_repaint();
+      this._timers_shown = true;
     }
 
     _onGetMenuReply([menuitems], excp) {
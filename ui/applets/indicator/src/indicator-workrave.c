@@ -78,6 +78,19 @@ struct _IndicatorWorkrave
   IndicatorObject parent;
 };
 
+typedef struct _TimerData TimerData;
+struct _TimerData
+{
+  char *bar_text;
+  int slot;
+  int bar_secondary_color;
+  int bar_secondary_val;
+  int bar_secondary_max;
+  int bar_primary_color;
+  int bar_primary_val;
+  int bar_primary_max;
+};
+
 struct _IndicatorWorkravePrivate
 {
   GtkLabel *label;
@@ -101,21 +114,11 @@ struct _IndicatorWorkravePrivate
   guint startup_timer;
   guint startup_count;
   guint update_count;
+  gboolean timers_shown;
 
-  WorkraveTimerbox *timerbox;
-};
+  TimerData timers[BREAK_ID_SIZEOF];
 
-typedef struct _TimerData TimerData;
-struct _TimerData
-{
-  char *bar_text;
-  int slot;
-  int bar_secondary_color;
-  int bar_secondary_val;
-  int bar_secondary_max;
-  int bar_primary_color;
-  int bar_primary_val;
-  int bar_primary_max;
+  WorkraveTimerbox *timerbox;
 };
 
 typedef struct _MenuItemData MenuItemData;
@@ -143,7 +146,9 @@ static gboolean on_timer(gpointer user_data);
 static void on_dbus_ui_ready(GObject *object, GAsyncResult *res, gpointer user_data);
 static void on_dbus_core_ready(GObject *object, GAsyncResult *res, gpointer user_data);
 static void on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVariant *parameters, gpointer user_data);
-static void on_update_indicator(IndicatorWorkrave *self, GVariant *parameters);
+static void on_timers_changed(IndicatorWorkrave *self, GVariant *parameters);
+static void indicator_workrave_set_timer(IndicatorWorkrave *self, guint32 id, GVariant *timer);
+static void indicator_workrave_update_timers(IndicatorWorkrave *self);
 static void on_bus_acquired(GDBusConnection *connection, const gchar *name, gpointer user_data);
 static void on_workrave_appeared(GDBusConnection *connection, const gchar *name, const gchar *name_owner, gpointer user_data);
 static void on_workrave_vanished(GDBusConnection *connection, const gchar *name, gpointer user_data);
@@ -191,6 +196,12 @@ indicator_workrave_init(IndicatorWorkrave *self)
   priv->startup_count = 0;
   priv->timerbox = NULL;
   priv->update_count = 0;
+  priv->timers_shown = FALSE;
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      priv->timers[i] = (TimerData){0};
+    }
 
   priv->menu = dbusmenu_gtkmenu_new(WORKRAVE_INDICATOR_MENU_NAME, WORKRAVE_INDICATOR_MENU_OBJ);
   priv->timerbox = g_object_new(WORKRAVE_TYPE_TIMERBOX, NULL);
@@ -253,7 +264,14 @@ indicator_workrave_dispose(GObject *object)
 static void
 indicator_workrave_finalize(GObject *object)
 {
-  // IndicatorWorkrave *self = INDICATOR_WORKRAVE(object);
+  IndicatorWorkrave *self = INDICATOR_WORKRAVE(object);
+  IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
+
+  for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+    {
+      g_clear_pointer(&priv->timers[i].bar_text, g_free);
+    }
+
   G_OBJECT_CLASS(indicator_workrave_parent_class)->finalize(object);
   return;
 }
@@ -373,6 +391,26 @@ indicator_workrave_start(IndicatorWorkrave *self)
         }
     }
 
+  if (error == NULL)
+    {
+      GVariant *result = g_dbus_proxy_call_sync(priv->workrave_ui_proxy, "GetTimers", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+
+      if (error != NULL)
+        {
+          g_warning("Could not request timers for %s: %s", WORKRAVE_INDICATOR_SERVICE_NAME, error->message);
+        }
+      else
+        {
+          for (int i = 0; i < BREAK_ID_SIZEOF; i++)
+            {
+              GVariant *timer = g_variant_get_child_value(result, i);
+              indicator_workrave_set_timer(self, i, timer);
+              g_variant_unref(timer);
+            }
+          g_variant_unref(result);
+        }
+    }
+
   if (error == NULL)
     {
       priv->timer = g_timeout_add_seconds(10, on_timer, self);
@@ -413,6 +451,7 @@ indicator_workrave_stop(IndicatorWorkrave *self)
       workrave_timerbox_set_force_icon(priv->timerbox, FALSE);
       workrave_timerbox_update(priv->timerbox, priv->image);
       priv->alive = FALSE;
+      priv->timers_shown = FALSE;
     }
 }
 
@@ -485,6 +524,7 @@ on_timer(gpointer user_data)
       workrave_timerbox_set_enabled(priv->timerbox, FALSE);
       workrave_timerbox_set_force_icon(priv->timerbox, FALSE);
       workrave_timerbox_update(priv->timerbox, priv->image);
+      priv->timers_shown = FALSE;
     }
   priv->update_count = 0;
 
@@ -555,9 +595,9 @@ on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVaria
   IndicatorWorkrave *self = INDICATOR_WORKRAVE(user_data);
   IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
 
-  if (g_strcmp0(signal_name, "TimersUpdated") == 0)
+  if (g_strcmp0(signal_name, "TimersChanged") == 0)
     {
-      on_update_indicator(self, parameters);
+      on_timers_changed(self, parameters);
     }
 
   else if (g_strcmp0(signal_name, "TrayIconUpdated") == 0)
@@ -577,7 +617,7 @@ on_dbus_signal(GDBusProxy *proxy, gchar *sender_name, gchar *signal_name, GVaria
 }
 
 static void
-on_update_indicator(IndicatorWorkrave *self, GVariant *parameters)
+on_timers_changed(IndicatorWorkrave *self, GVariant *parameters)
 {
   IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
 
@@ -588,34 +628,56 @@ on_update_indicator(IndicatorWorkrave *self, GVariant *parameters)
 
   priv->update_count++;
 
-  TimerData td[BREAK_ID_SIZEOF];
-
-  g_variant_get(parameters,
-                "((siuuuuuu)(siuuuuuu)(siuuuuuu))",
-                &td[BREAK_ID_MICRO_BREAK].bar_text,
-                &td[BREAK_ID_MICRO_BREAK].slot,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_color,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_val,
-                &td[BREAK_ID_MICRO_BREAK].bar_secondary_max,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_color,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_val,
-                &td[BREAK_ID_MICRO_BREAK].bar_primary_max,
-                &td[BREAK_ID_REST_BREAK].bar_text,
-                &td[BREAK_ID_REST_BREAK].slot,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_color,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_val,
-                &td[BREAK_ID_REST_BREAK].bar_secondary_max,
-                &td[BREAK_ID_REST_BREAK].bar_primary_color,
-                &td[BREAK_ID_REST_BREAK].bar_primary_val,
-                &td[BREAK_ID_REST_BREAK].bar_primary_max,
-                &td[BREAK_ID_DAILY_LIMIT].bar_text,
-                &td[BREAK_ID_DAILY_LIMIT].slot,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_color,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_val,
-                &td[BREAK_ID_DAILY_LIMIT].bar_secondary_max,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_color,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_val,
-                &td[BREAK_ID_DAILY_LIMIT].bar_primary_max);
+  // An empty delta only tells the indicator that Workrave is still running.
+  gboolean changed = FALSE;
+  GVariantIter *iter = NULL;
+  guint32 id;
+  GVariant *timer;
+
+  g_variant_get(parameters, "(a(u@(siuuuuuu)))", &iter);
+  while (g_variant_iter_loop(iter, "(u@(siuuuuuu))", &id, &timer))
+    {
+      indicator_workrave_set_timer(self, id, timer);
+      changed = TRUE;
+    }
+  g_variant_iter_free(iter);
+
+  if (changed || !priv->timers_shown)
+    {
+      indicator_workrave_update_timers(self);
+    }
+}
+
+static void
+indicator_workrave_set_timer(IndicatorWorkrave *self, guint32 id, GVariant *timer)
+{
+  IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
+
+  if (id >= BREAK_ID_SIZEOF)
+    {
+      return;
+    }
+
+  TimerData *td = &priv->timers[id];
+  g_free(td->bar_text);
+
+  g_variant_get(timer,
+                "(siuuuuuu)",
+                &td->bar_text,
+                &td->slot,
+                &td->bar_secondary_color,
+                &td->bar_secondary_val,
+                &td->bar_secondary_max,
+                &td->bar_primary_color,
+                &td->bar_primary_val,
+                &td->bar_primary_max);
+}
+
+static void
+indicator_workrave_update_timers(IndicatorWorkrave *self)
+{
+  IndicatorWorkravePrivate *priv = indicator_workrave_get_instance_private(self);
+  TimerData *td = priv->timers;
 
   for (int i = 0; i < BREAK_ID_SIZEOF; i++)
     {
@@ -636,6 +698,7 @@ on_update_indicator(IndicatorWorkrave *self, GVariant *parameters)
     }
 
   workrave_timerbox_update(priv->timerbox, priv->image);
+  priv->timers_shown = TRUE;
 }
 
 static void